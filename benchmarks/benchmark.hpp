@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef LIBYANG_CPP_BENCHMARK_VERSION
+#define LIBYANG_CPP_BENCHMARK_VERSION "unknown"
+#endif
+#ifndef LIBYANG_CPP_BENCHMARK_LIBYANG_VERSION
+#define LIBYANG_CPP_BENCHMARK_LIBYANG_VERSION "unknown"
+#endif
+
+namespace bench {
+/**
+ * @brief Prevents the compiler from optimizing away a value which is computed only for the benchmark.
+ */
+template <typename T>
+void doNotOptimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Runs `fn` `iterations` times (after a short warm-up) and returns the average wall-clock time of one call.
+ */
+template <typename Fn>
+double nsPerOp(const std::size_t iterations, Fn&& fn)
+{
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+namespace impl {
+struct Result {
+    std::string name;
+    double nsPerOp;
+};
+
+inline bool jsonOutput = false;
+inline std::vector<Result> results;
+
+inline std::string jsonString(std::string_view str)
+{
+    std::string res = "\"";
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+        }
+        res += c;
+    }
+    return res + '"';
+}
+}
+
+/**
+ * @brief Collects the results of one benchmark executable.
+ *
+ * The results are printed as a table as they come in. With `--json` on the command line, a single JSON document is
+ * printed at the end instead, so that results of different builds can be stored and compared.
+ */
+class Session {
+public:
+    Session(const std::string& name, int argc, char* argv[])
+        : m_name(name)
+    {
+        for (int i = 1; i < argc; ++i) {
+            if (std::string_view{argv[i]} == "--json") {
+                impl::jsonOutput = true;
+            }
+        }
+    }
+
+    ~Session()
+    {
+        if (!impl::jsonOutput) {
+            return;
+        }
+
+        std::cout << "{\n"
+                  << "  \"suite\": " << impl::jsonString(m_name) << ",\n"
+                  << "  \"libyang-cpp\": " << impl::jsonString(LIBYANG_CPP_BENCHMARK_VERSION) << ",\n"
+                  << "  \"libyang\": " << impl::jsonString(LIBYANG_CPP_BENCHMARK_LIBYANG_VERSION) << ",\n"
+                  << "  \"unit\": \"ns/op\",\n"
+                  << "  \"results\": [";
+        for (std::size_t i = 0; i < impl::results.size(); ++i) {
+            std::cout << (i ? "," : "") << "\n    {\"name\": " << impl::jsonString(impl::results[i].name)
+                      << ", \"ns_per_op\": " << std::fixed << std::setprecision(1) << impl::results[i].nsPerOp << "}";
+        }
+        std::cout << "\n  ]\n}\n";
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+private:
+    std::string m_name;
+};
+
+inline void report(const std::string& name, const double nsPerOp)
+{
+    if (impl::jsonOutput) {
+        impl::results.push_back({name, nsPerOp});
+        return;
+    }
+    std::cout << std::left << std::setw(60) << name << std::right << std::setw(12) << std::fixed << std::setprecision(1) << nsPerOp << " ns/op\n";
+}
+}
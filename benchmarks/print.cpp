@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <filesystem>
+#include <libyang-cpp/Context.hpp>
+#include <sstream>
+#include "benchmark.hpp"
+#include "example_schema.hpp"
+
+int main(int argc, char* argv[])
+{
+    bench::Session session{"print", argc, argv};
+
+    constexpr std::size_t iterations = 100;
+
+    libyang::Context ctx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+    ctx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+
+    std::string json = R"({"example-schema:person": [)";
+    for (int i = 0; i < 10'000; ++i) {
+        json += (i ? "," : "") + R"({"name": "person)"s + std::to_string(i) + R"("})";
+    }
+    json += "]}";
+    auto tree = ctx.parseData(json, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+    const auto flags = libyang::PrintFlags::WithSiblings;
+
+    bench::report("printStr(), 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(tree->printStr(libyang::DataFormat::JSON, flags));
+    }));
+
+    bench::report("printStr() as XML, 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(tree->printStr(libyang::DataFormat::XML, flags));
+    }));
+
+    bench::report("parseData(), 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(ctx.parseData(json, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly));
+    }));
+
+    const auto xml = *tree->printStr(libyang::DataFormat::XML, flags);
+    bench::report("parseData() from XML, 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(ctx.parseData(xml, libyang::DataFormat::XML, libyang::ParseOptions::ParseOnly));
+    }));
+
+    bench::report("print(std::ostream&), 10k list entries", bench::nsPerOp(iterations, [&] {
+        std::ostringstream oss;
+        tree->print(oss, libyang::DataFormat::JSON, flags);
+        bench::doNotOptimize(oss);
+    }));
+
+    bench::report("print(callback), byte counting only, 10k list entries", bench::nsPerOp(iterations, [&] {
+        std::size_t bytes = 0;
+        tree->print([&bytes](std::string_view chunk) { bytes += chunk.size(); }, libyang::DataFormat::JSON, flags);
+        bench::doNotOptimize(bytes);
+    }));
+
+    const auto lyb = *tree->printStr(libyang::DataFormat::LYB, flags);
+    bench::report("printStr() as LYB, 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(tree->printStr(libyang::DataFormat::LYB, flags));
+    }));
+
+    bench::report("parseData() from LYB, 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(ctx.parseData(lyb, libyang::DataFormat::LYB, libyang::ParseOptions::ParseOnly));
+    }));
+
+    const auto file = std::filesystem::temp_directory_path() / "libyang-cpp-bench-print.lyb";
+    bench::report("print(path) as LYB, default buffering, 10k list entries", bench::nsPerOp(iterations, [&] {
+        tree->print(file, libyang::DataFormat::LYB, flags, libyang::DataFileOptions{});
+    }));
+
+    bench::report("parseData(path) from LYB, 10k list entries", bench::nsPerOp(iterations, [&] {
+        bench::doNotOptimize(ctx.parseData(file, libyang::DataFormat::LYB, libyang::DataFileOptions{}, libyang::ParseOptions::ParseOnly));
+    }));
+
+    for (const auto compression : {libyang::Compression::Gzip, libyang::Compression::Zstd}) {
+        const auto name = compression == libyang::Compression::Gzip ? "gzip"s : "zstd"s;
+        try {
+            bench::report("print(path) as LYB, " + name + ", 10k list entries", bench::nsPerOp(iterations, [&] {
+                tree->print(file, libyang::DataFormat::LYB, flags, libyang::DataFileOptions{.compression = compression});
+            }));
+        } catch (const libyang::Error&) {
+            // not compiled in
+            continue;
+        }
+        bench::report("parseData(path) from LYB, " + name + ", 10k list entries", bench::nsPerOp(iterations, [&] {
+            bench::doNotOptimize(ctx.parseData(file, libyang::DataFormat::LYB, libyang::DataFileOptions{}, libyang::ParseOptions::ParseOnly));
+        }));
+    }
+    std::filesystem::remove(file);
+}
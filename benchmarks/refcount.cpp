@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <set>
+#include <vector>
+#include "benchmark.hpp"
+#include "example_schema.hpp"
+
+namespace {
+/** @short Builds a JSON document with `count` instances of the example-schema:person list. */
+std::string personList(const std::size_t count)
+{
+    std::string res = R"({"example-schema:person": [)";
+    for (std::size_t i = 0; i < count; ++i) {
+        res += (i ? "," : "") + R"({"name": "person)"s + std::to_string(i) + R"("})";
+    }
+    res += "]}";
+    return res;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    bench::Session session{"refcount", argc, argv};
+
+    constexpr std::size_t iterations = 1'000'000;
+
+    libyang::Context ctx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+    ctx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+
+    for (const std::size_t liveWrappers : {std::size_t{0}, std::size_t{1'000}, std::size_t{100'000}}) {
+        auto tree = ctx.parseData(personList(liveWrappers + 1), libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+
+        // Keep a wrapper for each list instance alive, these populate the registry of the tree.
+        std::vector<libyang::DataNode> live;
+        live.reserve(liveWrappers);
+        for (const auto& node : tree->siblings()) {
+            if (live.size() == liveWrappers) {
+                break;
+            }
+            live.emplace_back(node);
+        }
+
+        const auto suffix = " (" + std::to_string(liveWrappers) + " live wrappers)";
+
+        bench::report("DataNode copy + destroy" + suffix, bench::nsPerOp(iterations, [&tree] {
+            libyang::DataNode copy{*tree};
+            bench::doNotOptimize(copy);
+        }));
+
+        bench::report("DataNode move + destroy" + suffix, bench::nsPerOp(iterations, [&tree] {
+            libyang::DataNode copy{*tree};
+            libyang::DataNode moved{std::move(copy)};
+            bench::doNotOptimize(moved);
+        }));
+
+        bench::report("std::vector<DataNode> growth, per element" + suffix, bench::nsPerOp(iterations / 1'000, [&tree] {
+            std::vector<libyang::DataNode> nodes;
+            for (int i = 0; i < 1'000; ++i) {
+                nodes.push_back(*tree);
+            }
+            bench::doNotOptimize(nodes);
+        }) / 1'000);
+
+        // The registry used to be a std::set<DataNode*>, this is what every copy paid for its bookkeeping.
+        std::set<const void*> baseline;
+        for (const auto& node : live) {
+            baseline.emplace(&node);
+        }
+        bench::report("baseline: std::set<void*> insert + erase" + suffix, bench::nsPerOp(iterations, [&baseline] {
+            int dummy;
+            baseline.emplace(&dummy);
+            baseline.erase(&dummy);
+            bench::doNotOptimize(baseline);
+        }));
+    }
+
+    // A typical request: a few short-lived trees and sets which all die at the end
+    auto request = [&ctx] {
+        for (int i = 0; i < 100; ++i) {
+            auto node = ctx.newPath("/example-schema:person[name='a']");
+            auto found = node.findXPath("/example-schema:person");
+            bench::doNotOptimize(found);
+        }
+    };
+    bench::report("100 trees and sets, per request", bench::nsPerOp(iterations / 1'000, request));
+    bench::report("100 trees and sets with a ScopedArena, per request", bench::nsPerOp(iterations / 1'000, [&request] {
+        libyang::ScopedArena arena;
+        request();
+    }));
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libyang-cpp/Context.hpp>
+#include "benchmark.hpp"
+#include "example_schema.hpp"
+
+int main(int argc, char* argv[])
+{
+    bench::Session session{"traversal", argc, argv};
+
+    constexpr std::size_t iterations = 10;
+    constexpr int entries = 100'000;
+
+    libyang::Context ctx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+    ctx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+
+    std::string json = R"({"example-schema:bigTree": {"two": {"myList": [)";
+    for (int i = 0; i < entries; ++i) {
+        json += (i ? "," : "") + R"({"thekey": )"s + std::to_string(i) + "}";
+    }
+    json += "]}}}";
+    auto tree = ctx.parseData(json, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+    auto dfs = tree->findPath("/example-schema:bigTree")->childrenDfs();
+
+    bench::report("DFS via Iterator<DataNode>, per node", bench::nsPerOp(iterations, [&dfs] {
+        std::size_t count = 0;
+        for (const auto& node : dfs) {
+            count += node.isTerm();
+        }
+        bench::doNotOptimize(count);
+    }) / (2 * entries + 2));
+
+    bench::report("DFS via DataNodeRef, per node", bench::nsPerOp(iterations, [&dfs] {
+        std::size_t count = 0;
+        for (const auto ref : dfs.refs()) {
+            count += ref.isTerm();
+        }
+        bench::doNotOptimize(count);
+    }) / (2 * entries + 2));
+
+    auto firstEntry = *tree->findPath("/example-schema:bigTree/two")->child();
+    bench::report("sibling iteration via Iterator<DataNode>, per node", bench::nsPerOp(iterations, [&firstEntry] {
+        std::size_t count = 0;
+        for (const auto& node : firstEntry.siblings()) {
+            count += node.isTerm();
+        }
+        bench::doNotOptimize(count);
+    }) / entries);
+
+    bench::report("schema path via SchemaNode::path, per node", bench::nsPerOp(iterations, [&dfs] {
+        std::size_t length = 0;
+        for (const auto ref : dfs.refs()) {
+            length += ref.schema().path().size();
+        }
+        bench::doNotOptimize(length);
+    }) / (2 * entries + 2));
+
+    bench::report("schema path via SchemaNode::pathView, per node", bench::nsPerOp(iterations, [&dfs] {
+        std::size_t length = 0;
+        for (const auto ref : dfs.refs()) {
+            length += ref.schema().pathView().size();
+        }
+        bench::doNotOptimize(length);
+    }) / (2 * entries + 2));
+
+    constexpr std::size_t lookups = 100'000;
+
+    bench::report("findPath of a list instance", bench::nsPerOp(lookups, [&, i = 0]() mutable {
+        auto found = tree->findPath("/example-schema:bigTree/two/myList[thekey='" + std::to_string(i++ % entries) + "']");
+        bench::doNotOptimize(found);
+    }));
+
+    bench::report("findXPath of a list instance", bench::nsPerOp(lookups / 10, [&, i = 0]() mutable {
+        auto found = tree->findXPath("/example-schema:bigTree/two/myList[thekey='" + std::to_string(i++ % entries) + "']");
+        bench::doNotOptimize(found);
+    }));
+
+    bench::report("findXPath of all list instances, per node", bench::nsPerOp(iterations, [&] {
+        auto found = tree->findXPath("/example-schema:bigTree/two/myList");
+        bench::doNotOptimize(found);
+    }) / entries);
+
+    auto allEntries = tree->findXPath("/example-schema:bigTree/two/myList");
+    bench::report("Set<DataNode> iteration, per node", bench::nsPerOp(iterations, [&] {
+        std::size_t length = 0;
+        for (const auto& node : allEntries) {
+            length += node.schema().name().size();
+        }
+        bench::doNotOptimize(length);
+    }) / entries);
+
+    bench::report("Set<DataNode> indexed access, per node", bench::nsPerOp(iterations, [&] {
+        std::size_t length = 0;
+        for (uint32_t i = 0; i < allEntries.size(); ++i) {
+            length += allEntries[i].schema().name().size();
+        }
+        bench::doNotOptimize(length);
+    }) / entries);
+
+    bench::report("Set<DataNode>::toVector, per node", bench::nsPerOp(iterations, [&] {
+        auto nodes = allEntries.toVector();
+        bench::doNotOptimize(nodes);
+    }) / entries);
+
+    auto first = *tree->findPath("/example-schema:bigTree/two")->child();
+    auto myList = ctx.findPath("/example-schema:bigTree/two/myList");
+
+    bench::report("list lookup via DataNode::findSiblingVal", bench::nsPerOp(lookups, [&, i = 0]() mutable {
+        auto found = first.findSiblingVal(myList, "[thekey='" + std::to_string(i++ % entries) + "']");
+        bench::doNotOptimize(found);
+    }));
+
+    bench::report("list lookup via DataNode::findListInstance", bench::nsPerOp(lookups, [&, i = 0]() mutable {
+        const libyang::Value key = int32_t{i++ % entries};
+        auto found = first.findListInstance(myList, std::span{&key, 1});
+        bench::doNotOptimize(found);
+    }));
+
+    std::vector<libyang::ListInstanceKey> preparedKeys;
+    for (int i = 0; i < entries; i += entries / 1000) {
+        const libyang::Value key = int32_t{i};
+        preparedKeys.emplace_back(first.listInstanceKey(myList, std::span{&key, 1}));
+    }
+    bench::report("list lookup via DataNode::findListInstance, prepared keys", bench::nsPerOp(lookups, [&, i = 0]() mutable {
+        auto found = first.findListInstance(preparedKeys[i++ % preparedKeys.size()]);
+        bench::doNotOptimize(found);
+    }));
+
+    auto schemaDfs = ctx.findPath("/example-schema:bigTree").childrenDfs();
+    std::size_t schemaNodes = 0;
+    for ([[maybe_unused]] const auto view : schemaDfs.views()) {
+        ++schemaNodes;
+    }
+
+    bench::report("schema DFS via Iterator<SchemaNode>, per node", bench::nsPerOp(lookups / 100, [&] {
+        std::size_t length = 0;
+        for (const auto& node : schemaDfs) {
+            length += node.nameView().size();
+        }
+        bench::doNotOptimize(length);
+    }) / schemaNodes);
+
+    bench::report("schema DFS via SchemaNodeView, per node", bench::nsPerOp(lookups / 100, [&] {
+        std::size_t length = 0;
+        for (const auto view : schemaDfs.views()) {
+            length += view.name().size();
+        }
+        bench::doNotOptimize(length);
+    }) / schemaNodes);
+
+    auto module = *ctx.getModule("example-schema", std::nullopt);
+    bench::report("Module::childInstantiables, per child", bench::nsPerOp(lookups, [&] {
+        std::size_t length = 0;
+        for (const auto& child : module.childInstantiables()) {
+            length += child.nameView().size();
+        }
+        bench::doNotOptimize(length);
+    }) / module.childInstantiables().size());
+
+    const std::string schemaPath = "/example-schema:bigTree/two/myList/thekey";
+    bench::report("schema lookup via Context::findPath", bench::nsPerOp(lookups, [&] {
+        bench::doNotOptimize(ctx.findPath(schemaPath));
+    }));
+
+    bench::report("schema lookup via Context::findChild", bench::nsPerOp(lookups, [&] {
+        bench::doNotOptimize(ctx.findChild(std::nullopt, "example-schema", "bigTree"));
+    }));
+
+    ctx.buildSchemaIndex();
+    bench::report("schema lookup via Context::findPath, indexed", bench::nsPerOp(lookups, [&] {
+        bench::doNotOptimize(ctx.findPath(schemaPath));
+    }));
+
+    bench::report("schema lookup via Context::findChild, indexed", bench::nsPerOp(lookups, [&] {
+        bench::doNotOptimize(ctx.findChild(std::nullopt, "example-schema", "bigTree"));
+    }));
+
+    auto target = *ctx.newPath("/example-schema:bigTree/two/myList[thekey='" + std::to_string(entries / 2) + "']").findPath("/example-schema:bigTree/two/myList");
+    bench::report("list lookup via DataNode::findSibling, prebuilt key", bench::nsPerOp(lookups, [&] {
+        auto found = first.findSibling(target);
+        bench::doNotOptimize(found);
+    }));
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libyang-cpp/Context.hpp>
+#include <vector>
+#include "benchmark.hpp"
+#include "example_schema.hpp"
+
+namespace {
+/** @short Builds a JSON document with `count` instances of the example-schema:person list. */
+std::string personList(const std::size_t count)
+{
+    std::string res = R"({"example-schema:person": [)";
+    for (std::size_t i = 0; i < count; ++i) {
+        res += (i ? "," : "") + R"({"name": "person)"s + std::to_string(i) + R"("})";
+    }
+    res += "]}";
+    return res;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    bench::Session session{"tree_operations", argc, argv};
+
+    constexpr std::size_t iterations = 1'000;
+
+    libyang::Context ctx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+    ctx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+
+    for (const std::size_t liveWrappers : {std::size_t{100}, std::size_t{10'000}, std::size_t{50'000}}) {
+        const auto suffix = " (" + std::to_string(liveWrappers) + " live wrappers)";
+
+        // Every list instance and its key is wrapped, the way a cache of handles would do it.
+        auto tree = ctx.parseData(personList(liveWrappers / 2 + 1), libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+        std::vector<libyang::DataNode> live;
+        live.reserve(liveWrappers);
+        for (const auto& node : tree->siblings()) {
+            live.emplace_back(node);
+            live.emplace_back(*node.child());
+        }
+
+        auto leaf = ctx.newPath("/example-schema:leafInt32", "42");
+        bench::report("insertSibling + unlink" + suffix, bench::nsPerOp(iterations, [&tree, &leaf] {
+            tree->insertSibling(leaf);
+            leaf.unlink();
+        }));
+
+        auto container = ctx.newPath("/example-schema:bigTree/two");
+        tree->insertSibling(container);
+        auto two = *container.findPath("/example-schema:bigTree/two");
+        auto entry = *ctx.newPath("/example-schema:bigTree/two/myList[thekey='1']").findPath("/example-schema:bigTree/two/myList");
+        entry.unlink();
+        bench::report("insertChild + unlink" + suffix, bench::nsPerOp(iterations, [&two, &entry] {
+            two.insertChild(entry);
+            entry.unlink();
+        }));
+
+        auto sets = std::vector<libyang::Set<libyang::DataNode>>{};
+        for (int i = 0; i < 10; ++i) {
+            sets.emplace_back(tree->findXPath("/example-schema:person[name='person0']"));
+        }
+        bench::report("insertSibling + unlink, with unrelated sets" + suffix, bench::nsPerOp(iterations, [&tree, &leaf] {
+            tree->insertSibling(leaf);
+            leaf.unlink();
+        }));
+
+        constexpr std::size_t batchSize = 100;
+        bench::report("insertSibling + unlink in a batch, per edit" + suffix, bench::nsPerOp(iterations / batchSize, [&tree, &leaf] {
+            auto batch = tree->beginBatch();
+            for (std::size_t i = 0; i < batchSize; ++i) {
+                tree->insertSibling(leaf);
+                leaf.unlink();
+            }
+        }) / batchSize);
+    }
+
+    // Flat (path, value) pairs, the way telemetry usually arrives
+    std::vector<libyang::PathValue> flat;
+    for (int i = 0; i < 1'000; ++i) {
+        flat.push_back({"/example-schema:bigTree/two/myList[thekey='" + std::to_string(i) + "']", std::nullopt});
+        flat.push_back({"/example-schema:bigTree/one/myLeaf", std::to_string(i)});
+    }
+    const auto updates = libyang::CreationOptions::Update;
+
+    bench::report("newPath for each of the paths, per path", bench::nsPerOp(iterations / 100, [&ctx, &flat, updates] {
+        auto tree = ctx.newPath(flat.front().path, flat.front().value, updates);
+        for (const auto& node : flat) {
+            tree.newPath(node.path, node.value, updates);
+        }
+        bench::doNotOptimize(tree);
+    }) / flat.size());
+
+    bench::report("newPaths, per path", bench::nsPerOp(iterations / 100, [&ctx, &flat, updates] {
+        auto tree = ctx.newPaths(flat, updates);
+        bench::doNotOptimize(tree);
+    }) / flat.size());
+
+    // A read-consistent view for each reader of a 2000-node tree
+    auto running = ctx.newPaths(flat, updates);
+    bench::report("duplicateWithSiblings of 2000 nodes", bench::nsPerOp(iterations / 10, [&running] {
+        bench::doNotOptimize(running->duplicateWithSiblings(libyang::DuplicationOptions::Recursive));
+    }));
+    bench::report("snapshot of 2000 unchanged nodes", bench::nsPerOp(iterations * 100, [&running] {
+        bench::doNotOptimize(running->snapshot());
+    }));
+
+    // Copying one list instance into a response
+    auto instance = *running->findPath("/example-schema:bigTree/two/myList[thekey='500']");
+    bench::report("duplicate + insertChild", bench::nsPerOp(iterations * 10, [&ctx, &instance] {
+        auto response = ctx.newPath("/example-schema:bigTree/two");
+        response.child()->insertChild(instance.duplicate(libyang::DuplicationOptions::Recursive));
+        bench::doNotOptimize(response);
+    }));
+    bench::report("duplicate into a parent", bench::nsPerOp(iterations * 10, [&ctx, &instance] {
+        auto response = ctx.newPath("/example-schema:bigTree/two");
+        instance.duplicate(libyang::DuplicationOptions::Recursive, *response.child());
+        bench::doNotOptimize(response);
+    }));
+    bench::report("duplicatePartial of the subtree with 1 level", bench::nsPerOp(iterations, [&running] {
+        bench::doNotOptimize(running->duplicatePartial(1, nullptr));
+    }));
+
+    // A batch of small notifications as received by a collector; this locks the schema, so it goes last
+    std::vector<std::string> notifications;
+    for (int i = 0; i < 1'000; ++i) {
+        notifications.push_back(R"({"example-schema:event": {"event-class": "fault)"s + std::to_string(i) + R"("}})");
+    }
+    ctx.lockSchema();
+    bench::report("parseOp of 1000 notifications, per notification", bench::nsPerOp(iterations / 10, [&ctx, &notifications] {
+        for (const auto& notification : notifications) {
+            bench::doNotOptimize(ctx.parseOp(notification, libyang::DataFormat::JSON, libyang::OperationType::NotificationYang));
+        }
+    }) / notifications.size());
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{4}, std::size_t{0}}) {
+        bench::report("parseMany of 1000 notifications on " + (threads ? std::to_string(threads) : "all"s) + " threads, per notification",
+                bench::nsPerOp(iterations / 10, [&ctx, &notifications, threads] {
+                    bench::doNotOptimize(ctx.parseMany(notifications, libyang::DataFormat::JSON, libyang::OperationType::NotificationYang, threads));
+                }) / notifications.size());
+    }
+}
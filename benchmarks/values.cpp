@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libyang-cpp/Binding.hpp>
+#include <libyang-cpp/Context.hpp>
+#include "benchmark.hpp"
+#include "example_schema.hpp"
+
+int main(int argc, char* argv[])
+{
+    bench::Session session{"values", argc, argv};
+
+    constexpr std::size_t iterations = 1'000'000;
+
+    libyang::Context ctx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+    ctx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+    const auto leaves = R"({
+        "example-schema:leafInt32": 42,
+        "example-schema:leafString": "some string which does not fit into the small string optimization buffer",
+        "example-schema:leafBinary": "AAAABBBBCCCCDDDDEEEEFFFFGGGGHHHHIIIIJJJJ",
+        "example-schema:intOrString": 14332,
+        "example-schema:flagBits": "carry overflow"
+    })"s;
+    auto tree = ctx.parseData(leaves, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+    auto otherTree = ctx.parseData(leaves, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+
+    for (const auto path : {"/example-schema:leafInt32", "/example-schema:leafString", "/example-schema:leafBinary", "/example-schema:intOrString", "/example-schema:flagBits"}) {
+        auto term = tree->findPath(path)->asTerm();
+        bench::report("value() "s + path, bench::nsPerOp(iterations, [&term] {
+            bench::doNotOptimize(term.value());
+        }));
+        bench::report("valueView() "s + path, bench::nsPerOp(iterations, [&term] {
+            bench::doNotOptimize(term.valueView());
+        }));
+        bench::report("valueStr() "s + path, bench::nsPerOp(iterations, [&term] {
+            bench::doNotOptimize(term.valueStr());
+        }));
+        auto other = otherTree->findPath(path)->asTerm();
+        bench::report("valueStr() == valueStr() "s + path, bench::nsPerOp(iterations, [&term, &other] {
+            bench::doNotOptimize(term.valueStr() == other.valueStr());
+        }));
+        bench::report("valueEquals() "s + path, bench::nsPerOp(iterations, [&term, &other] {
+            bench::doNotOptimize(term.valueEquals(other));
+        }));
+        bench::report("valueHash() "s + path, bench::nsPerOp(iterations, [&term] {
+            bench::doNotOptimize(term.valueHash());
+        }));
+    }
+
+    auto counter = tree->findPath("/example-schema:leafInt32")->asTerm();
+    bench::report("std::get<int32_t>(value())", bench::nsPerOp(iterations, [&counter] {
+        bench::doNotOptimize(std::get<int32_t>(counter.value()));
+    }));
+    bench::report("valueAs<int32_t>()", bench::nsPerOp(iterations, [&counter] {
+        bench::doNotOptimize(counter.valueAs<int32_t>());
+    }));
+    int32_t tick = 0;
+    bench::report("changeValue(std::to_string())", bench::nsPerOp(iterations, [&counter, &tick] {
+        bench::doNotOptimize(counter.changeValue(std::to_string(++tick)));
+    }));
+    bench::report("changeValue(int32_t)", bench::nsPerOp(iterations, [&counter, &tick] {
+        bench::doNotOptimize(counter.changeValue(++tick));
+    }));
+
+    ctx.parseModule(example_schema2, libyang::SchemaFormat::YANG);
+    auto cont = ctx.parseData(R"({"example-schema2:contWithTwoNodes": {"one": 1, "two": 2}})"s, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+    struct TwoNodes {
+        int32_t one;
+        int32_t two;
+    };
+    bench::report("struct of 2 leaves via findPath + std::get", bench::nsPerOp(iterations, [&cont] {
+        TwoNodes res{
+            .one = std::get<int32_t>(cont->findPath("one")->asTerm().value()),
+            .two = std::get<int32_t>(cont->findPath("two")->asTerm().value()),
+        };
+        bench::doNotOptimize(res);
+    }));
+    auto binding = libyang::StructBinding<TwoNodes>{ctx.findPath("/example-schema2:contWithTwoNodes")}
+        .field("one", &TwoNodes::one)
+        .field("two", &TwoNodes::two);
+    bench::report("struct of 2 leaves via StructBinding", bench::nsPerOp(iterations, [&cont, &binding] {
+        bench::doNotOptimize(binding.decode(*cont));
+    }));
+
+    std::string json = R"({"example-schema:bigTree": {"two": {"myList": [)";
+    for (int i = 0; i < 10'000; ++i) {
+        json += (i ? "," : "") + R"({"thekey": )"s + std::to_string(i) + "}";
+    }
+    json += "]}}}";
+    auto list = ctx.parseData(json, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+    auto firstEntry = *list->findPath("/example-schema:bigTree/two/myList[1]");
+    std::vector<int64_t> keys(10'000);
+    bench::report("column of 10k list keys via siblings() + valueAs", bench::nsPerOp(100, [&] {
+        std::size_t row = 0;
+        for (const auto& entry : firstEntry.siblings()) {
+            keys[row++] = entry.child()->asTerm().valueAs<int32_t>();
+        }
+        bench::doNotOptimize(keys);
+    }));
+    auto extractor = libyang::ColumnExtractor{ctx.findPath("/example-schema:bigTree/two/myList")}
+        .column(ctx.findPath("/example-schema:bigTree/two/myList/thekey"), keys);
+    bench::report("column of 10k list keys via ColumnExtractor", bench::nsPerOp(100, [&] {
+        bench::doNotOptimize(extractor.extract(firstEntry));
+        bench::doNotOptimize(keys);
+    }));
+}
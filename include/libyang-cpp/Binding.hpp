@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libyang-cpp/DataNode.hpp>
+#include <libyang-cpp/SchemaNode.hpp>
+#include <libyang-cpp/Set.hpp>
+#include <libyang-cpp/export.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+struct ly_ctx;
+struct lyd_node;
+struct lysc_node;
+
+namespace libyang {
+namespace impl {
+/**
+ * @brief How the value of a bound member is read from a term node. Internal use only.
+ */
+enum class binding_kind {
+    String,
+    Bool,
+    Signed,
+    Unsigned,
+};
+
+/**
+ * @brief A term node passed to the decoder of a bound member. Internal use only.
+ */
+struct LIBYANG_CPP_EXPORT binding_term {
+    const lyd_node* node;
+
+    std::string_view asString() const;
+    bool asBool() const;
+    int64_t asSigned() const;
+    uint64_t asUnsigned() const;
+};
+
+/**
+ * @brief Collects the values of a bound member when encoding. Internal use only.
+ */
+struct LIBYANG_CPP_EXPORT binding_sink {
+    std::vector<std::string>* values;
+
+    void add(std::string value) const
+    {
+        values->push_back(std::move(value));
+    }
+};
+
+/**
+ * @brief The part of StructBinding which does not depend on the bound type. Internal use only.
+ */
+class LIBYANG_CPP_EXPORT binding_core {
+public:
+    struct Field {
+        const lysc_node* schema;
+        std::function<void(void* object)> reset;
+        std::function<void(binding_term term, void* object)> decode;
+        std::function<void(const void* object, binding_sink sink)> encode;
+    };
+
+    explicit binding_core(const SchemaNode& node);
+    void addField(const std::string& name, const bool leafList, const binding_kind kind, const std::size_t width, Field field);
+    void decode(const DataNode& node, void* object) const;
+    void encode(const void* object, DataNode& node) const;
+
+private:
+    std::shared_ptr<ly_ctx> m_ctx;
+    const lysc_node* m_node;
+    std::vector<Field> m_fields;
+};
+
+template <typename V>
+struct binding_value_traits;
+
+template <>
+struct binding_value_traits<std::string> {
+    static constexpr auto kind = binding_kind::String;
+    static constexpr std::size_t width = 0;
+    static std::string read(const binding_term term)
+    {
+        return std::string{term.asString()};
+    }
+    static std::string write(const std::string& value)
+    {
+        return value;
+    }
+};
+
+template <>
+struct binding_value_traits<bool> {
+    static constexpr auto kind = binding_kind::Bool;
+    static constexpr std::size_t width = sizeof(bool);
+    static bool read(const binding_term term)
+    {
+        return term.asBool();
+    }
+    static std::string write(const bool value)
+    {
+        return value ? "true" : "false";
+    }
+};
+
+template <std::integral V>
+    requires(!std::is_same_v<V, bool>)
+struct binding_value_traits<V> {
+    static constexpr auto kind = std::is_signed_v<V> ? binding_kind::Signed : binding_kind::Unsigned;
+    static constexpr std::size_t width = sizeof(V);
+    static V read(const binding_term term)
+    {
+        if constexpr (std::is_signed_v<V>) {
+            return static_cast<V>(term.asSigned());
+        } else {
+            return static_cast<V>(term.asUnsigned());
+        }
+    }
+    static std::string write(const V value)
+    {
+        return std::to_string(value);
+    }
+};
+
+template <typename M>
+struct binding_member_traits {
+    using Value = binding_value_traits<M>;
+    static constexpr bool leafList = false;
+    static void reset(M& member)
+    {
+        member = M{};
+    }
+    static void decode(const binding_term term, M& member)
+    {
+        member = Value::read(term);
+    }
+    static void encode(const M& member, const binding_sink sink)
+    {
+        sink.add(Value::write(member));
+    }
+};
+
+template <typename V>
+struct binding_member_traits<std::optional<V>> {
+    using Value = binding_value_traits<V>;
+    static constexpr bool leafList = false;
+    static void reset(std::optional<V>& member)
+    {
+        member.reset();
+    }
+    static void decode(const binding_term term, std::optional<V>& member)
+    {
+        member = Value::read(term);
+    }
+    static void encode(const std::optional<V>& member, const binding_sink sink)
+    {
+        if (member) {
+            sink.add(Value::write(*member));
+        }
+    }
+};
+
+template <typename V>
+struct binding_member_traits<std::vector<V>> {
+    using Value = binding_value_traits<V>;
+    static constexpr bool leafList = true;
+    static void reset(std::vector<V>& member)
+    {
+        member.clear();
+    }
+    static void decode(const binding_term term, std::vector<V>& member)
+    {
+        member.push_back(Value::read(term));
+    }
+    static void encode(const std::vector<V>& member, const binding_sink sink)
+    {
+        for (const auto& value : member) {
+            sink.add(Value::write(value));
+        }
+    }
+};
+}
+
+/**
+ * @brief Maps the leaf and leaf-list children of a container or a list onto the members of a C++ struct.
+ *
+ * The schema nodes of the fields are looked up once, when the binding is set up. Decoding then walks the children of
+ * a data node once and reads the stored values directly, without parsing any paths or constructing a Value.
+ *
+ * Supported member types are `std::string` (the canonical value of any leaf), `bool`, integers (for integral leaves of
+ * the same signedness whose type, or at least whose range restriction, fits into the member), `std::optional` of these
+ * for leaves which might be missing, and `std::vector` of these for leaf-lists.
+ *
+ * @code
+ * struct Person {
+ *     std::string name;
+ *     std::optional<uint8_t> age;
+ * };
+ * auto binding = libyang::StructBinding<Person>{ctx.findPath("/example-schema:person")}
+ *     .field("name", &Person::name)
+ *     .field("age", &Person::age);
+ * Person person = binding.decode(*tree->findPath("/example-schema:person[name='Dan']"));
+ * @endcode
+ *
+ * A binding can be shared by several threads once it is set up.
+ */
+template <typename T>
+class StructBinding {
+public:
+    /**
+     * @brief Creates a binding for data nodes of the `node` container or list.
+     */
+    explicit StructBinding(const SchemaNode& node)
+        : m_core(node)
+    {
+    }
+
+    /**
+     * @brief Binds the child leaf or leaf-list `name` to `member`.
+     *
+     * Use `module:name` for children from other modules. Throws if there is no such child, or if the member's type
+     * does not fit the child's type.
+     */
+    template <typename M>
+    StructBinding& field(const std::string& name, M T::*member)
+    {
+        using Traits = impl::binding_member_traits<M>;
+        m_core.addField(name, Traits::leafList, Traits::Value::kind, Traits::Value::width, impl::binding_core::Field{
+            .schema = nullptr,
+            .reset = [member](void* object) { Traits::reset(static_cast<T*>(object)->*member); },
+            .decode = [member](const impl::binding_term term, void* object) { Traits::decode(term, static_cast<T*>(object)->*member); },
+            .encode = [member](const void* object, const impl::binding_sink sink) { Traits::encode(static_cast<const T*>(object)->*member, sink); },
+        });
+        return *this;
+    }
+
+    /**
+     * @brief Reads the bound children of `node` into a new object.
+     */
+    T decode(const DataNode& node) const
+    {
+        T res{};
+        decodeInto(node, res);
+        return res;
+    }
+
+    /**
+     * @brief Reads the bound children of `node` into `object`, so that its buffers can be reused.
+     *
+     * Bound members whose nodes are missing are reset.
+     */
+    void decodeInto(const DataNode& node, T& object) const
+    {
+        m_core.decode(node, &object);
+    }
+
+    /**
+     * @brief Stores the bound members of `object` as children of `node`.
+     *
+     * Existing leaves are changed. Leaves of empty optional members are removed, and leaf-lists are replaced.
+     * List keys are not modified.
+     */
+    void encode(const T& object, DataNode& node) const
+    {
+        m_core.encode(&object, node);
+    }
+
+private:
+    impl::binding_core m_core;
+};
+
+/**
+ * @brief Reads the same leaves of many list entries into columns, e.g., for an export into a time-series database.
+ *
+ * The leaves are looked up once, when the extractor is set up. Each extraction then finds the leaves of all entries in
+ * one pass, and converts the values column by column, without creating any wrappers.
+ *
+ * @code
+ * std::vector<std::string_view> names(256);
+ * std::vector<uint64_t> octets(256);
+ * auto extractor = libyang::ColumnExtractor{ctx.findPath("/ietf-interfaces:interfaces/interface")}
+ *     .column(ctx.findPath("/ietf-interfaces:interfaces/interface/name"), names)
+ *     .column(ctx.findPath("/ietf-interfaces:interfaces/interface/statistics/in-octets"), octets);
+ * auto count = extractor.extract(*tree->findPath("/ietf-interfaces:interfaces/interface[1]"));
+ * @endcode
+ *
+ * The buffers are provided by the caller, and they have to outlive the extractor. An extractor must not be used by
+ * several threads at once.
+ */
+class LIBYANG_CPP_EXPORT ColumnExtractor {
+public:
+    explicit ColumnExtractor(const SchemaNode& list);
+    ColumnExtractor& column(const SchemaNode& leaf, std::span<int64_t> values, std::span<bool> present = {});
+    ColumnExtractor& column(const SchemaNode& leaf, std::span<uint64_t> values, std::span<bool> present = {});
+    ColumnExtractor& column(const SchemaNode& leaf, std::span<double> values, std::span<bool> present = {});
+    ColumnExtractor& column(const SchemaNode& leaf, std::span<std::string_view> values, std::span<bool> present = {});
+    std::size_t extract(const DataNode& entry) const;
+    std::size_t extract(const Set<DataNode>& entries) const;
+
+private:
+    struct Column {
+        /** @brief The data nodes on the way from an entry to the leaf, choices and cases are skipped. */
+        std::vector<const lysc_node*> steps;
+        int baseType;
+        /** @brief How many times a Decimal64 value is greater than the actual number. */
+        double scale;
+        std::variant<std::span<int64_t>, std::span<uint64_t>, std::span<double>, std::span<std::string_view>> values;
+        std::span<bool> present;
+    };
+
+    void addColumn(const SchemaNode& leaf, Column column);
+    std::size_t capacity() const;
+    void gather(const lyd_node* entry, const std::size_t row) const;
+    void convert(const std::size_t rows) const;
+
+    std::shared_ptr<ly_ctx> m_ctx;
+    const lysc_node* m_list;
+    std::vector<Column> m_columns;
+    /** @brief The leaves of the extracted entries, row by row. */
+    mutable std::vector<const lyd_node*> m_cells;
+};
+}
@@ -6,8 +6,13 @@
  * SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
+#include <compare>
+#include <cstddef>
+#include <iterator>
 #include <libyang-cpp/SchemaNode.hpp>
 #include <libyang-cpp/export.h>
+#include <memory>
+#include <vector>
 
 struct lysc_module;
 namespace libyang {
@@ -16,26 +21,46 @@ class Module;
 
 class LIBYANG_CPP_EXPORT ChildInstanstiablesIterator {
 public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = SchemaNode;
+    using reference = SchemaNode;
+    using difference_type = std::ptrdiff_t;
+
+    ChildInstanstiablesIterator();
     friend ChildInstanstiables;
     SchemaNode operator*() const;
     ChildInstanstiablesIterator& operator++();
     ChildInstanstiablesIterator operator++(int);
+    ChildInstanstiablesIterator& operator--();
+    ChildInstanstiablesIterator operator--(int);
+    ChildInstanstiablesIterator& operator+=(difference_type n);
+    ChildInstanstiablesIterator& operator-=(difference_type n);
+    ChildInstanstiablesIterator operator+(difference_type n) const;
+    ChildInstanstiablesIterator operator-(difference_type n) const;
+    difference_type operator-(const ChildInstanstiablesIterator& other) const;
+    SchemaNode operator[](difference_type n) const;
     bool operator==(const ChildInstanstiablesIterator&) const;
+    std::strong_ordering operator<=>(const ChildInstanstiablesIterator&) const;
+
+    friend ChildInstanstiablesIterator operator+(difference_type n, const ChildInstanstiablesIterator& it)
+    {
+        return it + n;
+    }
 
     struct SchemaNodeProxy {
         SchemaNode node;
-        SchemaNode* operator->();
+        SchemaNode* operator->()
+        {
+            return &node;
+        }
     };
     SchemaNodeProxy operator->() const;
 
 private:
-    ChildInstanstiablesIterator(const lysc_node* parent, const lysc_module* module, const ChildInstanstiables* childInstantiables);
-    ChildInstanstiablesIterator(const std::nullptr_t parent, const ChildInstanstiables* childInstantiables);
+    ChildInstanstiablesIterator(const lysc_node* const* current, const ChildInstanstiables* childInstantiables);
 
     const ChildInstanstiables* m_childInstantiables;
-    const lysc_node* m_parent;
-    const lysc_module* m_module;
-    const lysc_node* m_current;
+    const lysc_node* const* m_current;
 };
 
 /**
@@ -50,11 +75,16 @@ public:
     friend ChildInstanstiablesIterator;
     ChildInstanstiablesIterator begin() const;
     ChildInstanstiablesIterator end() const;
+    SchemaNode operator[](std::size_t index) const;
+    SchemaNodeView view(std::size_t index) const&;
+    // The view borrows the context from this object, so don't allow creating one from a temporary
+    SchemaNodeView view(std::size_t index) const&& = delete;
+    std::size_t size() const;
+    bool empty() const;
 
 private:
-    ChildInstanstiables(const lysc_node* parent, const lysc_module* module, std::shared_ptr<ly_ctx> ctx);
-    const lysc_node* m_parent;
-    const lysc_module* m_module;
+    ChildInstanstiables(const lysc_node* parent, const lysc_module* module, const uint32_t options, std::shared_ptr<ly_ctx> ctx);
+    std::shared_ptr<const std::vector<const lysc_node*>> m_children;
     std::shared_ptr<ly_ctx> m_ctx;
 };
 }
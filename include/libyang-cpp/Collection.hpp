@@ -12,8 +12,10 @@
 #include <libyang-cpp/Enum.hpp>
 #include <libyang-cpp/Utils.hpp>
 #include <libyang-cpp/export.h>
+#include <cstddef>
 #include <memory>
-#include <set>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 struct lyd_meta;
@@ -26,6 +28,12 @@ namespace libyang {
 template <typename NodeType, IterationType ITER_TYPE>
 class Collection;
 class DataNode;
+template <IterationType ITER_TYPE>
+class DataNodeRefIterator;
+template <IterationType ITER_TYPE>
+class DataNodeRefRange;
+template <IterationType ITER_TYPE>
+class SchemaNodeViewRange;
 class Meta;
 class MetaCollection;
 class SchemaNode;
@@ -48,6 +56,7 @@ public:
 
     ~Iterator();
     Iterator(const Iterator&);
+    Iterator(Iterator&&) noexcept;
 
     Iterator<NodeType, ITER_TYPE>& operator++();
     Iterator<NodeType, ITER_TYPE> operator++(int);
@@ -64,9 +73,12 @@ public:
     NodeProxy operator->() const;
     bool operator==(const Iterator& it) const;
     Iterator& operator=(const Iterator& it);
+    Iterator& operator=(Iterator&& it) noexcept;
 
     friend Collection<NodeType, ITER_TYPE>;
     friend MetaCollection;
+    template <typename T>
+    friend class impl::registry;
 
 private:
     Iterator(underlying_node_t<NodeType>* start, const Collection<NodeType, ITER_TYPE>* coll);
@@ -82,6 +94,8 @@ private:
 
     void registerThis();
     void unregisterThis();
+
+    impl::registry_hook<Iterator> m_refsHook;
 };
 
 /**
@@ -102,12 +116,21 @@ public:
     friend SchemaNode;
     ~Collection();
     Collection(const Collection<NodeType, ITER_TYPE>&);
+    Collection(Collection<NodeType, ITER_TYPE>&&) noexcept;
     Collection& operator=(const Collection<NodeType, ITER_TYPE>&);
+    Collection& operator=(Collection<NodeType, ITER_TYPE>&&) noexcept;
 
     Iterator<NodeType, ITER_TYPE> begin() const;
     Iterator<NodeType, ITER_TYPE> end() const;
     bool empty() const;
 
+    DataNodeRefRange<ITER_TYPE> refs() const& requires std::is_same_v<NodeType, DataNode>;
+    // The references are only valid while the collection exists, so don't allow iterating over a temporary one
+    DataNodeRefRange<ITER_TYPE> refs() const&& = delete;
+    SchemaNodeViewRange<ITER_TYPE> views() const& requires std::is_same_v<NodeType, SchemaNode>;
+    // The views borrow the context from the collection, so don't allow iterating over a temporary one
+    SchemaNodeViewRange<ITER_TYPE> views() const&& = delete;
+
 protected:
     Collection(underlying_node_t<NodeType>* start, impl::refs_type_t<NodeType> refs);
     underlying_node_t<NodeType>* m_start;
@@ -119,13 +142,154 @@ protected:
     // `begin` and `end` need to be const
     // because of that DfsIterator can only get a `const DataNodeCollectionDfs*`,
     // however, DfsIterator needs to register itself into m_iterators.
-    mutable std::set<Iterator<NodeType, ITER_TYPE>*> m_iterators;
+    mutable impl::registry<Iterator<NodeType, ITER_TYPE>> m_iterators;
     void invalidate();
 
     template <typename Operation, typename Siblings>
     friend void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Siblings siblings, std::shared_ptr<internal_refcount> newRefs);
+    friend TreeEditBatch;
+    friend DataNodeRefIterator<ITER_TYPE>;
+    friend DataNodeRefRange<ITER_TYPE>;
+    friend SchemaNodeViewIterator<ITER_TYPE>;
+    friend SchemaNodeViewRange<ITER_TYPE>;
+    template <typename T>
+    friend class impl::registry;
+
+    void throwIfInvalid() const;
+
+private:
+    void registerThis();
+    void unregisterThis();
+    void takeOverFrom(Collection<NodeType, ITER_TYPE>& other) noexcept;
+
+    impl::registry_hook<Collection> m_refsHook;
+};
+
+/**
+ * @brief A borrowed reference to a data node, obtained by iterating over Collection::refs.
+ *
+ * Unlike a DataNode, this does not take part in the automatic memory management, so creating and copying it is
+ * just a copy of a few pointers. The price is that it is only valid as long as the Collection which it was obtained
+ * from exists, and is neither invalidated nor assigned to. Accessing a reference from an invalidated collection throws.
+ * Use node() for getting a full DataNode which can outlive the collection.
+ */
+class LIBYANG_CPP_EXPORT DataNodeRef {
+public:
+    std::string_view name() const;
+    SchemaNode schema() const;
+    std::string path() const;
+    bool isTerm() const;
+    bool isOpaque() const;
+    ValueView valueView() const;
+    DataNode node() const;
+
+    bool operator==(const DataNodeRef& other) const;
+
+    template <IterationType ITER_TYPE>
+    friend class DataNodeRefIterator;
+    friend class DataDiff;
+    friend FrozenTree;
+
+private:
+    DataNodeRef(lyd_node* node, const bool* valid, const std::shared_ptr<internal_refcount>* refs);
+    void throwIfInvalid() const;
+
+    lyd_node* m_node;
+    const bool* m_valid;
+    const std::shared_ptr<internal_refcount>* m_refs;
+};
+
+/**
+ * @brief An iterator over a Collection which yields DataNodeRef. It is not registered anywhere, so it can be copied
+ * freely. Only valid as long as the Collection exists.
+ */
+template <IterationType ITER_TYPE>
+class LIBYANG_CPP_EXPORT DataNodeRefIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DataNodeRef;
+    using reference = DataNodeRef;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    DataNodeRefIterator() = default;
+
+    DataNodeRefIterator& operator++();
+    DataNodeRefIterator operator++(int);
+    DataNodeRef operator*() const;
+    bool operator==(const DataNodeRefIterator& other) const;
+
+    friend DataNodeRefRange<ITER_TYPE>;
 
+private:
+    DataNodeRefIterator(lyd_node* start, const Collection<DataNode, ITER_TYPE>* coll);
     void throwIfInvalid() const;
+
+    lyd_node* m_current = nullptr;
+    lyd_node* m_start = nullptr;
+    const Collection<DataNode, ITER_TYPE>* m_collection = nullptr;
+};
+
+/**
+ * @brief A range of DataNodeRef, see Collection::refs.
+ */
+template <IterationType ITER_TYPE>
+class LIBYANG_CPP_EXPORT DataNodeRefRange {
+public:
+    DataNodeRefIterator<ITER_TYPE> begin() const;
+    DataNodeRefIterator<ITER_TYPE> end() const;
+
+    friend Collection<DataNode, ITER_TYPE>;
+
+private:
+    explicit DataNodeRefRange(const Collection<DataNode, ITER_TYPE>* coll);
+    const Collection<DataNode, ITER_TYPE>* m_collection;
+};
+
+/**
+ * @brief An iterator over a Collection which yields SchemaNodeView. It is not registered anywhere, so it can be copied
+ * freely. Only valid as long as the Collection exists.
+ */
+template <IterationType ITER_TYPE>
+class LIBYANG_CPP_EXPORT SchemaNodeViewIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SchemaNodeView;
+    using reference = SchemaNodeView;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    SchemaNodeViewIterator() = default;
+
+    SchemaNodeViewIterator& operator++();
+    SchemaNodeViewIterator operator++(int);
+    SchemaNodeView operator*() const;
+    bool operator==(const SchemaNodeViewIterator& other) const;
+
+    friend SchemaNodeViewRange<ITER_TYPE>;
+
+private:
+    SchemaNodeViewIterator(const lysc_node* start, const Collection<SchemaNode, ITER_TYPE>* coll);
+
+    const lysc_node* m_current = nullptr;
+    const lysc_node* m_start = nullptr;
+    const Collection<SchemaNode, ITER_TYPE>* m_collection = nullptr;
+};
+
+/**
+ * @brief A range of SchemaNodeView, see Collection::views.
+ */
+template <IterationType ITER_TYPE>
+class LIBYANG_CPP_EXPORT SchemaNodeViewRange {
+public:
+    SchemaNodeViewIterator<ITER_TYPE> begin() const;
+    SchemaNodeViewIterator<ITER_TYPE> end() const;
+
+    friend Collection<SchemaNode, ITER_TYPE>;
+
+private:
+    explicit SchemaNodeViewRange(const Collection<SchemaNode, ITER_TYPE>* coll);
+    const Collection<SchemaNode, ITER_TYPE>* m_collection;
 };
 
 /**
@@ -7,19 +7,28 @@
 */
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <iterator>
 #include <libyang-cpp/Collection.hpp>
 #include <libyang-cpp/ChildInstantiables.hpp>
 #include <libyang-cpp/DataNode.hpp>
+#include <libyang-cpp/DataStreamParser.hpp>
 #include <libyang-cpp/Enum.hpp>
+#include <libyang-cpp/Expected.hpp>
 #include <libyang-cpp/Module.hpp>
 #include <libyang-cpp/SchemaNode.hpp>
 #include <libyang-cpp/Set.hpp>
 #include <libyang-cpp/export.h>
 #include <memory>
+#include <span>
+#include <string_view>
 
 struct ly_ctx;
+struct ly_err_item;
 
 /**
  * @brief The libyang-cpp namespace.
@@ -41,6 +50,18 @@ struct LIBYANG_CPP_EXPORT ModuleInfo {
     std::string data;
     SchemaFormat format;
 };
+
+/**
+ * @brief A module to load via Context::loadModules.
+ */
+struct LIBYANG_CPP_EXPORT ModuleRequest {
+    std::string name;
+    /** @brief std::nullopt for the latest revision. */
+    std::optional<std::string> revision = std::nullopt;
+    /** @brief The features to enable, {"*"} enables all of them. */
+    std::vector<std::string> features = {};
+};
+
 /**
  * @brief Callback for supplying module data.
  *
@@ -75,6 +96,136 @@ struct LIBYANG_CPP_EXPORT ErrorInfo {
     ValidationErrorCode validationCode;
 };
 
+/**
+ * @brief The outcome of parsing one of the inputs of Context::parseMany.
+ */
+template <typename T>
+struct ParseManyResult {
+    Expected<T> result;
+    /** @brief The errors which libyang has recorded while parsing this input. */
+    std::vector<ErrorInfo> errors;
+};
+
+/**
+ * @brief A non-owning view of one libyang error, see Context::errorViews().
+ *
+ * The strings point into libyang's error storage, they are valid until the errors are cleaned, e.g., by
+ * Context::cleanAllErrors().
+ */
+struct LIBYANG_CPP_EXPORT ErrorView {
+    LogLevel level;
+    ErrorCode code;
+    ValidationErrorCode validationCode;
+    std::string_view message;
+    std::optional<std::string_view> appTag;
+    std::optional<std::string_view> dataPath;
+    std::optional<std::string_view> schemaPath;
+    uint64_t line;
+};
+
+/**
+ * @brief A range of the errors of the calling thread, see Context::errorViews().
+ *
+ * Nothing is copied. Both the range and its iterators are valid until the errors are cleaned.
+ */
+class LIBYANG_CPP_EXPORT ErrorViews {
+public:
+    class LIBYANG_CPP_EXPORT iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ErrorView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ErrorView;
+
+        iterator() = default;
+        ErrorView operator*() const;
+        iterator& operator++();
+        iterator operator++(int);
+        bool operator==(const iterator& other) const = default;
+
+    private:
+        explicit iterator(const ly_err_item* item);
+        const ly_err_item* m_item = nullptr;
+        friend ErrorViews;
+    };
+
+    iterator begin() const;
+    iterator end() const;
+    bool empty() const;
+
+private:
+    explicit ErrorViews(const ly_err_item* first);
+    const ly_err_item* m_first;
+    friend Context;
+};
+
+/**
+ * @brief The number of calls of one kind of an operation and the total time spent in them.
+ */
+struct LIBYANG_CPP_EXPORT OperationStats {
+    bool operator==(const OperationStats& other) const = default;
+    uint64_t calls = 0;
+    std::chrono::nanoseconds time{0};
+};
+
+/**
+ * @brief A snapshot of the counters collected by a Context, see Context::enableStats().
+ */
+struct LIBYANG_CPP_EXPORT ContextStats {
+    OperationStats parseData;
+    OperationStats parseOp;
+    OperationStats validate;
+    OperationStats print;
+    OperationStats newPath;
+    OperationStats findXPath;
+    /** @brief DataNode wrappers which were registered with their tree, i.e., created, copied or moved between trees. */
+    uint64_t wrapperRegistrations = 0;
+    /** @brief Sets and collections which were invalidated because nodes were moved between trees. */
+    uint64_t invalidations = 0;
+    /** @brief Trees which were freed because moving nodes left them without any wrappers. */
+    uint64_t orphanFrees = 0;
+};
+
+/**
+ * @brief Callback for exporting one measured operation, e.g., as a span of a tracing system.
+ *
+ * @param operation The kind of the operation.
+ * @param start When the operation started.
+ * @param duration How long the operation took.
+ */
+using SpanCallback = void(const StatsOperation operation, const std::chrono::steady_clock::time_point start, const std::chrono::nanoseconds duration);
+
+/**
+ * @brief Defers compiling the schema until several modules are loaded, parsed or implemented.
+ *
+ * libyang normally compiles the schema after each Context::loadModule, Context::parseModule or Module::setImplemented,
+ * and that includes recompiling all modules which depend on the changed one. Within a batch, these only parse the
+ * modules and record the changes, and all of them are compiled at once by commit(), or when the batch is destroyed.
+ *
+ * Until then, the new modules have no compiled schema nodes, so data cannot be created or parsed according to them.
+ * Batches can be nested, only the outermost one compiles. For contexts created with ContextOptions::ExplicitCompile,
+ * a batch does nothing, and compiling is left to the caller as usual.
+ *
+ * Returned by Context::beginModuleBatch.
+ */
+class LIBYANG_CPP_EXPORT ModuleBatch {
+public:
+    ~ModuleBatch();
+    ModuleBatch(ModuleBatch&&) noexcept;
+    ModuleBatch(const ModuleBatch&) = delete;
+    ModuleBatch& operator=(const ModuleBatch&) = delete;
+    ModuleBatch& operator=(ModuleBatch&&) = delete;
+
+    void commit();
+
+private:
+    friend Context;
+    explicit ModuleBatch(std::shared_ptr<ly_ctx> ctx);
+
+    std::shared_ptr<ly_ctx> m_ctx;
+};
+
 /**
  * @brief libyang context class.
  */
@@ -88,18 +239,52 @@ public:
             const DataFormat format,
             const std::optional<ParseOptions> parseOpts = std::nullopt,
             const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    std::optional<DataNode> parseData(
+            std::span<const std::byte> data,
+            const DataFormat format,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    std::optional<DataNode> parseData(
+            const std::filesystem::path& path,
+            const DataFormat format,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
     std::optional<DataNode> parseData(
             const std::filesystem::path& path,
             const DataFormat format,
+            const DataFileOptions& fileOpts,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    Expected<std::optional<DataNode>> tryParseData(
+            const std::string& data,
+            const DataFormat format,
             const std::optional<ParseOptions> parseOpts = std::nullopt,
             const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    Expected<std::optional<DataNode>> tryParseData(
+            std::span<const std::byte> data,
+            const DataFormat format,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    DataStreamParser parseDataStream(
+            const DataFormat format,
+            std::function<void(DataNode)> callback,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const DataStreamRecordPath& recordPath = {}) const;
     std::optional<DataNode> parseExtData(
         const ExtensionInstance& ext,
         const std::string& data,
         const DataFormat format,
         const std::optional<ParseOptions> parseOpts = std::nullopt,
         const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
+    std::optional<DataNode> parseExtData(
+        const ExtensionInstance& ext,
+        std::span<const std::byte> data,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts = std::nullopt,
+        const std::optional<ValidationOptions> validationOpts = std::nullopt) const;
     Module loadModule(const std::string& name, const std::optional<std::string>& revision = std::nullopt, const std::vector<std::string>& = {}) const;
+    std::vector<Module> loadModules(const std::vector<ModuleRequest>& modules, const std::size_t fetchThreads = 0) const;
+    ModuleBatch beginModuleBatch() const;
     void setSearchDir(const std::filesystem::path& searchDir) const;
     std::optional<Module> getModule(const std::string& name, const std::optional<std::string>& revision) const;
     std::optional<Module> getModuleImplemented(const std::string& name) const;
@@ -107,20 +292,52 @@ public:
     std::vector<Module> modules() const;
     std::optional<SubmoduleParsed> getSubmodule(const std::string& name, const std::optional<std::string>& revision) const;
     void registerModuleCallback(std::function<ModuleCallback> callback);
+    void lockSchema() const;
+    bool isSchemaLocked() const;
+    void enableStats(const bool enabled = true) const;
+    ContextStats stats() const;
+    void resetStats() const;
+    void registerSpanCallback(std::function<SpanCallback> callback) const;
+    void saveCompiled(const std::filesystem::path& path) const;
+    static Context fromCompiled(const std::filesystem::path& path);
 
     ParsedOp parseOp(const std::string& input, const DataFormat format, const OperationType opType) const;
+    ParsedOp parseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const;
+    Expected<ParsedOp> tryParseOp(const std::string& input, const DataFormat format, const OperationType opType) const;
+    Expected<ParsedOp> tryParseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const;
+    std::vector<ParseManyResult<std::optional<DataNode>>> parseMany(
+            std::span<const std::string> inputs,
+            const DataFormat format,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt,
+            const std::size_t threads = 0) const;
+    std::vector<ParseManyResult<ParsedOp>> parseMany(
+            std::span<const std::string> inputs,
+            const DataFormat format,
+            const OperationType opType,
+            const std::size_t threads = 0) const;
 
     DataNode newPath(const std::string& path, const std::optional<std::string>& value = std::nullopt, const std::optional<CreationOptions> options = std::nullopt) const;
     CreatedNodes newPath2(const std::string& path, const std::optional<std::string>& value = std::nullopt, const std::optional<CreationOptions> options = std::nullopt) const;
     CreatedNodes newPath2(const std::string& path, libyang::JSON json, const std::optional<CreationOptions> options = std::nullopt) const;
     CreatedNodes newPath2(const std::string& path, libyang::XML xml, const std::optional<CreationOptions> options = std::nullopt) const;
     std::optional<DataNode> newExtPath(const ExtensionInstance& ext, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options = std::nullopt) const;
+    std::optional<DataNode> newPaths(std::span<const PathValue> nodes, const std::optional<CreationOptions> options = std::nullopt) const;
     std::optional<DataNode> newOpaqueJSON(const std::string& moduleName, const std::string& name, const std::optional<libyang::JSON>& value) const;
     std::optional<DataNode> newOpaqueXML(const std::string& moduleName, const std::string& name, const std::optional<libyang::XML>& value) const;
     SchemaNode findPath(const std::string& dataPath, const InputOutputNodes inputOutputNodes = InputOutputNodes::Input) const;
     Set<SchemaNode> findXPath(const std::string& path) const;
+    std::optional<SchemaNode> findChild(
+            const std::optional<SchemaNode>& parent,
+            const std::string& moduleName,
+            const std::string& name,
+            const InputOutputNodes inputOutputNodes = InputOutputNodes::Input) const;
+    void buildSchemaIndex() const;
+    CheckedXPath checkXPath(const std::string& xpath) const;
 
     std::vector<ErrorInfo> getErrors() const;
+    ErrorViews errorViews() const;
+    ErrorCode lastErrorCode() const;
     void cleanAllErrors();
 
     friend LIBYANG_CPP_EXPORT Context createUnmanagedContext(ly_ctx* ctx, ContextDeleter);
@@ -129,7 +346,5 @@ public:
 private:
     Context(ly_ctx* ctx, ContextDeleter = nullptr);
     std::shared_ptr<ly_ctx> m_ctx;
-
-    std::function<ModuleCallback> m_moduleCallback;
 };
 }
@@ -6,9 +6,14 @@
  * SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
+#include <cstddef>
 #include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
 #include <iterator>
 #include <libyang-cpp/Enum.hpp>
+#include <libyang-cpp/Expected.hpp>
 #include <libyang-cpp/Module.hpp>
 #include <libyang-cpp/SchemaNode.hpp>
 #include <libyang-cpp/Value.hpp>
@@ -16,13 +21,21 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <span>
+#include <utility>
+#include <vector>
 
 struct lyd_node;
 struct lyd_meta;
 struct ly_ctx;
 namespace libyang {
+class ColumnExtractor;
 class Context;
 class DataNode;
+class DataNodeRef;
+class DataDiff;
+class DataStreamParser;
+class FrozenTree;
 class MetaCollection;
 template <typename NodeType>
 class Set;
@@ -36,20 +49,252 @@ struct internal_refcount;
 struct LIBYANG_CPP_EXPORT unmanaged_tag {
 };
 
+namespace impl {
+/**
+ * @brief Links of an intrusive list of wrappers, see impl::registry. Internal use only.
+ *
+ * Copying an object does not copy its links: a copy always starts detached and has to be registered on its own.
+ */
+template <typename T>
+struct registry_hook {
+    registry_hook() = default;
+    registry_hook(const registry_hook&) noexcept
+    {
+    }
+    registry_hook& operator=(const registry_hook&) noexcept
+    {
+        return *this;
+    }
+
+    T* prev = nullptr;
+    T* next = nullptr;
+};
+
+/**
+ * @brief An intrusive doubly-linked list of wrapper objects. Internal use only.
+ *
+ * The links are stored directly in the registered objects (in a `registry_hook<T> m_refsHook` member), so that
+ * registering, unregistering and handing over a registration to a moved-to object is O(1) and never allocates. An
+ * object can be registered in at most one registry at a time.
+ *
+ * Iterating is safe even when the current element is erased from within the loop.
+ */
+template <typename T>
+class registry {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using reference = T* const&;
+        using pointer = T* const*;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(T* current) noexcept
+            : m_current(current)
+            , m_next(current ? current->m_refsHook.next : nullptr)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return m_current;
+        }
+
+        iterator& operator++() noexcept
+        {
+            m_current = m_next;
+            m_next = m_current ? m_current->m_refsHook.next : nullptr;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const noexcept
+        {
+            return m_current == other.m_current;
+        }
+
+    private:
+        T* m_current = nullptr;
+        T* m_next = nullptr;
+    };
+
+    registry() = default;
+    registry(const registry&) = delete;
+    registry& operator=(const registry&) = delete;
+
+    /** @brief Takes over all elements of `other`, leaving it empty. */
+    registry(registry&& other) noexcept
+        : m_head(other.m_head)
+        , m_size(other.m_size)
+    {
+        other.m_head = nullptr;
+        other.m_size = 0;
+    }
+
+    /** @brief Unlinks all current elements and takes over all elements of `other`, leaving it empty. */
+    registry& operator=(registry&& other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            m_head = other.m_head;
+            m_size = other.m_size;
+            other.m_head = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+
+    void insert(T* item) noexcept
+    {
+        auto& hook = item->m_refsHook;
+        hook.prev = nullptr;
+        hook.next = m_head;
+        if (m_head) {
+            m_head->m_refsHook.prev = item;
+        }
+        m_head = item;
+        ++m_size;
+    }
+
+    /** @brief Unlinks `item`. Does nothing if `item` is not registered here. */
+    void erase(T* item) noexcept
+    {
+        if (!contains(item)) {
+            return;
+        }
+
+        auto& hook = item->m_refsHook;
+        if (hook.prev) {
+            hook.prev->m_refsHook.next = hook.next;
+        } else {
+            m_head = hook.next;
+        }
+        if (hook.next) {
+            hook.next->m_refsHook.prev = hook.prev;
+        }
+        hook.prev = nullptr;
+        hook.next = nullptr;
+        --m_size;
+    }
+
+    /**
+     * @brief Puts `to` into the position of `from`, and unlinks `from`. Used by move operations.
+     *
+     * Does nothing if `from` is not registered here.
+     */
+    void replace(T* from, T* to) noexcept
+    {
+        if (from == to || !contains(from)) {
+            return;
+        }
+
+        auto& fromHook = from->m_refsHook;
+        auto& toHook = to->m_refsHook;
+        toHook.prev = fromHook.prev;
+        toHook.next = fromHook.next;
+        if (toHook.prev) {
+            toHook.prev->m_refsHook.next = to;
+        } else {
+            m_head = to;
+        }
+        if (toHook.next) {
+            toHook.next->m_refsHook.prev = to;
+        }
+        fromHook.prev = nullptr;
+        fromHook.next = nullptr;
+    }
+
+    /** @brief Unlinks all elements. */
+    void clear() noexcept
+    {
+        for (auto item : *this) {
+            item->m_refsHook.prev = nullptr;
+            item->m_refsHook.next = nullptr;
+        }
+        m_head = nullptr;
+        m_size = 0;
+    }
+
+    /** @brief Checks whether `item` is linked into this registry, assuming it cannot be linked into another one. */
+    bool contains(const T* item) const noexcept
+    {
+        return item->m_refsHook.prev || m_head == item;
+    }
+
+    iterator begin() const noexcept
+    {
+        return iterator{m_head};
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator{};
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+private:
+    T* m_head = nullptr;
+    std::size_t m_size = 0;
+};
+}
+
 
 class Meta;
 class DataNodeAny;
 class DataNodeOpaque;
 class DataNodeTerm;
+class TreeEditBatch;
 struct ParsedOp;
 struct CreatedNodes;
 
 namespace impl {
+class binding_core;
+struct batch_state;
+struct frozen_state;
 std::optional<DataNode> newPath(lyd_node* node, ly_ctx* parent, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options);
 CreatedNodes newPath2(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refcount> refs, const std::string& path, const void* value, const AnydataValueType valueType, const std::optional<CreationOptions> options);
 std::optional<DataNode> newExtPath(lyd_node* node, const lysc_ext_instance* ext, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options);
 }
 
+/**
+ * @brief A node to create via newPaths: its path and, optionally, its value.
+ */
+struct LIBYANG_CPP_EXPORT PathValue {
+    std::string path;
+    std::optional<std::string> value;
+};
+
+/**
+ * @brief How a data file is written by DataNode::print, and read by Context::parseData.
+ *
+ * Compressed files are recognized by their content when they are parsed, so `compression` only applies to printing.
+ */
+struct LIBYANG_CPP_EXPORT DataFileOptions {
+    Compression compression = Compression::None;
+    /** @brief The compression level, std::nullopt for the default of the compression library. */
+    std::optional<int> level = std::nullopt;
+    /** @brief The size of the chunks in which the file is read and written. */
+    std::size_t bufferSize = 1024 * 1024;
+};
+
 LIBYANG_CPP_EXPORT DataNode wrapRawNode(lyd_node* node, std::shared_ptr<void> customContext = nullptr);
 LIBYANG_CPP_EXPORT const DataNode wrapUnmanagedRawNode(const lyd_node* node);
 LIBYANG_CPP_EXPORT lyd_node* releaseRawNode(DataNode node);
@@ -59,12 +304,56 @@ template <typename Operation, typename Siblings>
 void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Siblings siblings, std::shared_ptr<internal_refcount> newRefs);
 
 LIBYANG_CPP_EXPORT void validateAll(std::optional<libyang::DataNode>& node, const std::optional<ValidationOptions>& opts = std::nullopt);
+LIBYANG_CPP_EXPORT void validateIncremental(std::optional<libyang::DataNode>& node, const std::optional<ValidationOptions>& opts = std::nullopt);
 
 LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(
         const std::optional<libyang::DataNode>& contextNode,
         const libyang::DataNode& forest,
         const std::string& xpath);
 
+class CheckedXPath;
+LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(
+        const std::optional<libyang::DataNode>& contextNode,
+        const libyang::DataNode& forest,
+        const CheckedXPath& xpath);
+
+/**
+ * @brief An XPath expression which was checked to be valid in a Context, so that it cannot fail to parse later on.
+ *
+ * The expression is still evaluated from scratch on each search. Create this via Context::checkXPath.
+ */
+class LIBYANG_CPP_EXPORT CheckedXPath {
+public:
+    const std::string& expression() const;
+
+    friend Context;
+    friend DataNode;
+    friend LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(const std::optional<libyang::DataNode>& contextNode, const libyang::DataNode& forest, const CheckedXPath& xpath);
+
+private:
+    CheckedXPath(std::shared_ptr<const std::string> expression, std::shared_ptr<ly_ctx> ctx);
+    void checkContext(const lyd_node* node, const char* where) const;
+
+    std::shared_ptr<const std::string> m_expression;
+    std::shared_ptr<ly_ctx> m_ctx;
+};
+
+/**
+ * @brief The keys of a list instance, prepared once for repeated lookups via DataNode::findListInstance.
+ *
+ * Create this via DataNode::listInstanceKey.
+ */
+class LIBYANG_CPP_EXPORT ListInstanceKey {
+public:
+    friend DataNode;
+
+private:
+    ListInstanceKey(lyd_node* node, std::shared_ptr<ly_ctx> ctx);
+
+    std::shared_ptr<lyd_node> m_node;
+    std::shared_ptr<ly_ctx> m_ctx;
+};
+
 /**
  * @brief Class representing a node in a libyang tree.
  *
@@ -74,7 +363,9 @@ class LIBYANG_CPP_EXPORT DataNode {
 public:
     ~DataNode();
     DataNode(const DataNode& node);
+    DataNode(DataNode&& node) noexcept;
     DataNode& operator=(const DataNode& node);
+    DataNode& operator=(DataNode&& node) noexcept;
 
     DataNode firstSibling() const;
     DataNode previousSibling() const;
@@ -82,9 +373,20 @@ public:
     std::optional<DataNode> parent() const;
     std::optional<DataNode> child() const;
     std::optional<std::string> printStr(const DataFormat format, const PrintFlags flags) const;
+    void print(std::ostream& out, const DataFormat format, const PrintFlags flags) const;
+    void print(const int fd, const DataFormat format, const PrintFlags flags) const;
+    void print(const std::filesystem::path& file, const DataFormat format, const PrintFlags flags) const;
+    void print(const std::filesystem::path& file, const DataFormat format, const PrintFlags flags, const DataFileOptions& fileOpts) const;
+    void print(const std::function<void(std::string_view)>& sink, const DataFormat format, const PrintFlags flags) const;
     std::optional<DataNode> findPath(const std::string& path, const InputOutputNodes inputOutputNodes = InputOutputNodes::Input) const;
+    Expected<std::optional<DataNode>> tryFindPath(const std::string& path, const InputOutputNodes inputOutputNodes = InputOutputNodes::Input) const;
     Set<DataNode> findXPath(const std::string& path) const;
+    Set<DataNode> findXPath(const CheckedXPath& path) const;
     std::optional<DataNode> findSiblingVal(SchemaNode schema, const std::optional<std::string>& value = std::nullopt) const;
+    std::optional<DataNode> findListInstance(const SchemaNode& list, std::span<const Value> keys) const;
+    ListInstanceKey listInstanceKey(const SchemaNode& list, std::span<const Value> keys) const;
+    std::optional<DataNode> findListInstance(const ListInstanceKey& key) const;
+    std::optional<DataNode> findSibling(const DataNode& target) const;
     std::string path() const;
     bool isTerm() const;
     DataNodeTerm asTerm() const;
@@ -95,18 +397,23 @@ public:
     CreatedNodes newPath2(const std::string& path, libyang::JSON json, const std::optional<CreationOptions> options = std::nullopt) const;
     CreatedNodes newPath2(const std::string& path, libyang::XML xml, const std::optional<CreationOptions> options = std::nullopt) const;
     std::optional<DataNode> newExtPath(const ExtensionInstance& ext, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options = std::nullopt) const;
+    void newPaths(std::span<const PathValue> nodes, const std::optional<CreationOptions> options = std::nullopt) const;
 
     void newMeta(const Module& module, const std::string& name, const std::string& value);
     MetaCollection meta() const;
+    std::optional<Meta> findMeta(const Module& module, const std::string& name) const;
+    std::optional<Meta> findMeta(const std::string& qualifiedName) const;
     void newAttrOpaqueJSON(const std::optional<std::string>& moduleName, const std::string& attrName, const std::optional<std::string>& attrValue) const;
 
     bool isOpaque() const;
     DataNodeOpaque asOpaque() const;
 
-    // TODO: allow setting the `parent` argument
     DataNode duplicate(const std::optional<DuplicationOptions> opts = std::nullopt) const;
-    // TODO: allow setting the `parent` argument
+    DataNode duplicate(const std::optional<DuplicationOptions> opts, const DataNode& parent) const;
     DataNode duplicateWithSiblings(const std::optional<DuplicationOptions> opts = std::nullopt) const;
+    DataNode duplicateWithSiblings(const std::optional<DuplicationOptions> opts, const DataNode& parent) const;
+    DataNode duplicatePartial(const std::optional<uint32_t> depth, const std::function<bool(const SchemaNode&)>& filter, const std::optional<DuplicationOptions> opts = std::nullopt) const;
+    DataNode duplicatePartial(const std::optional<uint32_t> depth, const std::function<bool(const SchemaNode&)>& filter, const std::optional<DuplicationOptions> opts, const DataNode& parent) const;
     void unlink();
     void unlinkWithSiblings();
     void insertChild(DataNode toInsert);
@@ -115,6 +422,12 @@ public:
     void insertBefore(DataNode toInsert);
     // TODO: allow setting options
     void merge(DataNode toInsert);
+    [[nodiscard]] TreeEditBatch beginBatch() const;
+    FrozenTree freeze() const;
+    FrozenTree snapshot() const;
+
+    DataDiff diffSiblings(const DataNode& other, const DiffOptions options = DiffOptions::NoOptions) const;
+    DataDiff diffTree(const DataNode& other, const DiffOptions options = DiffOptions::NoOptions) const;
 
     Collection<DataNode, IterationType::Dfs> childrenDfs() const;
 
@@ -122,23 +435,38 @@ public:
     Collection<DataNode, IterationType::Sibling> immediateChildren() const;
 
     ParsedOp parseOp(const std::string& input, const DataFormat format, const OperationType opType) const;
+    ParsedOp parseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const;
 
     void parseSubtree(
             const std::string& data,
             const DataFormat format,
             const std::optional<ParseOptions> parseOpts = std::nullopt,
             const std::optional<ValidationOptions> validationOpts = std::nullopt);
+    void parseSubtree(
+            std::span<const std::byte> data,
+            const DataFormat format,
+            const std::optional<ParseOptions> parseOpts = std::nullopt,
+            const std::optional<ValidationOptions> validationOpts = std::nullopt);
 
     bool isEqual(const libyang::DataNode& other, const DataCompare flags=DataCompare::NoOptions) const;
     bool siblingsEqual(const libyang::DataNode& other, const DataCompare flags=DataCompare::NoOptions) const;
 
     friend Context;
     friend DataNodeAny;
+    friend DataNodeRef;
+    friend impl::binding_core;
+    friend ColumnExtractor;
+    friend DataDiff;
+    friend DataStreamParser;
+    friend FrozenTree;
+    friend TreeEditBatch;
     friend Set<DataNode>;
     friend DataNodeTerm;
     friend Iterator<DataNode, IterationType::Dfs>;
     friend Iterator<DataNode, IterationType::Sibling>;
     friend Iterator<Meta, IterationType::Meta>;
+    friend Meta;
+    friend MetaCollection;
     friend SetIterator<DataNode>;
     friend LIBYANG_CPP_EXPORT DataNode wrapRawNode(lyd_node* node, std::shared_ptr<void> customContext);
     friend LIBYANG_CPP_EXPORT const DataNode wrapUnmanagedRawNode(const lyd_node* node);
@@ -146,7 +474,9 @@ public:
     friend LIBYANG_CPP_EXPORT lyd_node* getRawNode(DataNode node);
 
     friend LIBYANG_CPP_EXPORT void validateAll(std::optional<libyang::DataNode>& node, const std::optional<ValidationOptions>& opts);
+    friend LIBYANG_CPP_EXPORT void validateIncremental(std::optional<libyang::DataNode>& node, const std::optional<ValidationOptions>& opts);
     friend LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(const std::optional<libyang::DataNode>& contextNode, const libyang::DataNode& forest, const std::string& xpath);
+    friend LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(const std::optional<libyang::DataNode>& contextNode, const libyang::DataNode& forest, const CheckedXPath& xpath);
 
     bool operator==(const DataNode& node) const;
 
@@ -162,37 +492,130 @@ private:
     DataNode(lyd_node* node, std::shared_ptr<internal_refcount> viewCount);
     DataNode(lyd_node* node, const unmanaged_tag);
 
-    [[nodiscard]] std::vector<DataNode*> gatherReachableFollowingSiblings();
     void registerRef();
     void unregisterRef();
     void freeIfNoRefs();
+    void throwIfFrozen(const char* where) const;
+    void recordChange() const;
 
     template <typename Operation, typename Siblings>
     friend void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Siblings siblings, std::shared_ptr<internal_refcount> newRefs);
+    template <typename T>
+    friend class impl::registry;
 
     std::shared_ptr<internal_refcount> m_refs;
+    impl::registry_hook<DataNode> m_refsHook;
+};
+
+/**
+ * @brief A batch of tree edits which defers the memory management bookkeeping until the batch is committed.
+ *
+ * Each of DataNode::unlink, DataNode::insertChild, DataNode::insertSibling etc. normally has to walk through all
+ * wrappers of the affected trees, update their refcounters, invalidate the affected Set and Collection instances, and
+ * free trees which are no longer reachable. Inside a batch, these operations only do the actual edit, and all of the
+ * bookkeeping is done just once by commit(), or when the batch is destroyed.
+ *
+ * Until the batch is committed, nothing is freed, and Set and Collection instances of the involved trees are not
+ * invalidated. Once it is committed, all of them are invalidated.
+ *
+ * Returned by DataNode::beginBatch.
+ */
+class LIBYANG_CPP_EXPORT TreeEditBatch {
+public:
+    ~TreeEditBatch();
+    TreeEditBatch(TreeEditBatch&&) noexcept;
+    TreeEditBatch(const TreeEditBatch&) = delete;
+    TreeEditBatch& operator=(const TreeEditBatch&) = delete;
+    TreeEditBatch& operator=(TreeEditBatch&&) = delete;
+
+    void commit();
+
+private:
+    friend DataNode;
+    explicit TreeEditBatch(const std::shared_ptr<internal_refcount>& refs);
+
+    std::unique_ptr<impl::batch_state> m_state;
+};
+
+/**
+ * @brief A handle to a tree which can be read by several threads at once.
+ *
+ * Normally, even reading a tree is not thread-safe, because creating and destroying a DataNode, a Set or a Collection
+ * updates bookkeeping which is shared by the whole tree. As long as a FrozenTree handle exists, these updates are
+ * serialized, lazily computed values are already in place, and all operations which would modify the tree throw.
+ * That makes it safe to read the tree from several threads, as long as each Set, Collection and iterator is used by
+ * a single thread only.
+ *
+ * The tree becomes mutable again once all copies of the handle are destroyed. All threads must have stopped using the
+ * tree by then. Returned by DataNode::freeze.
+ */
+class LIBYANG_CPP_EXPORT FrozenTree {
+public:
+    DataNode root() const;
+
+    void parallelForEachChild(const DataNode& parent, const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads = 0) const;
+    void parallelDfs(const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads = 0) const;
+
+private:
+    friend DataNode;
+    explicit FrozenTree(std::shared_ptr<impl::frozen_state> state);
+    void run(const std::vector<std::pair<lyd_node*, bool>>& tasks, const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads) const;
+
+    std::shared_ptr<impl::frozen_state> m_state;
+};
+
+/**
+ * @brief One change within a DataDiff.
+ */
+struct LIBYANG_CPP_EXPORT DiffChange {
+    /** @brief The node within the diff tree. For created and deleted nodes, this is the root of the whole subtree. */
+    DataNode node;
+    DiffOperation operation;
+};
+
+/**
+ * @brief Differences between two data trees, as computed by DataNode::diffSiblings or DataNode::diffTree.
+ *
+ * The diff is itself a data tree (see tree()), where the nodes are annotated with `yang:operation` and related metadata
+ * as described by libyang.
+ */
+class LIBYANG_CPP_EXPORT DataDiff {
+public:
+    bool empty() const;
+    std::optional<DataNode> tree() const;
+    std::vector<DiffChange> changes() const;
+    void forEachChange(const std::function<void(const DataNodeRef& node, const DiffOperation operation)>& callback) const;
+    void apply(std::optional<DataNode>& data) const;
+
+private:
+    friend DataNode;
+    explicit DataDiff(std::optional<DataNode> diff);
+
+    std::optional<DataNode> m_diff;
 };
 
 /**
  * @brief Represents a piece of metadata associated with a node.
  *
- * Represents a `lyd_meta` struct (but does not wrap it).
+ * A view of a `lyd_meta` struct, its contents are only read when accessed. The Meta keeps the data tree alive, but the
+ * metadata itself must not be removed (e.g., via MetaCollection::erase) while the Meta is in use.
  */
 class LIBYANG_CPP_EXPORT Meta {
 public:
     std::string name() const;
+    std::string_view nameView() const;
     std::string valueStr() const;
+    std::string_view valueView() const;
     Module module() const;
     bool isInternal() const;
 
 private:
+    friend DataNode;
     friend Iterator<Meta, IterationType::Meta>;
-    Meta(lyd_meta* meta, std::shared_ptr<ly_ctx> ctx);
+    Meta(lyd_meta* meta, DataNode node);
 
-    std::string m_name;
-    std::string m_value;
-    Module m_mod;
-    bool m_isInternal;
+    lyd_meta* m_meta;
+    DataNode m_node;
 };
 
 
@@ -210,7 +633,14 @@ public:
 
     friend DataNode;
     Value value() const;
+    ValueView valueView() const;
+    template <typename T>
+    T valueAs() const;
+    template <typename T>
+    std::optional<T> tryValueAs() const;
     types::Type valueType() const;
+    bool valueEquals(const DataNodeTerm& other) const;
+    std::size_t valueHash() const;
 
     /** @brief Was the value changed? */
     enum class ValueChange {
@@ -219,9 +649,14 @@ public:
         EqualValueNotChanged, /**< No change, the previous value is the same as the new one, and it isn't an implicit default */
     };
     ValueChange changeValue(const std::string value);
+    ValueChange changeValue(const char* value);
+    ValueChange changeValue(const Value& value);
+
+    friend DataNodeRef;
 
 private:
     using DataNode::DataNode;
+    static ValueView valueViewOf(const lyd_node* node);
 };
 
 /**
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <libyang-cpp/DataNode.hpp>
+#include <libyang-cpp/Enum.hpp>
+#include <libyang-cpp/export.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct ly_ctx;
+
+namespace libyang {
+class Context;
+
+/**
+ * @brief Where the records of a streamed data document are, see Context::parseDataStream().
+ *
+ * JSON members are matched by their name as it appears in the document, XML elements by their local name.
+ */
+struct LIBYANG_CPP_EXPORT DataStreamRecordPath {
+    /** @brief Members or elements around the data which are not data nodes themselves, e.g., `{"data"}` for a NETCONF `<data>`. These are dropped. */
+    std::vector<std::string> wrappers;
+    /** @brief The data nodes which enclose the records, from the top, e.g., `{"ietf-interfaces:interfaces"}`. These are re-emitted around each record. */
+    std::vector<std::string> parents;
+};
+
+/**
+ * @brief Parses a data document which arrives in chunks, and hands out each record as soon as it is complete.
+ *
+ * Use Context::parseDataStream() to create one. See there for what a record is.
+ */
+class LIBYANG_CPP_EXPORT DataStreamParser {
+public:
+    void feed(std::span<const std::byte> chunk);
+    void feed(std::string_view chunk);
+    void finish();
+
+private:
+    friend Context;
+    DataStreamParser(std::shared_ptr<ly_ctx> ctx, const DataFormat format, std::function<void(DataNode)> callback, const std::optional<ParseOptions> opts, DataStreamRecordPath recordPath);
+
+    void scanJson();
+    void scanXml();
+    void emit(const std::string& record);
+    void compact(const std::size_t keep);
+    bool entersRecordParent(std::string_view name) const;
+    void enterRecordParent(std::string opening, std::string closing);
+    void leaveRecordParent();
+    std::string wrapRecord(const std::string& record) const;
+    std::string holdJsonMember(std::string member, std::string name);
+    std::string takeHeldJsonMember();
+
+    enum class JsonState {
+        Start,
+        ExpectKey,
+        InKey,
+        ExpectColon,
+        ExpectValue,
+        ExpectElement,
+        InValue,
+        AfterElement,
+        AfterMember,
+        End,
+    };
+
+    std::shared_ptr<ly_ctx> m_ctx;
+    DataFormat m_format;
+    std::function<void(DataNode)> m_callback;
+    std::optional<ParseOptions> m_opts;
+    DataStreamRecordPath m_recordPath;
+
+    /** @brief How many of the wrappers and parents of the records enclose the current position. */
+    std::size_t m_level = 0;
+    /** @brief The opening and the closing text of each parent which encloses the current position. */
+    std::vector<std::pair<std::string, std::string>> m_openParents;
+
+    /** @brief Input which was not consumed yet. */
+    std::string m_pending;
+    /** @brief How far `m_pending` was scanned. */
+    std::size_t m_pos = 0;
+    /** @brief Where the record (or the JSON key) which is being scanned starts within `m_pending`. */
+    std::size_t m_start = 0;
+
+    JsonState m_jsonState = JsonState::Start;
+    std::string m_jsonKey;
+    bool m_inArray = false;
+    bool m_firstElement = false;
+    /** @brief A member which is complete, but whose metadata (or whose data, if it is the metadata) might still follow. */
+    std::string m_heldMember;
+    std::string m_heldName;
+    bool m_inString = false;
+    bool m_escape = false;
+    std::size_t m_depth = 0;
+};
+}
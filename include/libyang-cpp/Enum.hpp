@@ -43,7 +43,17 @@ enum class SchemaFormat {
 enum class DataFormat {
     Detect = 0,
     XML,
-    JSON
+    JSON,
+    LYB,
+};
+
+/**
+ * @brief Compression of data files, see DataFileOptions.
+ */
+enum class Compression {
+    None,
+    Gzip,
+    Zstd,
 };
 
 /**
@@ -138,6 +148,17 @@ enum class DuplicationOptions : uint32_t {
     WithPriv    = 0x20,
 };
 
+/**
+ * Wraps LYS_GETNEXT_* flags. Supports operator|.
+ */
+enum class GetNextOptions : uint32_t {
+    WithChoice               = 0x01,
+    NoChoice                 = 0x02,
+    WithCase                 = 0x04,
+    IntoNonPresenceContainer = 0x08,
+    Output                   = 0x10,
+};
+
 enum class NodeType : uint16_t {
     Unknown      = 0x0000,
     Container    = 0x0001,
@@ -298,6 +319,36 @@ enum class DataCompare : uint32_t {
     OpaqueAsData = 0x04, /**< LYD_COMPARE_OPAQ */
 };
 
+/**
+ * @brief Wraps LYD_DIFF_* flags. Supports operator|.
+ */
+enum class DiffOptions : uint16_t {
+    NoOptions = 0x00, /**< Equivalent of a raw C 0 to say "no flags given" in a typesafe manner */
+    Defaults = 0x01, /**< LYD_DIFF_DEFAULTS */
+};
+
+/**
+ * @brief The value of the `yang:operation` metadata of a node within a diff.
+ */
+enum class DiffOperation {
+    None, /**< The node is only there because a descendant has changed */
+    Create,
+    Delete,
+    Replace, /**< The value has changed, or a user-ordered node has moved */
+};
+
+/**
+ * @brief The operations which are measured by Context::stats().
+ */
+enum class StatsOperation {
+    ParseData, /**< Context::parseData(), Context::parseExtData() */
+    ParseOp, /**< Context::parseOp(), DataNode::parseOp() */
+    Validate, /**< validateAll(), validateIncremental() */
+    Print, /**< DataNode::printStr(), DataNode::print() */
+    NewPath, /**< newPath(), newPath2(), newPaths(), newExtPath() of both Context and DataNode */
+    FindXPath, /**< DataNode::findXPath(), findXPathAt() */
+};
+
 template <typename Enum>
 constexpr Enum implEnumBitOr(const Enum a, const Enum b)
 {
@@ -325,6 +376,11 @@ constexpr DuplicationOptions operator|(const DuplicationOptions a, const Duplica
     return implEnumBitOr(a, b);
 }
 
+constexpr GetNextOptions operator|(const GetNextOptions a, const GetNextOptions b)
+{
+    return implEnumBitOr(a, b);
+}
+
 constexpr LogOptions operator|(const LogOptions a, const LogOptions b)
 {
     return implEnumBitOr(a, b);
@@ -350,6 +406,11 @@ constexpr DataCompare operator|(const DataCompare a, const DataCompare b)
     return implEnumBitOr(a, b);
 }
 
+constexpr DiffOptions operator|(const DiffOptions a, const DiffOptions b)
+{
+    return implEnumBitOr(a, b);
+}
+
 LIBYANG_CPP_EXPORT std::ostream& operator<<(std::ostream& os, const NodeType& type);
 LIBYANG_CPP_EXPORT std::ostream& operator<<(std::ostream& os, const ErrorCode& err);
 LIBYANG_CPP_EXPORT std::ostream& operator<<(std::ostream& os, const ValidationErrorCode& err);
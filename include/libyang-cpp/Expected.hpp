@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <libyang-cpp/Enum.hpp>
+#include <libyang-cpp/export.h>
+#include <utility>
+#include <variant>
+
+namespace libyang {
+namespace impl {
+[[noreturn]] LIBYANG_CPP_EXPORT void throwExpectedError(const ErrorCode code);
+}
+
+/**
+ * @brief Either the result of an operation, or the ErrorCode which it failed with.
+ *
+ * This is what the non-throwing `try*` variants of functions return, e.g., Context::tryParseData(). It mimics a subset
+ * of C++23's `std::expected<T, ErrorCode>`.
+ */
+template <typename T>
+class Expected {
+public:
+    Expected(T value)
+        : m_value(std::in_place_index<0>, std::move(value))
+    {
+    }
+
+    Expected(const ErrorCode error)
+        : m_value(std::in_place_index<1>, error)
+    {
+    }
+
+    bool has_value() const noexcept
+    {
+        return m_value.index() == 0;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    /** @brief Returns the result, throws an ErrorWithCode if the operation has failed. */
+    T& value() &
+    {
+        throwIfError();
+        return std::get<0>(m_value);
+    }
+
+    const T& value() const&
+    {
+        throwIfError();
+        return std::get<0>(m_value);
+    }
+
+    T&& value() &&
+    {
+        throwIfError();
+        return std::get<0>(std::move(m_value));
+    }
+
+    T& operator*() & noexcept
+    {
+        return *std::get_if<0>(&m_value);
+    }
+
+    const T& operator*() const& noexcept
+    {
+        return *std::get_if<0>(&m_value);
+    }
+
+    T&& operator*() && noexcept
+    {
+        return std::move(*std::get_if<0>(&m_value));
+    }
+
+    T* operator->() noexcept
+    {
+        return std::get_if<0>(&m_value);
+    }
+
+    const T* operator->() const noexcept
+    {
+        return std::get_if<0>(&m_value);
+    }
+
+    /** @brief Returns the error code, or ErrorCode::Success if the operation has succeeded. */
+    ErrorCode error() const noexcept
+    {
+        return has_value() ? ErrorCode::Success : std::get<1>(m_value);
+    }
+
+private:
+    void throwIfError() const
+    {
+        if (!has_value()) {
+            impl::throwExpectedError(std::get<1>(m_value));
+        }
+    }
+
+    std::variant<T, ErrorCode> m_value;
+};
+}
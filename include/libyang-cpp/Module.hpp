@@ -89,7 +89,7 @@ public:
     std::vector<Identity> identities() const;
 
     std::optional<SchemaNode> child() const;
-    ChildInstanstiables childInstantiables() const;
+    ChildInstanstiables childInstantiables(const std::optional<GetNextOptions> options = std::nullopt) const;
     libyang::Collection<SchemaNode, IterationType::Dfs> childrenDfs() const;
     Collection<SchemaNode, IterationType::Sibling> immediateChildren() const;
     std::vector<SchemaNode> actionRpcs() const;
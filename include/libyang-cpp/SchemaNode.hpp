@@ -12,6 +12,7 @@
 #include <libyang-cpp/export.h>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 struct lysc_node;
@@ -24,13 +25,16 @@ class ActionRpcInput;
 class ActionRpcOutput;
 class Case;
 class Choice;
+class ColumnExtractor;
 class Container;
 class Leaf;
 class LeafList;
 class List;
 class Context;
 class DataNode;
+class DataNodeRef;
 class SchemaNode;
+class SchemaNodeView;
 class ChildInstanstiables;
 class ChildInstanstiablesIterator;
 class Module;
@@ -43,6 +47,11 @@ template <typename NodeType, IterationType ITER_TYPE>
 class Collection;
 template <typename NodeType, IterationType ITER_TYPE>
 class Iterator;
+template <IterationType ITER_TYPE>
+class SchemaNodeViewIterator;
+namespace impl {
+class binding_core;
+}
 
 /**
  * @brief Class representing a schema definition of a node.
@@ -53,7 +62,9 @@ class LIBYANG_CPP_EXPORT SchemaNode {
 public:
     Module module() const;
     std::string path() const;
+    std::string_view pathView() const;
     std::string name() const;
+    std::string_view nameView() const;
     std::optional<std::string> description() const;
     Status status() const;
     Config config() const;
@@ -74,7 +85,7 @@ public:
 
     std::optional<SchemaNode> child() const;
     std::optional<SchemaNode> parent() const;
-    ChildInstanstiables childInstantiables() const;
+    ChildInstanstiables childInstantiables(const std::optional<GetNextOptions> options = std::nullopt) const;
     Collection<SchemaNode, IterationType::Dfs> childrenDfs() const;
     Collection<SchemaNode, IterationType::Sibling> siblings() const;
     Collection<SchemaNode, IterationType::Sibling> immediateChildren() const;
@@ -84,15 +95,24 @@ public:
 
     std::string printStr(const SchemaOutputFormat format, const std::optional<SchemaPrintFlags> flags = std::nullopt, std::optional<size_t> lineLength = std::nullopt) const;
 
+    SchemaNodeView view() const&;
+    // The view borrows the context from this object, so don't allow creating one from a temporary
+    SchemaNodeView view() const&& = delete;
+
     friend Context;
     friend DataNode;
+    friend DataNodeRef;
+    friend impl::binding_core;
+    friend ColumnExtractor;
     friend List;
     friend Module;
+    friend ChildInstanstiables;
     friend ChildInstanstiablesIterator;
     friend Iterator<SchemaNode, IterationType::Dfs>;
     friend Iterator<SchemaNode, IterationType::Sibling>;
     friend Set<SchemaNode>;
     friend SetIterator<SchemaNode>;
+    friend SchemaNodeView;
 
     bool operator==(const SchemaNode& other) const;
     bool operator!=(const SchemaNode& other) const;
@@ -104,6 +124,38 @@ protected:
     SchemaNode(const lysc_node* node, std::nullptr_t);
 };
 
+/**
+ * @brief A borrowed reference to a schema node, obtained from a SchemaNode or by iterating over Collection::views.
+ *
+ * Unlike a SchemaNode, this does not keep the context alive, so creating and copying it is just a copy of two pointers
+ * and it never touches any reference counts. The price is that it is only valid as long as the object which it was
+ * obtained from exists, and as long as the schema does not change. Use node() for getting a full SchemaNode.
+ */
+class LIBYANG_CPP_EXPORT SchemaNodeView {
+public:
+    std::string_view name() const;
+    std::string_view moduleName() const;
+    std::string_view pathView() const;
+    NodeType nodeType() const;
+    std::optional<SchemaNodeView> child() const;
+    std::optional<SchemaNodeView> parent() const;
+    std::optional<SchemaNodeView> nextSibling() const;
+    SchemaNode node() const;
+
+    bool operator==(const SchemaNodeView& other) const;
+
+    friend SchemaNode;
+    friend ChildInstanstiables;
+    template <IterationType ITER_TYPE>
+    friend class SchemaNodeViewIterator;
+
+private:
+    SchemaNodeView(const lysc_node* node, const std::shared_ptr<ly_ctx>* ctx);
+
+    const lysc_node* m_node;
+    const std::shared_ptr<ly_ctx>* m_ctx;
+};
+
 /**
  * @brief Contains information about a when statement.
  *
@@ -10,8 +10,10 @@
 #include <libyang-cpp/SchemaNode.hpp>
 #include <libyang-cpp/Utils.hpp>
 #include <libyang-cpp/export.h>
+#include <compare>
+#include <cstddef>
+#include <iterator>
 #include <memory>
-#include <set>
 #include <vector>
 
 struct ly_set;
@@ -19,6 +21,7 @@ struct ly_ctx;
 struct lyd_node;
 
 namespace libyang {
+class ColumnExtractor;
 class Context;
 template <typename NodeType>
 class Set;
@@ -31,21 +34,38 @@ struct internal_refcount;
 template <typename NodeType>
 class LIBYANG_CPP_EXPORT SetIterator {
 public:
-    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
     using value_type = NodeType;
-    using reference = void;
-    using difference_type = SetIterator;
+    using reference = NodeType;
+    using difference_type = std::ptrdiff_t;
 
+    SetIterator();
     ~SetIterator();
+    SetIterator(const SetIterator& other);
+    SetIterator(SetIterator&& other) noexcept;
+    SetIterator& operator=(const SetIterator& other);
+    SetIterator& operator=(SetIterator&& other) noexcept;
     friend Set<NodeType>;
+    template <typename T>
+    friend class impl::registry;
     NodeType operator*() const;
     SetIterator& operator++();
     SetIterator operator++(int);
     SetIterator& operator--();
     SetIterator operator--(int);
-    SetIterator operator-(int) const;
-    SetIterator operator+(int) const;
+    SetIterator& operator+=(difference_type n);
+    SetIterator& operator-=(difference_type n);
+    SetIterator operator-(difference_type n) const;
+    SetIterator operator+(difference_type n) const;
+    difference_type operator-(const SetIterator& other) const;
+    NodeType operator[](difference_type n) const;
     bool operator==(const SetIterator&) const;
+    std::strong_ordering operator<=>(const SetIterator&) const;
+
+    friend SetIterator operator+(difference_type n, const SetIterator& it)
+    {
+        return it + n;
+    }
 
     struct NodeProxy {
         NodeType node;
@@ -62,8 +82,9 @@ private:
     SetIterator(underlying_node_t<NodeType>*const * start, underlying_node_t<NodeType>*const * end, const Set<NodeType>* set);
     underlying_node_t<NodeType>* const* m_start;
     underlying_node_t<NodeType>* const* m_current;
-    underlying_node_t<NodeType>* const* const m_end;
+    underlying_node_t<NodeType>* const* m_end;
     const Set<NodeType>* m_set;
+    impl::registry_hook<SetIterator> m_refsHook;
 };
 
 /**
@@ -73,10 +94,17 @@ template <typename NodeType>
 class LIBYANG_CPP_EXPORT Set {
 public:
     ~Set();
+    Set(const Set& other);
+    Set(Set&& other) noexcept;
+    Set& operator=(const Set& other);
+    Set& operator=(Set&& other) noexcept;
     SetIterator<NodeType> begin() const;
     SetIterator<NodeType> end() const;
     NodeType front() const;
     NodeType back() const;
+    NodeType operator[](std::size_t index) const;
+    NodeType at(std::size_t index) const;
+    std::vector<NodeType> toVector() const;
     uint32_t size() const;
     bool empty() const;
 
@@ -85,16 +113,25 @@ private:
     friend NodeType;
     friend SetIterator<NodeType>;
     friend Context;
+    friend ColumnExtractor;
     friend LIBYANG_CPP_EXPORT Set<DataNode> findXPathAt(const std::optional<libyang::DataNode>& contextNode, const libyang::DataNode& forest, const std::string& xpath);
 
     template <typename Operation, typename Siblings>
     friend void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Siblings siblings, std::shared_ptr<internal_refcount> newRefs);
+    friend TreeEditBatch;
+    template <typename T>
+    friend class impl::registry;
     void invalidate();
     void throwIfInvalid() const;
+    NodeType nodeAt(std::size_t index) const;
+    void registerThis();
+    void unregisterThis();
+    void takeOverFrom(Set& other) noexcept;
 
-    mutable std::set<SetIterator<NodeType>*> m_iterators;
+    mutable impl::registry<SetIterator<NodeType>> m_iterators;
     std::shared_ptr<ly_set> m_set;
     impl::refs_type_t<NodeType> m_refs;
     bool m_valid = true;
+    impl::registry_hook<Set> m_refsHook;
 };
 }
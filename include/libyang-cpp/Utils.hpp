@@ -9,6 +9,8 @@
 #include <libyang-cpp/DataNode.hpp>
 #include <libyang-cpp/Enum.hpp>
 #include <libyang-cpp/export.h>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 
@@ -21,6 +23,55 @@ namespace libyang {
 LIBYANG_CPP_EXPORT LogOptions setLogOptions(const libyang::LogOptions options);
 LIBYANG_CPP_EXPORT LogLevel setLogLevel(const LogLevel level);
 
+/**
+ * @brief Changes the global libyang log level for the lifetime of this object.
+ */
+class LIBYANG_CPP_EXPORT ScopedLogLevel {
+public:
+    explicit ScopedLogLevel(const LogLevel level);
+    ~ScopedLogLevel();
+    ScopedLogLevel(const ScopedLogLevel&) = delete;
+    ScopedLogLevel& operator=(const ScopedLogLevel&) = delete;
+
+private:
+    LogLevel m_previous;
+};
+
+/**
+ * @brief Changes the libyang log options of the calling thread for the lifetime of this object.
+ */
+class LIBYANG_CPP_EXPORT ScopedLogOptions {
+public:
+    explicit ScopedLogOptions(const LogOptions options);
+    ~ScopedLogOptions();
+    ScopedLogOptions(const ScopedLogOptions&) = delete;
+    ScopedLogOptions& operator=(const ScopedLogOptions&) = delete;
+
+private:
+    uint32_t m_options;
+    uint32_t* m_previous;
+};
+
+namespace impl {
+struct arena_state;
+}
+
+/**
+ * @brief Makes the bookkeeping of the wrappers created on this thread come from one arena during the lifetime of this
+ * object.
+ */
+class LIBYANG_CPP_EXPORT ScopedArena {
+public:
+    explicit ScopedArena(const std::size_t initialSize = 64 * 1024);
+    ~ScopedArena();
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+private:
+    std::shared_ptr<impl::arena_state> m_arena;
+    impl::arena_state* m_previous;
+};
+
 /**
  * @brief A generic libyang error. All other libyang errors inherit from this exception type.
  */
@@ -113,6 +164,17 @@ struct LIBYANG_CPP_EXPORT SomeOrder {
     bool operator()(const Identity& a, const Identity& b) const;
 };
 
+/**
+ * @brief Equality and hashing of terms by their schema node and value, for usage in unordered standard containers.
+ *
+ * For example `std::unordered_set<libyang::DataNodeTerm, TermValueHash, TermValueHash>` holds at most one term with a
+ * given value per schema node, regardless of the tree the term comes from. The terms must come from the same context.
+ */
+struct LIBYANG_CPP_EXPORT TermValueHash {
+    std::size_t operator()(const DataNodeTerm& term) const;
+    bool operator()(const DataNodeTerm& a, const DataNodeTerm& b) const;
+};
+
 /**
  * @brief A string conversion visitor for libyang::Value.
  */
@@ -12,16 +12,22 @@
 #include <cstdint>
 #include <libyang-cpp/Module.hpp>
 #include <libyang-cpp/export.h>
+#include <cstddef>
+#include <iterator>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
 
 struct lysc_ident;
+struct lysc_type_bitenum_item;
 
 namespace libyang {
 class DataNode;
+class DataNodeTerm;
 class Identity;
 
 /**
@@ -259,6 +265,110 @@ using Value = std::variant<
     IdentityRef
 >;
 
+/**
+ * @brief A non-owning view of a value of type `binary`, see ValueView.
+ */
+struct LIBYANG_CPP_EXPORT BinaryView {
+    std::span<const uint8_t> data;
+    std::string_view base64;
+};
+
+/**
+ * @brief A non-owning view of a single bit from a value of type `bits`, see ValueView.
+ */
+struct LIBYANG_CPP_EXPORT BitView {
+    uint32_t position;
+    std::string_view name;
+};
+
+/**
+ * @brief A non-owning view of a value of type `bits`, i.e., of the set bits, see ValueView.
+ */
+class LIBYANG_CPP_EXPORT BitsView {
+public:
+    class LIBYANG_CPP_EXPORT iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = BitView;
+        using reference = BitView;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        BitView operator*() const;
+        iterator& operator++();
+        iterator operator++(int);
+        bool operator==(const iterator& other) const = default;
+
+    private:
+        friend BitsView;
+        explicit iterator(const lysc_type_bitenum_item* const* current);
+        const lysc_type_bitenum_item* const* m_current = nullptr;
+    };
+
+    iterator begin() const;
+    iterator end() const;
+    std::size_t size() const;
+    bool empty() const;
+    BitView operator[](const std::size_t index) const;
+
+private:
+    friend DataNodeTerm;
+    BitsView(const lysc_type_bitenum_item* const* items, const std::size_t count);
+    const lysc_type_bitenum_item* const* m_items;
+    std::size_t m_count;
+};
+
+/**
+ * @brief A non-owning view of a value of type `enumeration`, see ValueView.
+ */
+struct LIBYANG_CPP_EXPORT EnumView {
+    std::string_view name;
+    int32_t value;
+};
+
+/**
+ * @brief A non-owning view of a value of type `identityref`, see ValueView.
+ */
+struct LIBYANG_CPP_EXPORT IdentityRefView {
+    std::string_view module;
+    std::string_view name;
+};
+
+/**
+ * @brief A non-owning view of a value of type `instance-identifier`, see ValueView.
+ *
+ * Unlike InstanceIdentifier, the target node is not looked up.
+ */
+struct LIBYANG_CPP_EXPORT InstanceIdentifierView {
+    std::string_view path;
+};
+
+/**
+ * @brief A non-owning view of a value of DataNodeTerm, see DataNodeTerm::valueView.
+ *
+ * The strings, bytes and bits refer directly to libyang's storage, so building this never allocates. The view is only
+ * valid as long as the node it was obtained from exists and its value is not changed.
+ */
+using ValueView = std::variant<
+    int8_t,
+    int16_t,
+    int32_t,
+    int64_t,
+    uint8_t,
+    uint16_t,
+    uint32_t,
+    uint64_t,
+    bool,
+    Empty,
+    BinaryView,
+    std::string_view,
+    InstanceIdentifierView,
+    Decimal64,
+    BitsView,
+    EnumView,
+    IdentityRefView
+>;
+
 /**
  * @brief A JSON value of an anydata node.
  */
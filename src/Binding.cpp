@@ -0,0 +1,533 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <libyang-cpp/Binding.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <limits>
+#include <stdexcept>
+#include "utils/exception.hpp"
+#include "utils/ref_count.hpp"
+
+#ifdef _MSC_VER
+#  define __builtin_unreachable() __assume(0)
+#endif
+
+namespace libyang::impl {
+namespace {
+const lyd_value& termValue(const lyd_node* node)
+{
+    return reinterpret_cast<const lyd_node_term*>(node)->value;
+}
+
+const lysc_type* realType(const lysc_node* node)
+{
+    auto type = node->nodetype == LYS_LEAF ? reinterpret_cast<const lysc_node_leaf*>(node)->type : reinterpret_cast<const lysc_node_leaflist*>(node)->type;
+    if (type->basetype == LY_TYPE_LEAFREF) {
+        type = reinterpret_cast<const lysc_type_leafref*>(type)->realtype;
+    }
+    return type;
+}
+
+/**
+ * @brief Checks that every value of an integral type can be stored in an integer of `width` bytes.
+ *
+ * Types which are not wider than the member always fit. Wider ones only fit when their range restriction does.
+ */
+bool integerFits(const lysc_type* type, const bool isSigned, const std::size_t width)
+{
+    std::size_t typeWidth;
+    switch (type->basetype) {
+    case LY_TYPE_INT8:
+    case LY_TYPE_UINT8:
+        typeWidth = 1;
+        break;
+    case LY_TYPE_INT16:
+    case LY_TYPE_UINT16:
+        typeWidth = 2;
+        break;
+    case LY_TYPE_INT32:
+    case LY_TYPE_UINT32:
+        typeWidth = 4;
+        break;
+    default:
+        typeWidth = 8;
+        break;
+    }
+    if (typeWidth <= width) {
+        return true;
+    }
+
+    auto range = reinterpret_cast<const lysc_type_num*>(type)->range;
+    if (!range || !LY_ARRAY_COUNT(range->parts)) {
+        return false;
+    }
+
+    // The parts are sorted, and the member is narrower than 8 bytes here
+    const auto& lowest = range->parts[0];
+    const auto& highest = range->parts[LY_ARRAY_COUNT(range->parts) - 1];
+    const auto bits = 8 * width;
+    if (isSigned) {
+        const auto limit = int64_t{1} << (bits - 1);
+        return lowest.min_64 >= -limit && highest.max_64 < limit;
+    }
+    return highest.max_u64 < (uint64_t{1} << bits);
+}
+
+bool fits(const binding_kind kind, const std::size_t width, const lysc_type* type)
+{
+    switch (kind) {
+    case binding_kind::String:
+        return true;
+    case binding_kind::Bool:
+        return type->basetype == LY_TYPE_BOOL;
+    case binding_kind::Signed:
+        switch (type->basetype) {
+        case LY_TYPE_INT8:
+        case LY_TYPE_INT16:
+        case LY_TYPE_INT32:
+        case LY_TYPE_INT64:
+            return integerFits(type, true, width);
+        default:
+            return false;
+        }
+    case binding_kind::Unsigned:
+        switch (type->basetype) {
+        case LY_TYPE_UINT8:
+        case LY_TYPE_UINT16:
+        case LY_TYPE_UINT32:
+        case LY_TYPE_UINT64:
+            return integerFits(type, false, width);
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+}
+
+std::string_view binding_term::asString() const
+{
+    return lyd_get_value(node);
+}
+
+bool binding_term::asBool() const
+{
+    return termValue(node).boolean;
+}
+
+int64_t binding_term::asSigned() const
+{
+    const auto& value = termValue(node);
+    switch (value.realtype->basetype) {
+    case LY_TYPE_INT8:
+        return value.int8;
+    case LY_TYPE_INT16:
+        return value.int16;
+    case LY_TYPE_INT32:
+        return value.int32;
+    default:
+        return value.int64;
+    }
+}
+
+uint64_t binding_term::asUnsigned() const
+{
+    const auto& value = termValue(node);
+    switch (value.realtype->basetype) {
+    case LY_TYPE_UINT8:
+        return value.uint8;
+    case LY_TYPE_UINT16:
+        return value.uint16;
+    case LY_TYPE_UINT32:
+        return value.uint32;
+    default:
+        return value.uint64;
+    }
+}
+
+binding_core::binding_core(const SchemaNode& node)
+    : m_ctx(node.m_ctx)
+    , m_node(node.m_node)
+{
+    if (!(m_node->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_NOTIF | LYS_INPUT | LYS_OUTPUT))) {
+        throw Error{"StructBinding: " + node.path() + " is not a container or a list"};
+    }
+}
+
+void binding_core::addField(const std::string& name, const bool leafList, const binding_kind kind, const std::size_t width, Field field)
+{
+    std::string_view moduleName;
+    std::string_view nodeName = name;
+    if (auto colon = nodeName.find(':'); colon != std::string_view::npos) {
+        moduleName = nodeName.substr(0, colon);
+        nodeName = nodeName.substr(colon + 1);
+    }
+
+    const lysc_node* child = nullptr;
+    while ((child = lys_getnext(child, m_node, nullptr, 0))) {
+        if (child->name == nodeName && (moduleName.empty() ? child->module == m_node->module : child->module->name == moduleName)) {
+            break;
+        }
+    }
+
+    if (!child || !(child->nodetype & (LYS_LEAF | LYS_LEAFLIST))) {
+        throw Error{"StructBinding::field: no leaf or leaf-list named '" + name + "'"};
+    }
+    if ((child->nodetype == LYS_LEAFLIST) != leafList) {
+        throw Error{"StructBinding::field: '" + name + (leafList ? "' is not a leaf-list" : "' is a leaf-list, bind it to a std::vector")};
+    }
+    if (!fits(kind, width, realType(child))) {
+        throw Error{"StructBinding::field: the member type does not fit the type of '" + name + "'"};
+    }
+
+    field.schema = child;
+    m_fields.push_back(std::move(field));
+}
+
+void binding_core::decode(const DataNode& node, void* object) const
+{
+    if (node.m_node->schema != m_node) {
+        throw Error{"StructBinding::decode: the binding is for " + SchemaNode{m_node, m_ctx}.path() + ", not for " + node.path()};
+    }
+
+    for (const auto& field : m_fields) {
+        field.reset(object);
+    }
+
+    // The children mostly come in the order of the schema, so most of the lookups hit the field which comes next.
+    std::size_t next = 0;
+    for (auto child = lyd_child(node.m_node); child; child = child->next) {
+        if (!child->schema || !(child->schema->nodetype & (LYS_LEAF | LYS_LEAFLIST))) {
+            continue;
+        }
+        for (std::size_t i = 0; i < m_fields.size(); ++i) {
+            auto index = (next + i) % m_fields.size();
+            if (m_fields[index].schema == child->schema) {
+                m_fields[index].decode(binding_term{child}, object);
+                next = child->schema->nodetype == LYS_LEAFLIST ? index : index + 1;
+                break;
+            }
+        }
+    }
+}
+
+void binding_core::encode(const void* object, DataNode& node) const
+{
+    node.throwIfFrozen("StructBinding::encode");
+    if (node.m_node->schema != m_node) {
+        throw Error{"StructBinding::encode: the binding is for " + SchemaNode{m_node, m_ctx}.path() + ", not for " + node.path()};
+    }
+    node.recordChange();
+
+    std::vector<std::string> values;
+    for (const auto& field : m_fields) {
+        if (lysc_is_key(field.schema)) {
+            // keys identify the list instance, they cannot change
+            continue;
+        }
+        values.clear();
+        field.encode(object, binding_sink{&values});
+
+        lyd_node* existing = nullptr;
+        lyd_find_sibling_val(lyd_child(node.m_node), field.schema, nullptr, 0, &existing);
+
+        if (field.schema->nodetype == LYS_LEAF && existing && !values.empty()) {
+            auto err = lyd_change_term(existing, values.front().c_str());
+            if (err != LY_EEXIST && err != LY_ENOT) {
+                throwIfError(err, "StructBinding::encode: can't change " + std::string{field.schema->name});
+            }
+            continue;
+        }
+
+        // Whatever is left is removed through a wrapper, so that other wrappers of these nodes stay valid.
+        while (existing) {
+            auto next = existing->next && existing->next->schema == field.schema ? existing->next : nullptr;
+            DataNode{existing, node.m_refs}.unlink();
+            existing = next;
+        }
+
+        for (const auto& value : values) {
+            auto err = lyd_new_term(node.m_node, field.schema->module, field.schema->name, value.c_str(), 0, nullptr);
+            throwIfError(err, "StructBinding::encode: can't create " + std::string{field.schema->name});
+        }
+    }
+}
+}
+
+namespace libyang {
+namespace {
+bool isSigned(const LY_DATA_TYPE type)
+{
+    return type == LY_TYPE_INT8 || type == LY_TYPE_INT16 || type == LY_TYPE_INT32 || type == LY_TYPE_INT64;
+}
+
+bool isUnsigned(const LY_DATA_TYPE type)
+{
+    return type == LY_TYPE_UINT8 || type == LY_TYPE_UINT16 || type == LY_TYPE_UINT32 || type == LY_TYPE_UINT64;
+}
+
+/**
+ * @brief Stores one value per row, `read` is only called for the rows which have the leaf.
+ */
+template <typename T, typename Read>
+void fill(const std::span<T> values, const lyd_node* const* cells, const std::size_t stride, const std::size_t rows, const T missing, Read read)
+{
+    for (std::size_t row = 0; row < rows; ++row) {
+        auto node = cells[row * stride];
+        values[row] = node ? read(impl::termValue(node)) : missing;
+    }
+}
+
+/**
+ * @brief Stores the values of an integer column, so that the inner loop does not depend on the type of the leaf.
+ */
+template <typename T>
+void fillIntegers(const std::span<T> values, const lyd_node* const* cells, const std::size_t stride, const std::size_t rows, const T missing, const LY_DATA_TYPE type)
+{
+    switch (type) {
+    case LY_TYPE_INT8:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.int8); });
+        break;
+    case LY_TYPE_INT16:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.int16); });
+        break;
+    case LY_TYPE_INT32:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.int32); });
+        break;
+    case LY_TYPE_INT64:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.int64); });
+        break;
+    case LY_TYPE_UINT8:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.uint8); });
+        break;
+    case LY_TYPE_UINT16:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.uint16); });
+        break;
+    case LY_TYPE_UINT32:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.uint32); });
+        break;
+    case LY_TYPE_UINT64:
+        fill(values, cells, stride, rows, missing, [](const lyd_value& v) { return static_cast<T>(v.uint64); });
+        break;
+    default:
+        // the type was checked when the column was added
+        __builtin_unreachable();
+    }
+}
+}
+
+/**
+ * @brief Creates an extractor for entries of the `list`.
+ */
+ColumnExtractor::ColumnExtractor(const SchemaNode& list)
+    : m_ctx(list.m_ctx)
+    , m_list(list.m_node)
+{
+    if (m_list->nodetype != LYS_LIST) {
+        throw Error{"ColumnExtractor: " + list.path() + " is not a list"};
+    }
+}
+
+/**
+ * @brief Stores the values of `leaf` as signed integers.
+ *
+ * The leaf has to be a descendant of the list which is not nested in another list, and its type has to be a signed
+ * integer, or an unsigned integer of at most 32 bits. Entries without the leaf get a zero. If `present` is not empty,
+ * it records whether each entry has the leaf, and it has to be as long as `values`.
+ */
+ColumnExtractor& ColumnExtractor::column(const SchemaNode& leaf, std::span<int64_t> values, std::span<bool> present)
+{
+    addColumn(leaf, Column{.steps = {}, .baseType = 0, .scale = 1, .values = values, .present = present});
+    return *this;
+}
+
+/**
+ * @brief Stores the values of `leaf`, an unsigned integer, as unsigned integers. Entries without the leaf get a zero.
+ *
+ * See the `int64_t` overload for details.
+ */
+ColumnExtractor& ColumnExtractor::column(const SchemaNode& leaf, std::span<uint64_t> values, std::span<bool> present)
+{
+    addColumn(leaf, Column{.steps = {}, .baseType = 0, .scale = 1, .values = values, .present = present});
+    return *this;
+}
+
+/**
+ * @brief Stores the values of `leaf`, a Decimal64 or an integer, as floating-point numbers.
+ *
+ * Entries without the leaf get a NaN. See the `int64_t` overload for details.
+ */
+ColumnExtractor& ColumnExtractor::column(const SchemaNode& leaf, std::span<double> values, std::span<bool> present)
+{
+    addColumn(leaf, Column{.steps = {}, .baseType = 0, .scale = 1, .values = values, .present = present});
+    return *this;
+}
+
+/**
+ * @brief Stores the canonical values of `leaf`, which can be of any type.
+ *
+ * The views refer to the tree, they are valid until the leaves are changed or freed. Entries without the leaf get an
+ * empty view. See the `int64_t` overload for details.
+ */
+ColumnExtractor& ColumnExtractor::column(const SchemaNode& leaf, std::span<std::string_view> values, std::span<bool> present)
+{
+    addColumn(leaf, Column{.steps = {}, .baseType = 0, .scale = 1, .values = values, .present = present});
+    return *this;
+}
+
+void ColumnExtractor::addColumn(const SchemaNode& leaf, Column column)
+{
+    if (leaf.m_node->nodetype != LYS_LEAF) {
+        throw Error{"ColumnExtractor::column: " + leaf.path() + " is not a leaf"};
+    }
+    for (auto node = leaf.m_node; node != m_list; node = node->parent) {
+        if (!node || (node != leaf.m_node && !(node->nodetype & (LYS_CONTAINER | LYS_CHOICE | LYS_CASE)))) {
+            throw Error{"ColumnExtractor::column: " + leaf.path() + " is not a descendant of " + SchemaNode{m_list, m_ctx}.path() + " outside of any nested list"};
+        }
+        if (!(node->nodetype & (LYS_CHOICE | LYS_CASE))) {
+            column.steps.push_back(node);
+        }
+    }
+    std::reverse(column.steps.begin(), column.steps.end());
+
+    auto type = impl::realType(leaf.m_node);
+    column.baseType = type->basetype;
+    bool fits = std::visit([type = type->basetype]<typename T>(const std::span<T>) {
+        if constexpr (std::is_same_v<T, int64_t>) {
+            return isSigned(type) || (isUnsigned(type) && type != LY_TYPE_UINT64);
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            return isUnsigned(type);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return type == LY_TYPE_DEC64 || isSigned(type) || isUnsigned(type);
+        } else {
+            return true;
+        }
+    }, column.values);
+    if (!fits) {
+        throw Error{"ColumnExtractor::column: the column type does not fit the type of " + leaf.path()};
+    }
+    if (type->basetype == LY_TYPE_DEC64) {
+        column.scale = std::pow(10.0, reinterpret_cast<const lysc_type_dec*>(type)->fraction_digits);
+    }
+
+    auto size = std::visit([](const auto values) { return values.size(); }, column.values);
+    if (!column.present.empty() && column.present.size() != size) {
+        throw std::out_of_range{"ColumnExtractor::column: the presence buffer of " + leaf.path() + " is not as long as the values"};
+    }
+
+    m_columns.push_back(std::move(column));
+}
+
+std::size_t ColumnExtractor::capacity() const
+{
+    std::size_t res = std::numeric_limits<std::size_t>::max();
+    for (const auto& column : m_columns) {
+        res = std::min(res, std::visit([](const auto values) { return values.size(); }, column.values));
+    }
+    return m_columns.empty() ? 0 : res;
+}
+
+void ColumnExtractor::gather(const lyd_node* entry, const std::size_t row) const
+{
+    auto cells = m_cells.data() + row * m_columns.size();
+    for (const auto& column : m_columns) {
+        const lyd_node* node = entry;
+        for (auto step : column.steps) {
+            lyd_node* found = nullptr;
+            lyd_find_sibling_val(lyd_child(node), step, nullptr, 0, &found);
+            node = found;
+            if (!node) {
+                break;
+            }
+        }
+        *cells++ = node;
+    }
+}
+
+void ColumnExtractor::convert(const std::size_t rows) const
+{
+    const auto stride = m_columns.size();
+    for (std::size_t i = 0; i < m_columns.size(); ++i) {
+        const auto& column = m_columns[i];
+        const auto cells = m_cells.data() + i;
+        const auto type = static_cast<LY_DATA_TYPE>(column.baseType);
+
+        for (std::size_t row = 0; row < std::min(rows, column.present.size()); ++row) {
+            column.present[row] = cells[row * stride] != nullptr;
+        }
+
+        std::visit([&]<typename T>(const std::span<T> values) {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                fill(values, cells, stride, rows, std::string_view{}, [ctx = m_ctx.get()](const lyd_value& v) {
+                    return std::string_view{lyd_value_get_canonical(ctx, &v)};
+                });
+            } else if constexpr (std::is_same_v<T, double>) {
+                if (type == LY_TYPE_DEC64) {
+                    fill(values, cells, stride, rows, std::numeric_limits<double>::quiet_NaN(), [scale = column.scale](const lyd_value& v) {
+                        return static_cast<double>(v.dec64) / scale;
+                    });
+                } else {
+                    fillIntegers(values, cells, stride, rows, std::numeric_limits<double>::quiet_NaN(), type);
+                }
+            } else {
+                fillIntegers(values, cells, stride, rows, T{0}, type);
+            }
+        }, column.values);
+    }
+}
+
+/**
+ * @brief Extracts `entry` and the entries of the same list which follow it, one row per entry.
+ *
+ * Pass the first entry of the list to extract all of them.
+ *
+ * @return The number of the entries. Only as many entries as fit into the shortest buffer are stored; call again
+ * with larger buffers if the result is larger than that.
+ */
+std::size_t ColumnExtractor::extract(const DataNode& entry) const
+{
+    if (entry.m_node->schema != m_list) {
+        throw Error{"ColumnExtractor::extract: the extractor is for " + SchemaNode{m_list, m_ctx}.path() + ", not for " + entry.path()};
+    }
+
+    const auto rows = capacity();
+    m_cells.resize(rows * m_columns.size());
+    std::size_t count = 0;
+    for (auto node = entry.m_node; node && node->schema == m_list; node = node->next) {
+        if (count < rows) {
+            gather(node, count);
+        }
+        ++count;
+    }
+    convert(std::min(count, rows));
+    return count;
+}
+
+/**
+ * @brief Extracts the `entries`, one row per entry, in the order of the set.
+ *
+ * @return The number of the entries. Only as many entries as fit into the shortest buffer are stored.
+ */
+std::size_t ColumnExtractor::extract(const Set<DataNode>& entries) const
+{
+    entries.throwIfInvalid();
+    const auto count = entries.m_set->count;
+    const auto rows = std::min<std::size_t>(count, capacity());
+    m_cells.resize(rows * m_columns.size());
+    for (std::size_t row = 0; row < rows; ++row) {
+        auto node = entries.m_set->dnodes[row];
+        if (node->schema != m_list) {
+            throw Error{"ColumnExtractor::extract: the extractor is for " + SchemaNode{m_list, m_ctx}.path() + ", not for " + DataNode{node, entries.m_refs}.path()};
+        }
+        gather(node, row);
+    }
+    convert(rows);
+    return count;
+}
+}
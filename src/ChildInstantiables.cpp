@@ -9,34 +9,41 @@
 #include <libyang-cpp/ChildInstantiables.hpp>
 #include <libyang-cpp/DataNode.hpp> // IWYU pragma: keep
 #include <libyang/libyang.h>
+#include <mutex>
 #include <stdexcept>
+#include "utils/context.hpp"
 
 namespace libyang {
-ChildInstanstiablesIterator::ChildInstanstiablesIterator(const lysc_node* parent, const lysc_module* module, const ChildInstanstiables* childInstantiables)
-    : m_childInstantiables(childInstantiables)
-    , m_parent(parent)
-    , m_module(module)
-    , m_current(nullptr)
+namespace {
+std::shared_ptr<const std::vector<const lysc_node*>> collectChildren(const lysc_node* parent, const lysc_module* module, const uint32_t options)
 {
-    operator++();
+    auto res = std::make_shared<std::vector<const lysc_node*>>();
+    for (auto child = lys_getnext(nullptr, parent, module, options); child; child = lys_getnext(child, parent, module, options)) {
+        res->emplace_back(child);
+    }
+    res->shrink_to_fit();
+    return res;
+}
 }
 
 /**
- * @brief Creates an iterator that acts as the `end` iterator.
+ * @brief Creates an iterator which does not point into any collection. It can only be assigned to.
  */
-ChildInstanstiablesIterator::ChildInstanstiablesIterator(const std::nullptr_t, const ChildInstanstiables* childInstantiables)
-    : m_childInstantiables(childInstantiables)
-    , m_parent(nullptr)
-    , m_module(nullptr)
+ChildInstanstiablesIterator::ChildInstanstiablesIterator()
+    : m_childInstantiables(nullptr)
     , m_current(nullptr)
 {
 }
 
+ChildInstanstiablesIterator::ChildInstanstiablesIterator(const lysc_node* const* current, const ChildInstanstiables* childInstantiables)
+    : m_childInstantiables(childInstantiables)
+    , m_current(current)
+{
+}
+
 ChildInstanstiablesIterator& ChildInstanstiablesIterator::operator++()
 {
-    // TODO: allow options also by asking for them on creation of the ChildInstanstiables class and saving them there
-    m_current = lys_getnext(m_current, m_parent, m_module, 0);
-    return *this;
+    return *this += 1;
 }
 
 ChildInstanstiablesIterator ChildInstanstiablesIterator::operator++(int)
@@ -46,20 +53,73 @@ ChildInstanstiablesIterator ChildInstanstiablesIterator::operator++(int)
     return copy;
 }
 
+ChildInstanstiablesIterator& ChildInstanstiablesIterator::operator--()
+{
+    return *this -= 1;
+}
+
+ChildInstanstiablesIterator ChildInstanstiablesIterator::operator--(int)
+{
+    auto copy = *this;
+    operator--();
+    return copy;
+}
+
+ChildInstanstiablesIterator& ChildInstanstiablesIterator::operator+=(const difference_type n)
+{
+    const auto& children = *m_childInstantiables->m_children;
+    auto position = (m_current - children.data()) + n;
+    if (position < 0) {
+        throw std::out_of_range("Cannot go past the beginning");
+    }
+    if (position > static_cast<difference_type>(children.size())) {
+        throw std::out_of_range("Cannot go past the end");
+    }
+
+    m_current = children.data() + position;
+    return *this;
+}
+
+ChildInstanstiablesIterator& ChildInstanstiablesIterator::operator-=(const difference_type n)
+{
+    return *this += -n;
+}
+
+ChildInstanstiablesIterator ChildInstanstiablesIterator::operator+(const difference_type n) const
+{
+    auto copy = *this;
+    copy += n;
+    return copy;
+}
+
+ChildInstanstiablesIterator ChildInstanstiablesIterator::operator-(const difference_type n) const
+{
+    auto copy = *this;
+    copy -= n;
+    return copy;
+}
+
+ChildInstanstiablesIterator::difference_type ChildInstanstiablesIterator::operator-(const ChildInstanstiablesIterator& other) const
+{
+    return m_current - other.m_current;
+}
+
+SchemaNode ChildInstanstiablesIterator::operator[](const difference_type n) const
+{
+    return *(*this + n);
+}
+
 SchemaNode ChildInstanstiablesIterator::operator*() const
 {
-    if (!m_current) {
+    if (m_current == m_childInstantiables->m_children->data() + m_childInstantiables->m_children->size()) {
         throw std::out_of_range("Derefenced .end iterator");
     }
-    return SchemaNode{m_current, m_childInstantiables->m_ctx};
+    return SchemaNode{*m_current, m_childInstantiables->m_ctx};
 }
 
 ChildInstanstiablesIterator::SchemaNodeProxy ChildInstanstiablesIterator::operator->() const
 {
-    if (!m_current) {
-        throw std::out_of_range("Derefenced .end iterator");
-    }
-    return {SchemaNode{m_current, m_childInstantiables->m_ctx}};
+    return {operator*()};
 }
 
 bool ChildInstanstiablesIterator::operator==(const ChildInstanstiablesIterator& other) const
@@ -67,20 +127,72 @@ bool ChildInstanstiablesIterator::operator==(const ChildInstanstiablesIterator&
     return m_current == other.m_current && m_childInstantiables == other.m_childInstantiables;
 }
 
-ChildInstanstiables::ChildInstanstiables(const lysc_node* parent, const lysc_module* module, std::shared_ptr<ly_ctx> ctx)
-    : m_parent(parent)
-    , m_module(module)
-    , m_ctx(ctx)
+std::strong_ordering ChildInstanstiablesIterator::operator<=>(const ChildInstanstiablesIterator& other) const
 {
+    return std::compare_three_way{}(m_current, other.m_current);
+}
+
+/**
+ * @brief Looks up the children, they are collected only once per parent and options, and then cached within the context.
+ */
+ChildInstanstiables::ChildInstanstiables(const lysc_node* parent, const lysc_module* module, const uint32_t options, std::shared_ptr<ly_ctx> ctx)
+    : m_ctx(ctx)
+{
+    auto state = m_ctx ? impl::contextState(m_ctx) : nullptr;
+    if (!state) {
+        m_children = collectChildren(parent, module, options);
+        return;
+    }
+
+    const impl::child_table_key key{parent, module, options};
+    {
+        std::shared_lock lock{state->childTablesMutex};
+        if (auto it = state->childTables.find(key); it != state->childTables.end()) {
+            m_children = it->second;
+            return;
+        }
+    }
+
+    auto children = collectChildren(parent, module, options);
+    std::unique_lock lock{state->childTablesMutex};
+    m_children = state->childTables.try_emplace(key, std::move(children)).first->second;
 }
 
 ChildInstanstiablesIterator ChildInstanstiables::begin() const
 {
-    return ChildInstanstiablesIterator{m_parent, m_module, this};
+    return ChildInstanstiablesIterator{m_children->data(), this};
 }
 
 ChildInstanstiablesIterator ChildInstanstiables::end() const
 {
-    return ChildInstanstiablesIterator{nullptr, this};
+    return ChildInstanstiablesIterator{m_children->data() + m_children->size(), this};
+}
+
+/**
+ * @brief Returns the child at `index`, throws std::out_of_range if there's no such child.
+ */
+SchemaNode ChildInstanstiables::operator[](const std::size_t index) const
+{
+    return SchemaNode{m_children->at(index), m_ctx};
+}
+
+/**
+ * @brief Returns a borrowed reference to the child at `index`, see SchemaNodeView for the lifetime rules.
+ *
+ * Throws std::out_of_range if there's no such child.
+ */
+SchemaNodeView ChildInstanstiables::view(const std::size_t index) const&
+{
+    return SchemaNodeView{m_children->at(index), &m_ctx};
+}
+
+std::size_t ChildInstanstiables::size() const
+{
+    return m_children->size();
+}
+
+bool ChildInstanstiables::empty() const
+{
+    return m_children->empty();
 }
 }
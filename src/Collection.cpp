@@ -10,9 +10,57 @@
 #include <libyang-cpp/DataNode.hpp>
 #include <libyang/libyang.h>
 #include <stdexcept>
+#include <utility>
 #include "utils/ref_count.hpp"
 
 namespace libyang {
+namespace {
+lyd_node* childOf(lyd_node* node)
+{
+    return lyd_child(node);
+}
+
+const lysc_node* childOf(const lysc_node* node)
+{
+    return lysc_node_child(node);
+}
+
+/**
+ * @brief Returns the node which follows `current` in a depth-first traversal of the subtree of `start`.
+ *
+ * Returns nullptr when the whole subtree has been traversed.
+ */
+template <typename NodeType>
+NodeType* nextInDfs(NodeType* current, NodeType* start)
+{
+    // select element for the next run - children first
+    auto next = childOf(current);
+
+    if (!next) {
+        // no children
+        if (current == start) {
+            // we are done, `start` has no children
+            return nullptr;
+        }
+        // try siblings
+        next = current->next;
+    }
+
+    while (!next) {
+        // parent is already processed, go to its sibling
+        current = reinterpret_cast<NodeType*>(current->parent);
+        // no siblings, go back through parents
+        if (current->parent == start->parent) {
+            // we are done, no next element to process
+            break;
+        }
+        next = current->next;
+    }
+
+    return next;
+}
+}
+
 /**
  * @brief Creates a new iterator starting at `start`.
  */
@@ -52,6 +100,21 @@ Iterator<NodeType, ITER_TYPE>::Iterator(const Iterator<NodeType, ITER_TYPE>& oth
     registerThis();
 }
 
+/**
+ * @brief Takes over the position and the registration of `other`, which becomes invalid.
+ */
+template <typename NodeType, IterationType ITER_TYPE>
+Iterator<NodeType, ITER_TYPE>::Iterator(Iterator<NodeType, ITER_TYPE>&& other) noexcept
+    : m_current(other.m_current)
+    , m_start(other.m_start)
+    , m_next(other.m_next)
+    , m_collection(std::exchange(other.m_collection, nullptr))
+{
+    if (m_collection) {
+        m_collection->m_iterators.replace(&other, this);
+    }
+}
+
 template <typename NodeType, IterationType ITER_TYPE>
 void Iterator<NodeType, ITER_TYPE>::registerThis()
 {
@@ -59,7 +122,7 @@ void Iterator<NodeType, ITER_TYPE>::registerThis()
         if (!m_collection->m_valid) { // registerThis() is only run on construction -> the collection must be valid
             throw std::logic_error("libyang-cpp internal error: collection is invalid although it was just created");
         }
-        m_collection->m_iterators.emplace(this);
+        m_collection->m_iterators.insert(this);
     }
 }
 
@@ -80,36 +143,7 @@ Iterator<NodeType, ITER_TYPE>& Iterator<NodeType, ITER_TYPE>::operator++()
     }
 
     if constexpr (ITER_TYPE == IterationType::Dfs) {
-        // select element for the next run - children first
-        if constexpr (std::is_same_v<decltype(m_next), lyd_node*>) {
-            m_next = lyd_child(m_current);
-        } else {
-            m_next = lysc_node_child(m_current);
-        }
-
-        if (!m_next) {
-            // no children
-            if (m_current == m_start) {
-                // we are done, m_start has no children
-                // this iterator is now the `end` iterator, so wee need to set current to nullptr
-                m_current = nullptr;
-                return *this;
-            }
-            // try siblings
-            m_next = m_current->next;
-        }
-
-        while (!m_next) {
-            // parent is already processed, go to its sibling
-            m_current = reinterpret_cast<underlying_node_t<NodeType>*>(m_current->parent);
-            // no siblings, go back through parents
-            if (m_current->parent == m_start->parent) {
-                // we are done, no next element to process
-                break;
-            }
-            m_next = m_current->next;
-        }
-
+        m_next = nextInDfs(m_current, m_start);
         m_current = m_next;
     } else {
         m_current = m_current->next;
@@ -135,7 +169,7 @@ NodeType Iterator<NodeType, ITER_TYPE>::operator*() const
     }
 
     if constexpr (std::is_same_v<NodeType, Meta>) {
-        return Meta{m_current, m_collection->m_refs.m_refs ? m_collection->m_refs.m_refs->context : nullptr};
+        return Meta{m_current, m_collection->m_refs};
     } else {
         return NodeType{m_current, m_collection->m_refs};
     }
@@ -176,6 +210,26 @@ Iterator<NodeType, ITER_TYPE>& Iterator<NodeType, ITER_TYPE>::operator=(const It
     this->m_current = other.m_current;
     this->m_next = other.m_next;
     this->m_start = other.m_start;
+    registerThis();
+
+    return *this;
+}
+
+template <typename NodeType, IterationType ITER_TYPE>
+Iterator<NodeType, ITER_TYPE>& Iterator<NodeType, ITER_TYPE>::operator=(Iterator<NodeType, ITER_TYPE>&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    this->unregisterThis();
+    this->m_collection = std::exchange(other.m_collection, nullptr);
+    this->m_current = other.m_current;
+    this->m_next = other.m_next;
+    this->m_start = other.m_start;
+    if (m_collection) {
+        m_collection->m_iterators.replace(&other, this);
+    }
 
     return *this;
 }
@@ -193,29 +247,77 @@ Collection<NodeType, ITER_TYPE>::Collection(underlying_node_t<NodeType>* start,
     : m_start(start)
     , m_refs(refs)
 {
+    registerThis();
+}
+
+template <typename NodeType, IterationType ITER_TYPE>
+Collection<NodeType, ITER_TYPE>::Collection(const Collection<NodeType, ITER_TYPE>& other)
+    : m_start(other.m_start)
+    , m_refs(other.m_refs)
+    , m_valid(other.m_valid)
+{
+    registerThis();
+}
+
+/**
+ * @brief Takes over the registration and the iterators of `other`, which becomes invalid.
+ */
+template <typename NodeType, IterationType ITER_TYPE>
+Collection<NodeType, ITER_TYPE>::Collection(Collection<NodeType, ITER_TYPE>&& other) noexcept
+    : m_start(other.m_start)
+    , m_refs(std::move(other.m_refs))
+    , m_valid(other.m_valid)
+{
+    takeOverFrom(other);
+}
+
+template <typename NodeType, IterationType ITER_TYPE>
+void Collection<NodeType, ITER_TYPE>::takeOverFrom(Collection<NodeType, ITER_TYPE>& other) noexcept
+{
+    m_iterators = std::move(other.m_iterators);
+    for (auto iterator : m_iterators) {
+        iterator->m_collection = this;
+    }
+
     if constexpr (std::is_same_v<NodeType, DataNode>) {
         if (m_refs) {
+            auto lock = impl::lockIfFrozen(m_refs.get());
             if constexpr (ITER_TYPE == IterationType::Dfs) {
-                m_refs->dataCollectionsDfs.emplace(this);
+                m_refs->dataCollectionsDfs.replace(&other, this);
             } else {
-                m_refs->dataCollectionsSibling.emplace(this);
+                m_refs->dataCollectionsSibling.replace(&other, this);
             }
         }
     }
+
+    other.m_valid = false;
 }
 
 template <typename NodeType, IterationType ITER_TYPE>
-Collection<NodeType, ITER_TYPE>::Collection(const Collection<NodeType, ITER_TYPE>& other)
-    : m_start(other.m_start)
-    , m_refs(other.m_refs)
-    , m_valid(other.m_valid)
+void Collection<NodeType, ITER_TYPE>::registerThis()
+{
+    if constexpr (std::is_same_v<NodeType, DataNode>) {
+        if (m_refs) {
+            auto lock = impl::lockIfFrozen(m_refs.get());
+            if constexpr (ITER_TYPE == IterationType::Dfs) {
+                m_refs->dataCollectionsDfs.insert(this);
+            } else {
+                m_refs->dataCollectionsSibling.insert(this);
+            }
+        }
+    }
+}
+
+template <typename NodeType, IterationType ITER_TYPE>
+void Collection<NodeType, ITER_TYPE>::unregisterThis()
 {
     if constexpr (std::is_same_v<NodeType, DataNode>) {
         if (m_refs) {
+            auto lock = impl::lockIfFrozen(m_refs.get());
             if constexpr (ITER_TYPE == IterationType::Dfs) {
-                m_refs->dataCollectionsDfs.emplace(this);
+                m_refs->dataCollectionsDfs.erase(this);
             } else {
-                m_refs->dataCollectionsSibling.emplace(this);
+                m_refs->dataCollectionsSibling.erase(this);
             }
         }
     }
@@ -243,9 +345,29 @@ Collection<NodeType, ITER_TYPE>& Collection<NodeType, ITER_TYPE>::operator=(cons
     // Our iterators must be invalidated, since we're assigning a different collection.
     invalidate();
     m_iterators.clear();
+    unregisterThis();
     this->m_start = other.m_start;
     this->m_refs = other.m_refs;
     this->m_valid = other.m_valid;
+    registerThis();
+
+    return *this;
+}
+
+template <typename NodeType, IterationType ITER_TYPE>
+Collection<NodeType, ITER_TYPE>& Collection<NodeType, ITER_TYPE>::operator=(Collection<NodeType, ITER_TYPE>&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    // Our iterators must be invalidated, the ones from `other` are taken over.
+    invalidate();
+    unregisterThis();
+    this->m_start = other.m_start;
+    this->m_refs = std::move(other.m_refs);
+    this->m_valid = other.m_valid;
+    takeOverFrom(other);
 
     return *this;
 }
@@ -255,13 +377,7 @@ Collection<NodeType, ITER_TYPE>::~Collection()
 {
     if constexpr (std::is_same_v<NodeType, DataNode>) {
         invalidate();
-        if (m_refs) {
-            if constexpr (ITER_TYPE == IterationType::Dfs) {
-                m_refs->dataCollectionsDfs.erase(this);
-            } else {
-                m_refs->dataCollectionsSibling.erase(this);
-            }
-        }
+        unregisterThis();
     }
 }
 
@@ -299,6 +415,173 @@ void Collection<NodeType, ITER_TYPE>::throwIfInvalid() const
     }
 }
 
+/**
+ * @brief Returns a range of borrowed references to the nodes of this collection.
+ *
+ * This is a cheaper alternative to begin() and end() for read-only traversals. See DataNodeRef for lifetime rules.
+ */
+template <typename NodeType, IterationType ITER_TYPE>
+DataNodeRefRange<ITER_TYPE> Collection<NodeType, ITER_TYPE>::refs() const& requires std::is_same_v<NodeType, DataNode>
+{
+    throwIfInvalid();
+    return DataNodeRefRange<ITER_TYPE>{this};
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefRange<ITER_TYPE>::DataNodeRefRange(const Collection<DataNode, ITER_TYPE>* coll)
+    : m_collection(coll)
+{
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefIterator<ITER_TYPE> DataNodeRefRange<ITER_TYPE>::begin() const
+{
+    m_collection->throwIfInvalid();
+    return DataNodeRefIterator<ITER_TYPE>{m_collection->m_start, m_collection};
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefIterator<ITER_TYPE> DataNodeRefRange<ITER_TYPE>::end() const
+{
+    m_collection->throwIfInvalid();
+    return DataNodeRefIterator<ITER_TYPE>{nullptr, m_collection};
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefIterator<ITER_TYPE>::DataNodeRefIterator(lyd_node* start, const Collection<DataNode, ITER_TYPE>* coll)
+    : m_current(start)
+    , m_start(start)
+    , m_collection(coll)
+{
+}
+
+template <IterationType ITER_TYPE>
+void DataNodeRefIterator<ITER_TYPE>::throwIfInvalid() const
+{
+    if (!m_collection || !m_collection->m_valid) {
+        throw std::out_of_range("Iterator is invalid");
+    }
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefIterator<ITER_TYPE>& DataNodeRefIterator<ITER_TYPE>::operator++()
+{
+    throwIfInvalid();
+    if (!m_current) {
+        return *this;
+    }
+
+    if constexpr (ITER_TYPE == IterationType::Dfs) {
+        m_current = nextInDfs(m_current, m_start);
+    } else {
+        m_current = m_current->next;
+    }
+    return *this;
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRefIterator<ITER_TYPE> DataNodeRefIterator<ITER_TYPE>::operator++(int)
+{
+    auto copy = *this;
+    operator++();
+    return copy;
+}
+
+template <IterationType ITER_TYPE>
+DataNodeRef DataNodeRefIterator<ITER_TYPE>::operator*() const
+{
+    throwIfInvalid();
+    if (!m_current) {
+        throw std::out_of_range("Dereferenced .end() iterator");
+    }
+
+    return DataNodeRef{m_current, &m_collection->m_valid, &m_collection->m_refs};
+}
+
+template <IterationType ITER_TYPE>
+bool DataNodeRefIterator<ITER_TYPE>::operator==(const DataNodeRefIterator<ITER_TYPE>& other) const
+{
+    return m_current == other.m_current;
+}
+
+/**
+ * @brief Returns a range of borrowed references to the nodes of this collection.
+ *
+ * Unlike begin() and end(), this does not copy the reference to the context for each node. See SchemaNodeView for
+ * lifetime rules.
+ */
+template <typename NodeType, IterationType ITER_TYPE>
+SchemaNodeViewRange<ITER_TYPE> Collection<NodeType, ITER_TYPE>::views() const& requires std::is_same_v<NodeType, SchemaNode>
+{
+    throwIfInvalid();
+    return SchemaNodeViewRange<ITER_TYPE>{this};
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewRange<ITER_TYPE>::SchemaNodeViewRange(const Collection<SchemaNode, ITER_TYPE>* coll)
+    : m_collection(coll)
+{
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewIterator<ITER_TYPE> SchemaNodeViewRange<ITER_TYPE>::begin() const
+{
+    return SchemaNodeViewIterator<ITER_TYPE>{m_collection->m_start, m_collection};
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewIterator<ITER_TYPE> SchemaNodeViewRange<ITER_TYPE>::end() const
+{
+    return SchemaNodeViewIterator<ITER_TYPE>{nullptr, m_collection};
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewIterator<ITER_TYPE>::SchemaNodeViewIterator(const lysc_node* start, const Collection<SchemaNode, ITER_TYPE>* coll)
+    : m_current(start)
+    , m_start(start)
+    , m_collection(coll)
+{
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewIterator<ITER_TYPE>& SchemaNodeViewIterator<ITER_TYPE>::operator++()
+{
+    if (!m_current) {
+        return *this;
+    }
+
+    if constexpr (ITER_TYPE == IterationType::Dfs) {
+        m_current = nextInDfs(m_current, m_start);
+    } else {
+        m_current = m_current->next;
+    }
+    return *this;
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeViewIterator<ITER_TYPE> SchemaNodeViewIterator<ITER_TYPE>::operator++(int)
+{
+    auto copy = *this;
+    operator++();
+    return copy;
+}
+
+template <IterationType ITER_TYPE>
+SchemaNodeView SchemaNodeViewIterator<ITER_TYPE>::operator*() const
+{
+    if (!m_current) {
+        throw std::out_of_range("Dereferenced .end() iterator");
+    }
+
+    return SchemaNodeView{m_current, &m_collection->m_refs};
+}
+
+template <IterationType ITER_TYPE>
+bool SchemaNodeViewIterator<ITER_TYPE>::operator==(const SchemaNodeViewIterator<ITER_TYPE>& other) const
+{
+    return m_current == other.m_current;
+}
+
 template class LIBYANG_CPP_EXPORT Collection<DataNode, IterationType::Dfs>;
 template class LIBYANG_CPP_EXPORT Iterator<DataNode, IterationType::Dfs>;
 
@@ -311,6 +594,12 @@ template class LIBYANG_CPP_EXPORT Iterator<DataNode, IterationType::Sibling>;
 template class LIBYANG_CPP_EXPORT Collection<SchemaNode, IterationType::Sibling>;
 template class LIBYANG_CPP_EXPORT Iterator<SchemaNode, IterationType::Sibling>;
 
+template class LIBYANG_CPP_EXPORT DataNodeRefRange<IterationType::Dfs>;
+template class LIBYANG_CPP_EXPORT DataNodeRefIterator<IterationType::Dfs>;
+
+template class LIBYANG_CPP_EXPORT DataNodeRefRange<IterationType::Sibling>;
+template class LIBYANG_CPP_EXPORT DataNodeRefIterator<IterationType::Sibling>;
+
 #pragma GCC diagnostic push
 #if __GNUC__ && !__clang__
 #pragma GCC diagnostic ignored "-Wattributes"
@@ -328,9 +617,16 @@ template class LIBYANG_CPP_EXPORT Iterator<Meta, IterationType::Meta>;
  */
 Iterator<Meta, IterationType::Meta> MetaCollection::erase(Iterator<Meta, IterationType::Meta> what)
 {
+    m_refs.throwIfFrozen("MetaCollection::erase");
+    m_refs.recordChange();
     auto toDelete = what;
     auto next = ++what;
     lyd_free_meta_single(toDelete.m_current);
     return next;
 }
+
+template class LIBYANG_CPP_EXPORT SchemaNodeViewRange<IterationType::Dfs>;
+template class LIBYANG_CPP_EXPORT SchemaNodeViewIterator<IterationType::Dfs>;
+template class LIBYANG_CPP_EXPORT SchemaNodeViewRange<IterationType::Sibling>;
+template class LIBYANG_CPP_EXPORT SchemaNodeViewIterator<IterationType::Sibling>;
 }
@@ -7,17 +7,33 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <fstream>
 #include <libyang-cpp/Context.hpp>
 #include <libyang-cpp/DataNode.hpp>
 #include <libyang-cpp/SchemaNode.hpp>
 #include <libyang-cpp/Utils.hpp>
 #include <libyang/libyang.h>
+#include <mutex>
 #include <span>
 #include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils/arena.hpp"
+#include "utils/context.hpp"
+#include "utils/data_file.hpp"
 #include "utils/deleters.hpp"
 #include "utils/enum.hpp"
 #include "utils/exception.hpp"
 #include "utils/newPath.hpp"
+#include "utils/parallel.hpp"
 
 using namespace std::string_literals;
 
@@ -51,7 +67,7 @@ Context::Context(const std::optional<std::filesystem::path>& searchPath, const s
     auto err = ly_ctx_new(searchPath ? PATH_TO_LY_STRING(*searchPath) : nullptr, options ? utils::toContextOptions(*options) : 0, &ctx);
     throwIfError(err, "Can't create libyang context");
 
-    m_ctx = std::shared_ptr<ly_ctx>(ctx, ly_ctx_destroy);
+    m_ctx = std::shared_ptr<ly_ctx>(ctx, impl::context_deleter{ly_ctx_destroy, std::make_shared<impl::context_state>()});
 }
 
 /**
@@ -59,16 +75,100 @@ Context::Context(const std::optional<std::filesystem::path>& searchPath, const s
  * pointer is not managed further by libyang-cpp's automatic memory management.
  */
 Context::Context(ly_ctx* ctx, ContextDeleter deleter)
-    : m_ctx(ctx, deleter ? deleter : ContextDeleter([] (ly_ctx*) {}))
+    : m_ctx(ctx, impl::context_deleter{std::move(deleter), std::make_shared<impl::context_state>()})
 {
 }
 
+namespace impl {
+void context_deleter::operator()(ly_ctx* ctx) const
+{
+    if (destroy) {
+        destroy(ctx);
+    }
+}
+
+/**
+ * @brief Returns the state shared by all Context instances of this ly_ctx, or nullptr for pointers not created by Context.
+ */
+context_state* contextState(const std::shared_ptr<ly_ctx>& ctx)
+{
+    auto deleter = std::get_deleter<context_deleter>(ctx);
+    return deleter ? deleter->state.get() : nullptr;
+}
+
+/**
+ * @brief Returns the stats of this ly_ctx, or nullptr for pointers not created by Context.
+ */
+context_stats* contextStats(const std::shared_ptr<ly_ctx>& ctx)
+{
+    auto state = contextState(ctx);
+    return state ? &state->stats : nullptr;
+}
+
+void stats_span::finish() noexcept
+{
+    auto duration = std::chrono::steady_clock::now() - m_start;
+    auto index = static_cast<std::size_t>(m_operation);
+    m_stats->calls[index].fetch_add(1, std::memory_order_relaxed);
+    m_stats->nanoseconds[index].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::memory_order_relaxed);
+
+    std::shared_ptr<const std::function<SpanCallback>> callback;
+    {
+        std::lock_guard lock{m_stats->spanCallbackMutex};
+        callback = m_stats->spanCallback;
+    }
+    if (callback) {
+        try {
+            (*callback)(m_operation, m_start, duration);
+        } catch (...) {
+            // The operation itself has already finished, there's no one to report this to.
+        }
+    }
+}
+
+void throwIfSchemaLocked(const std::shared_ptr<ly_ctx>& ctx, const char* where)
+{
+    if (auto state = contextState(ctx); state && state->schemaLocked) {
+        throw Error{std::string{where} + ": the schema of the context is locked"};
+    }
+}
+
+/**
+ * @brief Drops everything which was cached for the schema of this context. Call this before changing the schema.
+ *
+ * libyang might recompile any module when the schema changes, so cached data cannot be trusted afterwards.
+ */
+void schemaChanged(const std::shared_ptr<ly_ctx>& ctx)
+{
+    if (auto state = contextState(ctx)) {
+        {
+            std::unique_lock lock{state->pathsMutex};
+            state->paths.clear();
+        }
+        {
+            std::unique_lock lock{state->childTablesMutex};
+            state->childTables.clear();
+        }
+        std::unique_lock lock{state->schemaIndexMutex};
+        state->schemaIndex.reset();
+    }
+}
+
+std::size_t schema_child_key_hash::operator()(const schema_child_key& key) const noexcept
+{
+    auto res = hashCombine(std::hash<const lysc_node*>{}(key.parent), std::hash<std::string_view>{}(key.module));
+    res = hashCombine(res, std::hash<std::string_view>{}(key.name));
+    return hashCombine(res, key.output);
+}
+}
+
 /**
  * @brief Set the search directory for the context.
  * @param searchPath The desired search directory.
  */
 void Context::setSearchDir(const std::filesystem::path& searchDir) const
 {
+    impl::throwIfSchemaLocked(m_ctx, "Context::setSearchDir");
     auto err = ly_ctx_set_searchdir(m_ctx.get(), PATH_TO_LY_STRING(searchDir));
     throwIfError(err, "Can't set search directory");
 }
@@ -95,6 +195,8 @@ std::vector<const char*> toCStringArray(const std::vector<std::string>& vec)
  */
 Module Context::parseModule(const std::string& data, const SchemaFormat format, const std::vector<std::string>& features) const
 {
+    impl::throwIfSchemaLocked(m_ctx, "Context::parseModule");
+    impl::schemaChanged(m_ctx);
     auto in = wrap_ly_in_new_memory(data);
     lys_module* mod;
     auto err = lys_parse(m_ctx.get(), in.get(), utils::toLysInformat(format), toCStringArray(features).data(), &mod);
@@ -112,6 +214,8 @@ Module Context::parseModule(const std::string& data, const SchemaFormat format,
  */
 Module Context::parseModule(const std::filesystem::path& path, const SchemaFormat format, const std::vector<std::string>& features) const
 {
+    impl::throwIfSchemaLocked(m_ctx, "Context::parseModule");
+    impl::schemaChanged(m_ctx);
     auto in = wrap_ly_in_new_file(path);
     lys_module* mod;
     auto err = lys_parse(m_ctx.get(), in.get(), utils::toLysInformat(format), toCStringArray(features).data(), &mod);
@@ -132,28 +236,100 @@ std::optional<DataNode> Context::parseData(
         const std::optional<ParseOptions> parseOpts,
         const std::optional<ValidationOptions> validationOpts) const
 {
+    return parseData(asNulTerminatedBytes(data), format, parseOpts, validationOpts);
+}
+
+/**
+ * @brief Parses data from a memory buffer into libyang.
+ *
+ * The buffer is parsed in place if its last byte is NUL. Otherwise, libyang's requirement of a NUL-terminated input
+ * means that the buffer is copied first. Callers which receive their data into their own buffers (e.g., from the
+ * network) can append the NUL byte there to avoid that copy.
+ *
+ * @param data Buffer containing the input data.
+ * @param format Format of the input data.
+ *
+ * Wraps `lyd_parse_data`.
+ */
+std::optional<DataNode> Context::parseData(
+        std::span<const std::byte> data,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts) const
+{
+    auto res = tryParseData(data, format, parseOpts, validationOpts);
+    if (!res) {
+        throwError(static_cast<int>(res.error()), "Can't parse data");
+    }
+    return *std::move(res);
+}
+
+/**
+ * @brief Parses data from a string into libyang, reports errors via the return value instead of throwing.
+ *
+ * See the `std::span` overload for details.
+ */
+Expected<std::optional<DataNode>> Context::tryParseData(
+        const std::string& data,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts) const
+{
+    return tryParseData(asNulTerminatedBytes(data), format, parseOpts, validationOpts);
+}
+
+/**
+ * @brief Parses data from a memory buffer into libyang, reports errors via the return value instead of throwing.
+ *
+ * This is meant for servers which reject invalid input often, and which don't want to pay for an exception (and its
+ * formatted message) each time. The details of the error are available through errorViews(); to keep libyang from
+ * also logging them, use ScopedLogOptions. The errors are kept until cleanAllErrors() is called.
+ *
+ * @return The parsed tree (std::nullopt for empty input), or the ErrorCode which libyang has returned.
+ *
+ * Wraps `lyd_parse_data`.
+ */
+Expected<std::optional<DataNode>> Context::tryParseData(
+        std::span<const std::byte> data,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts) const
+{
+    impl::stats_span span{impl::contextStats(m_ctx), StatsOperation::ParseData};
+    std::string storage;
+    auto in = wrap_ly_in_new_memory(data, storage);
+
     lyd_node* tree;
-    auto err = lyd_parse_data_mem(
+    auto err = lyd_parse_data(
             m_ctx.get(),
-            data.c_str(),
+            nullptr,
+            in.get(),
             utils::toLydFormat(format),
             parseOpts ? utils::toParseOptions(*parseOpts) : 0,
             validationOpts ? utils::toValidationOptions(*validationOpts) : 0,
             &tree);
-    throwIfError(err, "Can't parse data");
-
+    if (err != LY_SUCCESS) {
+        return static_cast<ErrorCode>(err);
+    }
 
     if (!tree) {
-        return std::nullopt;
+        return std::optional<DataNode>{std::nullopt};
     }
 
-    return DataNode{tree, m_ctx};
+    auto res = DataNode{tree, m_ctx};
+    if (!parseOpts || !(utils::toParseOptions(*parseOpts) & LYD_PARSE_ONLY)) {
+        res.m_refs->markValidated();
+    }
+    return std::optional{std::move(res)};
 }
 
 /**
- * @brief Parses data from a string into libyang.
+ * @brief Parses data from a file into libyang.
  *
- * @param data String containing the input data.
+ * The file is not read into an intermediate buffer; libyang maps it into memory and parses it from there. Use the
+ * overload which takes DataFileOptions for compressed files.
+ *
+ * @param path Path to the file with the input data.
  * @param format Format of the input data.
  */
 std::optional<DataNode> Context::parseData(
@@ -162,8 +338,8 @@ std::optional<DataNode> Context::parseData(
         const std::optional<ParseOptions> parseOpts,
         const std::optional<ValidationOptions> validationOpts) const
 {
+    impl::stats_span span{impl::contextStats(m_ctx), StatsOperation::ParseData};
     lyd_node* tree;
-    ly_log_level(LY_LLDBG);
     auto err = lyd_parse_data_path(
             m_ctx.get(),
             PATH_TO_LY_STRING(path),
@@ -177,7 +353,75 @@ std::optional<DataNode> Context::parseData(
         return std::nullopt;
     }
 
-    return DataNode{tree, m_ctx};
+    auto res = DataNode{tree, m_ctx};
+    if (!parseOpts || !(utils::toParseOptions(*parseOpts) & LYD_PARSE_ONLY)) {
+        res.m_refs->markValidated();
+    }
+    return res;
+}
+
+/**
+ * @brief Parses data from a file which might be compressed by gzip or zstd.
+ *
+ * The compression is recognized by the magic bytes at the start of the file. A compressed file is decompressed into
+ * memory in chunks of `fileOpts.bufferSize`, and parsed from there; an uncompressed file is left to libyang, just like
+ * in the other overload. With DataFormat::Detect, the format of a compressed file is guessed from the name of the file
+ * without the compression suffix, e.g., `running.json.zst`.
+ *
+ * Support for gzip and zstd is optional at build time, parsing a file which uses an unsupported compression throws.
+ *
+ * @param path Path to the file with the input data.
+ * @param format Format of the input data.
+ * @param fileOpts How to read the file, see DataFileOptions.
+ */
+std::optional<DataNode> Context::parseData(
+        const std::filesystem::path& path,
+        const DataFormat format,
+        const DataFileOptions& fileOpts,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts) const
+{
+    auto decompressed = impl::readCompressedDataFile(path, fileOpts.bufferSize);
+    if (!decompressed) {
+        return parseData(path, format, parseOpts, validationOpts);
+    }
+
+    return parseData(
+            asNulTerminatedBytes(*decompressed),
+            format == DataFormat::Detect ? impl::dataFormatOf(path) : format,
+            parseOpts,
+            validationOpts);
+}
+
+/**
+ * @brief Creates a parser for a data document which arrives in chunks, e.g., from a socket.
+ *
+ * Instead of building one tree for the whole document, the parser invokes `callback` with a separate tree for each
+ * record as soon as the record has been fed completely. A record is:
+ *
+ *   - for JSON, one member of the top-level object, or one entry if the member is a list,
+ *   - for XML, one top-level element.
+ *
+ * A JSON member is handed out once the next one starts, because its metadata (the `@name` member) might still follow;
+ * the metadata are parsed in the same record.
+ *
+ * When the interesting data are nested, e.g., the entries of `/ietf-interfaces:interfaces/interface`, or they are
+ * wrapped in a NETCONF `<data>` element, use `recordPath`. The records are then the children of the innermost parent in
+ * `recordPath.parents`, and each record is handed out together with all of these parents.
+ *
+ * Once the callback drops the tree, its memory is released, so the peak memory use is proportional to the size of one
+ * record rather than of the whole document. The records are not validated, because constraints might refer to other
+ * records; ParseOptions::ParseOnly is always added to `parseOpts`.
+ *
+ * Feed the input via DataStreamParser::feed, and call DataStreamParser::finish at the end of the input.
+ */
+DataStreamParser Context::parseDataStream(
+        const DataFormat format,
+        std::function<void(DataNode)> callback,
+        const std::optional<ParseOptions> parseOpts,
+        const DataStreamRecordPath& recordPath) const
+{
+    return DataStreamParser{m_ctx, format, std::move(callback), parseOpts, recordPath};
 }
 
 /**
@@ -192,7 +436,26 @@ std::optional<DataNode> Context::parseExtData(
     const std::optional<ParseOptions> parseOpts,
     const std::optional<ValidationOptions> validationOpts) const
 {
-    auto in = wrap_ly_in_new_memory(data);
+    return parseExtData(ext, asNulTerminatedBytes(data), format, parseOpts, validationOpts);
+}
+
+/**
+ * @brief Parses data from a memory buffer representing extension data tree node.
+ *
+ * See Context::parseData for when the buffer is parsed in place.
+ *
+ * Wraps `lyd_parse_ext_data`.
+ */
+std::optional<DataNode> Context::parseExtData(
+    const ExtensionInstance& ext,
+    std::span<const std::byte> data,
+    const DataFormat format,
+    const std::optional<ParseOptions> parseOpts,
+    const std::optional<ValidationOptions> validationOpts) const
+{
+    impl::stats_span span{impl::contextStats(m_ctx), StatsOperation::ParseData};
+    std::string storage;
+    auto in = wrap_ly_in_new_memory(data, storage);
 
     lyd_node* tree = nullptr;
     auto err = lyd_parse_ext_data(
@@ -241,7 +504,44 @@ std::optional<DataNode> Context::parseExtData(
  */
 ParsedOp Context::parseOp(const std::string& input, const DataFormat format, const OperationType opType) const
 {
-    auto in = wrap_ly_in_new_memory(input);
+    return parseOp(asNulTerminatedBytes(input), format, opType);
+}
+
+/**
+ * @brief Parses YANG data from a memory buffer into an operation data tree.
+ *
+ * See Context::parseData for when the buffer is parsed in place.
+ */
+ParsedOp Context::parseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const
+{
+    auto res = tryParseOp(input, format, opType);
+    if (!res) {
+        throwError(static_cast<int>(res.error()), "Can't parse a standalone rpc/action/notification into operation data tree");
+    }
+    return *std::move(res);
+}
+
+/**
+ * @brief Parses YANG data into an operation data tree, reports parse errors via the return value instead of throwing.
+ *
+ * Unsupported values of `opType` are a programming error, these still throw. See tryParseData() for how to get
+ * the details of the error.
+ */
+Expected<ParsedOp> Context::tryParseOp(const std::string& input, const DataFormat format, const OperationType opType) const
+{
+    return tryParseOp(asNulTerminatedBytes(input), format, opType);
+}
+
+/**
+ * @brief Parses YANG data from a memory buffer into an operation data tree, reports parse errors via the return value.
+ *
+ * See Context::parseData for when the buffer is parsed in place.
+ */
+Expected<ParsedOp> Context::tryParseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const
+{
+    impl::stats_span span{impl::contextStats(m_ctx), StatsOperation::ParseOp};
+    std::string storage;
+    auto in = wrap_ly_in_new_memory(input, storage);
 
     switch (opType) {
     case OperationType::RpcYang:
@@ -254,15 +554,17 @@ ParsedOp Context::parseOp(const std::string& input, const DataFormat format, con
         auto err = lyd_parse_op(m_ctx.get(), nullptr, in.get(), utils::toLydFormat(format), utils::toOpType(opType), &tree, &op);
 
         ParsedOp res;
-        res.tree = tree ? std::optional{libyang::wrapRawNode(tree)} : std::nullopt;
+        res.tree = tree ? std::optional{DataNode{tree, m_ctx}} : std::nullopt;
 
         if ((opType == OperationType::NotificationYang) || (opType == OperationType::RpcYang)) {
             res.op = op && tree ? std::optional{DataNode(op, res.tree->m_refs)} : std::nullopt;
         } else {
-            res.op = op ? std::optional{libyang::wrapRawNode(op)} : std::nullopt;
+            res.op = op ? std::optional{DataNode{op, m_ctx}} : std::nullopt;
         }
 
-        throwIfError(err, "Can't parse a standalone rpc/action/notification into operation data tree");
+        if (err != LY_SUCCESS) {
+            return static_cast<ErrorCode>(err);
+        }
         return res;
     }
     case OperationType::ReplyNetconf:
@@ -275,6 +577,104 @@ ParsedOp Context::parseOp(const std::string& input, const DataFormat format, con
     }
 }
 
+namespace {
+ErrorInfo errorInfoOf(const ly_err_item* item)
+{
+    return ErrorInfo{
+        .appTag = item->apptag ? std::optional{item->apptag} : std::nullopt,
+        .level = utils::toLogLevel(item->level),
+        .message = item->msg,
+        .code = static_cast<ErrorCode>(item->err),
+        .dataPath = item->data_path ? std::optional{item->data_path} : std::nullopt,
+        .schemaPath = item->schema_path ? std::optional{item->schema_path} : std::nullopt,
+        .line = item->line,
+        .validationCode = utils::toValidationErrorCode(item->vecode)
+    };
+}
+
+/**
+ * @brief Runs `parse` for each of `count` inputs on a pool of `threads` threads, including the calling one.
+ *
+ * The errors which libyang records for an input are moved into its result. The first exception stops all threads, and
+ * it is rethrown once they have finished.
+ */
+template <typename T, typename Parse>
+std::vector<ParseManyResult<T>> parseManyWith(ly_ctx* ctx, const std::size_t count, const std::size_t threads, const Parse& parse)
+{
+    std::vector<ParseManyResult<T>> results(count, ParseManyResult<T>{ErrorCode::Unknown, {}});
+    impl::parallelFor(count, threads, [&](const std::size_t i) {
+        // Keep all errors of this input instead of just the last one, and don't log them as they are returned anyway
+        ScopedLogOptions storeOnly{LogOptions::Store};
+        auto previous = ly_err_last(ctx);
+        results[i].result = parse(i);
+        auto first = previous ? previous->next : ly_err_first(ctx);
+        if (first) {
+            for (auto errIt = first; errIt; errIt = errIt->next) {
+                results[i].errors.push_back(errorInfoOf(errIt));
+            }
+            ly_err_clean(ctx, first);
+        }
+    });
+    return results;
+}
+}
+
+/**
+ * @brief Parses and validates many independent data documents at once, on a pool of threads.
+ *
+ * This is meant for a stream of small documents which would otherwise be parsed one after another, e.g., the
+ * notifications received by a collector. Up to `threads` threads (0 means one per CPU core, the calling thread is one
+ * of them) parse the inputs against the shared schema, so the schema must be locked via lockSchema() first.
+ *
+ * The results are in the order of `inputs`. A document which fails to parse does not affect the others, its result
+ * holds the ErrorCode and `errors` holds what libyang has recorded for it. These errors are neither logged nor left
+ * behind in the error storage of any thread, the errors which the calling thread had before are kept. Other
+ * exceptions, e.g., std::bad_alloc, are propagated once all threads have finished.
+ *
+ * See parseData() for the meaning of the options, and DataNode::freeze() for sharing the resulting trees between
+ * threads.
+ *
+ * Wraps `lyd_parse_data`.
+ */
+std::vector<ParseManyResult<std::optional<DataNode>>> Context::parseMany(
+        std::span<const std::string> inputs,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts,
+        const std::size_t threads) const
+{
+    if (!isSchemaLocked()) {
+        throw Error{"Context::parseMany: the schema must be locked first"};
+    }
+
+    return parseManyWith<std::optional<DataNode>>(m_ctx.get(), inputs.size(), threads, [&](const std::size_t i) {
+        return tryParseData(inputs[i], format, parseOpts, validationOpts);
+    });
+}
+
+/**
+ * @brief Parses many independent operations at once, on a pool of threads.
+ *
+ * The same as the other overload, except that each input is parsed via tryParseOp(), see there for the supported
+ * operation types.
+ *
+ * Wraps `lyd_parse_op`.
+ */
+std::vector<ParseManyResult<ParsedOp>> Context::parseMany(
+        std::span<const std::string> inputs,
+        const DataFormat format,
+        const OperationType opType,
+        const std::size_t threads) const
+{
+    if (!isSchemaLocked()) {
+        throw Error{"Context::parseMany: the schema must be locked first"};
+    }
+
+    return parseManyWith<ParsedOp>(m_ctx.get(), inputs.size(), threads, [&](const std::size_t i) {
+        return tryParseOp(inputs[i], format, opType);
+    });
+}
+
 /**
  * @brief Creates a new node with the supplied path, creating a completely new tree.
  *
@@ -285,7 +685,7 @@ ParsedOp Context::parseOp(const std::string& input, const DataFormat format, con
  */
 DataNode Context::newPath(const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options) const
 {
-    auto out = impl::newPath(nullptr, m_ctx.get(), std::make_shared<internal_refcount>(m_ctx), path, value, options);
+    auto out = impl::newPath(nullptr, m_ctx.get(), impl::makeShared<internal_refcount>(m_ctx), path, value, options);
 
     if (!out) {
         throw std::logic_error("Expected a new node to be created");
@@ -306,7 +706,7 @@ CreatedNodes Context::newPath2(const std::string& path, const std::optional<std:
 {
     // The AnydataValueType here doesn't matter, because this overload creates a classic node and not an `anydata` node.
     // TODO: Make overloads for all of the AnydataValueType values.
-    auto out = impl::newPath2(nullptr, m_ctx.get(), std::make_shared<internal_refcount>(m_ctx), path, value ? value->c_str() : nullptr, AnydataValueType::String, options);
+    auto out = impl::newPath2(nullptr, m_ctx.get(), impl::makeShared<internal_refcount>(m_ctx), path, value ? value->c_str() : nullptr, AnydataValueType::String, options);
 
     if (!out.createdNode) {
         throw std::logic_error("Expected a new node to be created");
@@ -325,7 +725,7 @@ CreatedNodes Context::newPath2(const std::string& path, const std::optional<std:
  */
 CreatedNodes Context::newPath2(const std::string& path, libyang::XML xml, const std::optional<CreationOptions> options) const
 {
-    auto out = impl::newPath2(nullptr, m_ctx.get(), std::make_shared<internal_refcount>(m_ctx), path, xml.content.data(), AnydataValueType::XML, options);
+    auto out = impl::newPath2(nullptr, m_ctx.get(), impl::makeShared<internal_refcount>(m_ctx), path, xml.content.data(), AnydataValueType::XML, options);
 
     if (!out.createdNode) {
         throw std::logic_error("Expected a new node to be created");
@@ -344,7 +744,7 @@ CreatedNodes Context::newPath2(const std::string& path, libyang::XML xml, const
  */
 CreatedNodes Context::newPath2(const std::string& path, libyang::JSON json, const std::optional<CreationOptions> options) const
 {
-    auto out = impl::newPath2(nullptr, m_ctx.get(), std::make_shared<internal_refcount>(m_ctx), path, json.content.data(), AnydataValueType::JSON, options);
+    auto out = impl::newPath2(nullptr, m_ctx.get(), impl::makeShared<internal_refcount>(m_ctx), path, json.content.data(), AnydataValueType::JSON, options);
 
     if (!out.createdNode) {
         throw std::logic_error("Expected a new node to be created");
@@ -353,6 +753,29 @@ CreatedNodes Context::newPath2(const std::string& path, libyang::JSON json, cons
     return out;
 }
 
+/**
+ * @brief Creates a new tree from many absolute paths.
+ *
+ * This is equivalent to creating the first node via newPath() and the rest of them via DataNode::newPath(), but it is
+ * much faster when consecutive paths share their beginning, e.g., when they are sorted. Each path is only resolved
+ * from the deepest node which it has in common with the previous path, and only a single DataNode is created.
+ *
+ * @param nodes The paths of the new nodes along with their values.
+ * @param options Options that change the behavior of this method, these apply to all of the nodes.
+ * @return The first top-level node of the new tree, or std::nullopt if `nodes` is empty.
+ *
+ * Wraps `lyd_new_path2`.
+ */
+std::optional<DataNode> Context::newPaths(std::span<const PathValue> nodes, const std::optional<CreationOptions> options) const
+{
+    auto forest = impl::newPaths(nullptr, m_ctx.get(), nullptr, nodes, options);
+    if (!forest) {
+        return std::nullopt;
+    }
+
+    return DataNode{lyd_first_sibling(forest), impl::makeShared<internal_refcount>(m_ctx)};
+}
+
 /**
  * @brief Creates a new extension node with the supplied path, creating a completely new tree.
  *
@@ -364,7 +787,7 @@ CreatedNodes Context::newPath2(const std::string& path, libyang::JSON json, cons
  */
 std::optional<DataNode> Context::newExtPath(const ExtensionInstance& ext, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options) const
 {
-    auto out = impl::newExtPath(nullptr, ext.m_instance, std::make_shared<internal_refcount>(m_ctx), path, value, options);
+    auto out = impl::newExtPath(nullptr, ext.m_instance, impl::makeShared<internal_refcount>(m_ctx), path, value, options);
 
     if (!out) {
         throw std::logic_error("Expected a new node to be created");
@@ -391,7 +814,7 @@ std::optional<DataNode> Context::newOpaqueJSON(const std::string& moduleName, co
     throwIfError(err, "Couldn't create an opaque JSON node '"s + moduleName + ':' + name + "'");
 
     if (out) {
-        return DataNode{out, std::make_shared<internal_refcount>(m_ctx)};
+        return DataNode{out, impl::makeShared<internal_refcount>(m_ctx)};
     } else {
         return std::nullopt;
     }
@@ -416,22 +839,127 @@ std::optional<DataNode> Context::newOpaqueXML(const std::string& xmlNamespace, c
     throwIfError(err, "Couldn't create an opaque XML node '"s + name +"' from namespace '" + xmlNamespace + "'");
 
     if (out) {
-        return DataNode{out, std::make_shared<internal_refcount>(m_ctx)};
+        return DataNode{out, impl::makeShared<internal_refcount>(m_ctx)};
     } else {
         return std::nullopt;
     }
 
 }
 
+namespace {
+bool isInput(const lysc_node* node)
+{
+    for (; node; node = node->parent) {
+        if (node->nodetype == LYS_INPUT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+impl::schema_child_key childKey(const lysc_node* parent, const std::string_view module, const std::string_view name, const bool output)
+{
+    // Only the children of an RPC or an action depend on whether it's the input or the output, the parent is
+    // enough to tell them apart anywhere deeper.
+    return {parent, module, name, output && parent && (parent->nodetype & (LYS_RPC | LYS_ACTION))};
+}
+
+void indexNode(impl::schema_index& index, const lysc_node* parent, const lysc_node* node, const bool output);
+
+void indexChildren(impl::schema_index& index, const lysc_node* parent, const bool output)
+{
+    const uint32_t options = output ? LYS_GETNEXT_OUTPUT : 0;
+    for (auto child = lys_getnext(nullptr, parent, nullptr, options); child; child = lys_getnext(child, parent, nullptr, options)) {
+        indexNode(index, parent, child, output);
+    }
+}
+
+void indexNode(impl::schema_index& index, const lysc_node* parent, const lysc_node* node, const bool output)
+{
+    auto path = std::unique_ptr<char, deleter_free_t>(lysc_path(node, LYSC_PATH_DATA, nullptr, 0));
+    if (!path) {
+        throw std::bad_alloc();
+    }
+    (output ? index.outputPaths : index.paths).emplace(path.get(), node);
+    index.children.emplace(childKey(parent, node->module->name, node->name, output), node);
+
+    if (node->nodetype & (LYS_RPC | LYS_ACTION)) {
+        indexChildren(index, node, false);
+        indexChildren(index, node, true);
+    } else if (node->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_NOTIF)) {
+        indexChildren(index, node, output);
+    }
+}
+
+impl::schema_index buildIndex(const ly_ctx* ctx)
+{
+    impl::schema_index index;
+    uint32_t i = 0;
+    while (auto module = ly_ctx_get_module_iter(ctx, &i)) {
+        if (!module->implemented || !module->compiled) {
+            continue;
+        }
+        for (auto node = lys_getnext(nullptr, nullptr, module->compiled, 0); node; node = lys_getnext(node, nullptr, module->compiled, 0)) {
+            indexNode(index, nullptr, node, false);
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Runs `lookup` on the schema index, which is rebuilt first if the schema has changed. Returns nullptr if the
+ * index is not enabled.
+ */
+template <typename Lookup>
+const lysc_node* withSchemaIndex(const std::shared_ptr<ly_ctx>& ctx, Lookup lookup)
+{
+    auto state = impl::contextState(ctx);
+    if (!state || !state->schemaIndexEnabled) {
+        return nullptr;
+    }
+
+    {
+        std::shared_lock lock{state->schemaIndexMutex};
+        if (state->schemaIndex) {
+            return lookup(*state->schemaIndex);
+        }
+    }
+
+    std::unique_lock lock{state->schemaIndexMutex};
+    if (!state->schemaIndex) {
+        state->schemaIndex = buildIndex(ctx.get());
+    }
+    return lookup(*state->schemaIndex);
+}
+}
+
 /**
  * @brief Returns the schema definition of a node specified by `dataPath`.
  *
+ * This is a hash lookup if the schema index is enabled, see buildSchemaIndex().
+ *
  * @param dataPath A JSON path of the node to get.
  * @param inputOutputNodes Consider input or output nodes
  * @return The found schema node.
  */
 SchemaNode Context::findPath(const std::string& dataPath, const InputOutputNodes inputOutputNodes) const
 {
+    auto indexed = withSchemaIndex(m_ctx, [&dataPath, inputOutputNodes](const impl::schema_index& index) -> const lysc_node* {
+        if (inputOutputNodes == InputOutputNodes::Output) {
+            if (auto it = index.outputPaths.find(dataPath); it != index.outputPaths.end()) {
+                return it->second;
+            }
+        }
+        auto it = index.paths.find(dataPath);
+        if (it == index.paths.end() || (inputOutputNodes == InputOutputNodes::Output && isInput(it->second))) {
+            return nullptr;
+        }
+        return it->second;
+    });
+    if (indexed) {
+        return SchemaNode{indexed, m_ctx};
+    }
+
     // TODO: allow output nodes
     auto node = lys_find_path(m_ctx.get(), nullptr, dataPath.c_str(), inputOutputNodes == InputOutputNodes::Output ? true : false);
 
@@ -456,6 +984,79 @@ Set<SchemaNode> Context::findXPath(const std::string& path) const
     return Set<SchemaNode>{set, m_ctx};
 }
 
+/**
+ * @brief Looks up a child of `parent` (or a top-level node if there's no `parent`) by its module and its name.
+ *
+ * Choices and cases are skipped, just like in a data path. For RPCs and actions, `inputOutputNodes` chooses between
+ * the input and the output children. Returns std::nullopt if there's no such node.
+ *
+ * This is a hash lookup if the schema index is enabled, see buildSchemaIndex().
+ *
+ * Wraps `lys_find_child`.
+ */
+std::optional<SchemaNode> Context::findChild(
+        const std::optional<SchemaNode>& parent,
+        const std::string& moduleName,
+        const std::string& name,
+        const InputOutputNodes inputOutputNodes) const
+{
+    auto parentNode = parent ? parent->m_node : nullptr;
+    auto indexed = withSchemaIndex(m_ctx, [&](const impl::schema_index& index) -> const lysc_node* {
+        auto it = index.children.find(childKey(parentNode, moduleName, name, inputOutputNodes == InputOutputNodes::Output));
+        return it == index.children.end() ? nullptr : it->second;
+    });
+    if (indexed) {
+        return SchemaNode{indexed, m_ctx};
+    }
+
+    auto module = ly_ctx_get_module_implemented(m_ctx.get(), moduleName.c_str());
+    if (!module) {
+        return std::nullopt;
+    }
+    auto node = lys_find_child(parentNode, module, name.c_str(), 0, 0, inputOutputNodes == InputOutputNodes::Output ? LYS_GETNEXT_OUTPUT : 0);
+    if (!node) {
+        return std::nullopt;
+    }
+    return SchemaNode{node, m_ctx};
+}
+
+/**
+ * @brief Turns on the schema index for faster findPath() and findChild().
+ *
+ * The index hashes the data paths of all schema nodes of all implemented modules, and the (parent, module, name) of
+ * each of them, so that these lookups no longer parse paths or walk the schema. Lookups which are not in the index
+ * (e.g., paths with predicates or with redundant prefixes) still work, they are just not faster.
+ *
+ * The index is built right away. It is dropped whenever the schema changes (e.g., a module is loaded or implemented,
+ * or the set of enabled features changes), and built again on the next lookup. Once the schema is locked (see
+ * lockSchema()), lookups can be done concurrently from many threads.
+ */
+void Context::buildSchemaIndex() const
+{
+    auto state = impl::contextState(m_ctx);
+    state->schemaIndexEnabled = true;
+    std::unique_lock lock{state->schemaIndexMutex};
+    state->schemaIndex = buildIndex(m_ctx.get());
+}
+
+/**
+ * @brief Checks that an XPath expression is valid in this context, e.g., when it comes from a configuration file.
+ *
+ * Throws if the expression is not valid. The resulting object can be passed to DataNode::findXPath and
+ * libyang::findXPathAt instead of a string. Nothing is compiled or cached, each search evaluates the expression again.
+ *
+ * Wraps `lys_find_xpath_atoms`.
+ */
+CheckedXPath Context::checkXPath(const std::string& xpath) const
+{
+    ly_set* set;
+    auto err = lys_find_xpath_atoms(m_ctx.get(), nullptr, xpath.c_str(), 0, &set);
+    throwIfError(err, "Context::checkXPath: invalid XPath '"s + xpath + "'");
+    ly_set_free(set, nullptr);
+
+    return CheckedXPath{std::make_shared<const std::string>(xpath), m_ctx};
+}
+
 /**
  * @brief Retrieves module from the context.
  *
@@ -520,6 +1121,8 @@ std::optional<Module> Context::getModuleLatest(const std::string& name) const
  */
 Module Context::loadModule(const std::string& name, const std::optional<std::string>& revision, const std::vector<std::string>& features) const
 {
+    impl::throwIfSchemaLocked(m_ctx, "Context::loadModule");
+    impl::schemaChanged(m_ctx);
     auto mod = ly_ctx_load_module(m_ctx.get(), name.c_str(), revision ? revision->c_str() : nullptr, toCStringArray(features).data());
 
     if (!mod) {
@@ -529,6 +1132,197 @@ Module Context::loadModule(const std::string& name, const std::optional<std::str
     return Module{mod, m_ctx};
 }
 
+namespace {
+/**
+ * @brief The sources fetched by Context::loadModules, and the module callback which was registered before.
+ */
+struct prefetched_modules {
+    const std::vector<ModuleRequest>& requests;
+    std::vector<std::optional<ModuleInfo>> sources;
+    ly_module_imp_clb previous;
+    void* previousData;
+};
+
+LY_ERR impl_prefetchedCallback(const char* modName,
+                               const char* modRev,
+                               const char* submodName,
+                               const char* submodRev,
+                               void* userData,
+                               LYS_INFORMAT* format,
+                               const char** moduleData,
+                               ly_module_imp_data_free_clb* moduleFree)
+{
+    auto& state = *reinterpret_cast<prefetched_modules*>(userData);
+    if (!submodName) {
+        for (std::size_t i = 0; i < state.requests.size(); ++i) {
+            const auto& request = state.requests[i];
+            if (!state.sources[i] || request.name != modName || (modRev && (!request.revision || *request.revision != modRev))) {
+                continue;
+            }
+            // The sources outlive the loading, so libyang can use them without a copy
+            *moduleData = state.sources[i]->data.c_str();
+            *format = utils::toLysInformat(state.sources[i]->format);
+            *moduleFree = nullptr;
+            return LY_SUCCESS;
+        }
+    }
+
+    if (state.previous) {
+        return state.previous(modName, modRev, submodName, submodRev, state.previousData, format, moduleData, moduleFree);
+    }
+    return LY_ENOT;
+}
+}
+
+/**
+ * @brief Loads several modules, fetching their sources in parallel, and compiles them all at once.
+ *
+ * With loadModule(), libyang asks the module callback (see registerModuleCallback()) for one missing module at a time,
+ * and it compiles the whole context after each of them. When the modules are fetched over the network, the delays of
+ * all fetches add up. This function first calls the callback for all `modules` which are not in the context yet, from
+ * up to `fetchThreads` threads at once (0 means one thread per module), so the callback must be thread-safe. The
+ * modules are then loaded in the given order from the fetched sources, and compiled in a single pass.
+ *
+ * Imports and includes which are not listed in `modules` are still fetched one by one, so list all modules that are
+ * known upfront, e.g., from a YANG library. If the callback returns std::nullopt for a module, or if no callback is
+ * registered, libyang looks for the module in the search directories as usual. An exception thrown by the callback is
+ * propagated once all fetches have finished, and no module is loaded in that case.
+ *
+ * If compiling is deferred already, via ContextOptions::ExplicitCompile or a ModuleBatch, the modules are not compiled
+ * here, this is left to whoever deferred it.
+ *
+ * Wraps `ly_ctx_load_module` and `ly_ctx_compile`.
+ */
+std::vector<Module> Context::loadModules(const std::vector<ModuleRequest>& modules, const std::size_t fetchThreads) const
+{
+    impl::throwIfSchemaLocked(m_ctx, "Context::loadModules");
+    auto state = impl::contextState(m_ctx);
+
+    prefetched_modules prefetched{modules, std::vector<std::optional<ModuleInfo>>(modules.size()), nullptr, nullptr};
+    if (state->moduleCallback) {
+        std::vector<std::size_t> missing;
+        for (std::size_t i = 0; i < modules.size(); ++i) {
+            const auto& request = modules[i];
+            auto present = request.revision ? ly_ctx_get_module(m_ctx.get(), request.name.c_str(), request.revision->c_str())
+                                            : ly_ctx_get_module_latest(m_ctx.get(), request.name.c_str());
+            if (!present) {
+                missing.push_back(i);
+            }
+        }
+
+        impl::parallelFor(missing.size(), fetchThreads ? fetchThreads : missing.size(), [&](const std::size_t i) {
+            const auto& request = modules[missing[i]];
+            prefetched.sources[missing[i]] = state->moduleCallback(request.name, request.revision, std::nullopt, std::nullopt);
+        });
+    }
+
+    impl::schemaChanged(m_ctx);
+    const bool explicitCompile = ly_ctx_get_options(m_ctx.get()) & LY_CTX_EXPLICIT_COMPILE;
+    if (!explicitCompile) {
+        auto err = ly_ctx_set_options(m_ctx.get(), LY_CTX_EXPLICIT_COMPILE);
+        throwIfError(err, "Context::loadModules: can't defer the compilation");
+    }
+    prefetched.previous = ly_ctx_get_module_imp_clb(m_ctx.get(), &prefetched.previousData);
+    ly_ctx_set_module_imp_clb(m_ctx.get(), impl_prefetchedCallback, &prefetched);
+    auto restore = [&] {
+        ly_ctx_set_module_imp_clb(m_ctx.get(), prefetched.previous, prefetched.previousData);
+        if (!explicitCompile) {
+            ly_ctx_unset_options(m_ctx.get(), LY_CTX_EXPLICIT_COMPILE);
+        }
+    };
+
+    std::vector<lys_module*> loaded;
+    bool compiled = false;
+    try {
+        for (const auto& request : modules) {
+            auto mod = ly_ctx_load_module(m_ctx.get(), request.name.c_str(), request.revision ? request.revision->c_str() : nullptr, toCStringArray(request.features).data());
+            if (!mod) {
+                throw Error("Can't load module '"s + request.name + "'");
+            }
+            loaded.push_back(mod);
+        }
+
+        if (!explicitCompile) {
+            compiled = true;
+            auto err = ly_ctx_compile(m_ctx.get());
+            throwIfError(err, "Context::loadModules: can't compile the context");
+        }
+    } catch (...) {
+        if (!explicitCompile && !compiled) {
+            // the modules which were loaded before the failure are compiled, just like with loadModule()
+            ly_ctx_compile(m_ctx.get());
+        }
+        restore();
+        throw;
+    }
+    restore();
+
+    std::vector<Module> res;
+    for (auto mod : loaded) {
+        res.emplace_back(Module{mod, m_ctx});
+    }
+    return res;
+}
+
+/**
+ * @brief Starts deferring the compilation of the schema; see ModuleBatch for details.
+ */
+ModuleBatch Context::beginModuleBatch() const
+{
+    impl::throwIfSchemaLocked(m_ctx, "Context::beginModuleBatch");
+    return ModuleBatch{m_ctx};
+}
+
+ModuleBatch::ModuleBatch(std::shared_ptr<ly_ctx> ctx)
+    : m_ctx(std::move(ctx))
+{
+    auto state = impl::contextState(m_ctx);
+    if (state->moduleBatches == 0) {
+        state->moduleBatchCompiles = !(ly_ctx_get_options(m_ctx.get()) & LY_CTX_EXPLICIT_COMPILE);
+        if (state->moduleBatchCompiles) {
+            auto err = ly_ctx_set_options(m_ctx.get(), LY_CTX_EXPLICIT_COMPILE);
+            throwIfError(err, "Context::beginModuleBatch: can't defer the compilation");
+        }
+    }
+    ++state->moduleBatches;
+}
+
+ModuleBatch::ModuleBatch(ModuleBatch&&) noexcept = default;
+
+ModuleBatch::~ModuleBatch()
+{
+    try {
+        commit();
+    } catch (Error&) {
+        // Destructors must not throw, call commit() to find out whether the schema compiles
+    }
+}
+
+/**
+ * @brief Compiles all changes which were made since the outermost batch has started.
+ *
+ * Throws if the schema does not compile; libyang then reverts the changes which were not compiled yet. Further changes
+ * are no longer a part of this batch, they are compiled right away again.
+ *
+ * Wraps `ly_ctx_compile`.
+ */
+void ModuleBatch::commit()
+{
+    if (!m_ctx) {
+        return;
+    }
+    auto ctx = std::move(m_ctx);
+    auto state = impl::contextState(ctx);
+    if (--state->moduleBatches > 0 || !state->moduleBatchCompiles) {
+        return;
+    }
+
+    impl::schemaChanged(ctx);
+    auto err = ly_ctx_compile(ctx.get());
+    ly_ctx_unset_options(ctx.get(), LY_CTX_EXPLICIT_COMPILE);
+    throwIfError(err, "ModuleBatch::commit: can't compile the context");
+}
+
 /**
  * @brief Retrieves a vector of all loaded modules.
  *
@@ -605,39 +1399,366 @@ void Context::registerModuleCallback(std::function<ModuleCallback> callback)
     if (!callback) {
         throw std::logic_error("Context::registerModuleCallback: callback is empty.");
     }
+    impl::throwIfSchemaLocked(m_ctx, "Context::registerModuleCallback");
 
-    m_moduleCallback = std::move(callback);
-    ly_ctx_set_module_imp_clb(m_ctx.get(), impl_callback, &m_moduleCallback);
+    // The callback is shared by all copies of this Context, and it lives as long as the ly_ctx does
+    auto state = impl::contextState(m_ctx);
+    state->moduleCallback = std::move(callback);
+    ly_ctx_set_module_imp_clb(m_ctx.get(), impl_callback, &state->moduleCallback);
+}
+
+/**
+ * @brief Prevents any further changes of the schema, making the context safe to use from several threads at once.
+ *
+ * Once the schema is locked, modules can no longer be loaded, parsed or implemented, the search directories and the
+ * module callback cannot be changed, and all of these throw an Error. This is permanent, and it applies to all copies
+ * of this Context.
+ *
+ * After that, parseData(), parseOp(), newPath(), findPath(), findXPath() and the other functions which only read the
+ * schema can be called concurrently from many threads. The resulting data trees are independent, but each of them
+ * must still be used by one thread at a time (see DataNode::freeze() for sharing a tree). Errors are recorded by
+ * libyang for each thread separately, so getErrors() and cleanAllErrors() only see the errors of the calling thread.
+ *
+ * This also compiles any pending changes of contexts created with ContextOptions::ExplicitCompile. This function
+ * itself must not run concurrently with any other use of the context.
+ */
+void Context::lockSchema() const
+{
+    auto state = impl::contextState(m_ctx);
+    if (state->schemaLocked) {
+        return;
+    }
+    if (state->moduleBatches) {
+        throw Error{"Context::lockSchema: a ModuleBatch is still active"};
+    }
+
+    if (ly_ctx_get_options(m_ctx.get()) & LY_CTX_EXPLICIT_COMPILE) {
+        impl::schemaChanged(m_ctx);
+        auto err = ly_ctx_compile(m_ctx.get());
+        throwIfError(err, "Context::lockSchema: can't compile the context");
+    }
+
+    state->schemaLocked = true;
+}
+
+/**
+ * @brief Checks whether lockSchema() was called on this context or on any of its copies.
+ */
+bool Context::isSchemaLocked() const
+{
+    return impl::contextState(m_ctx)->schemaLocked;
+}
+
+/**
+ * @brief Starts or stops collecting the stats of this context, see stats().
+ *
+ * The stats are disabled by default. While they are disabled, nothing is measured and no SpanCallback is invoked. The
+ * setting applies to all copies of this Context and to all data trees which belong to it.
+ */
+void Context::enableStats(const bool enabled) const
+{
+    impl::contextState(m_ctx)->stats.enabled = enabled;
+}
+
+/**
+ * @brief Returns the counters and the cumulative timings which were collected since the stats were last reset.
+ *
+ * The operations are measured as a whole, including the libyang call and the bookkeeping of the wrappers. The
+ * counters are updated independently of each other, so a snapshot taken while other threads are busy need not be
+ * consistent across fields.
+ */
+ContextStats Context::stats() const
+{
+    const auto& stats = impl::contextState(m_ctx)->stats;
+    auto operation = [&stats](const StatsOperation operation) {
+        auto index = static_cast<std::size_t>(operation);
+        return OperationStats{
+            .calls = stats.calls[index].load(std::memory_order_relaxed),
+            .time = std::chrono::nanoseconds{stats.nanoseconds[index].load(std::memory_order_relaxed)},
+        };
+    };
+
+    return ContextStats{
+        .parseData = operation(StatsOperation::ParseData),
+        .parseOp = operation(StatsOperation::ParseOp),
+        .validate = operation(StatsOperation::Validate),
+        .print = operation(StatsOperation::Print),
+        .newPath = operation(StatsOperation::NewPath),
+        .findXPath = operation(StatsOperation::FindXPath),
+        .wrapperRegistrations = stats.wrapperRegistrations.load(std::memory_order_relaxed),
+        .invalidations = stats.invalidations.load(std::memory_order_relaxed),
+        .orphanFrees = stats.orphanFrees.load(std::memory_order_relaxed),
+    };
+}
+
+/**
+ * @brief Sets all counters of stats() to zero.
+ */
+void Context::resetStats() const
+{
+    auto& stats = impl::contextState(m_ctx)->stats;
+    for (auto& counter : stats.calls) {
+        counter = 0;
+    }
+    for (auto& counter : stats.nanoseconds) {
+        counter = 0;
+    }
+    stats.wrapperRegistrations = 0;
+    stats.invalidations = 0;
+    stats.orphanFrees = 0;
+}
+
+/**
+ * @brief Sets a callback which is invoked after each measured operation while the stats are enabled.
+ *
+ * The callback runs synchronously on the thread which performed the operation, so it should be quick, e.g., just
+ * hand the span over to a tracing library. It must not throw; exceptions are ignored. Pass an empty function to
+ * unregister.
+ */
+void Context::registerSpanCallback(std::function<SpanCallback> callback) const
+{
+    auto& stats = impl::contextState(m_ctx)->stats;
+    auto shared = callback ? std::make_shared<const std::function<SpanCallback>>(std::move(callback)) : nullptr;
+    std::lock_guard lock{stats.spanCallbackMutex};
+    stats.spanCallback = std::move(shared);
+}
+
+#ifdef LIBYANG_CPP_HAVE_PRINTED_CONTEXT
+namespace {
+/**
+ * @brief The header of a file written by Context::saveCompiled. The image itself starts at the next page boundary.
+ */
+struct CompiledImageHeader {
+    std::array<char, 8> magic;
+    uint32_t formatVersion;
+    std::array<uint32_t, 3> libyangVersion;
+    uint64_t imageOffset;
+    uint64_t imageSize;
+    /** @brief libyang stores raw pointers within the image, so it has to be mapped at the address it was printed to. */
+    uint64_t baseAddress;
+};
+
+constexpr std::array<char, 8> compiledImageMagic{'l', 'y', 'c', 'p', 'p', 'c', 't', 'x'};
+constexpr uint32_t compiledImageFormat = 1;
+
+[[noreturn]] void throwSystemError(const std::string& msg)
+{
+    throw Error{msg + ": " + std::strerror(errno)};
+}
+
+std::size_t roundUpToPage(const std::size_t size)
+{
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (size + page - 1) / page * page;
+}
+}
+#endif
+
+/**
+ * @brief Saves the compiled schema of this context into a file, which can be loaded by fromCompiled() later.
+ *
+ * The file is only usable with the same version of libyang. Requires a libyang which supports printed contexts.
+ *
+ * Wraps `ly_ctx_compiled_print`.
+ */
+void Context::saveCompiled(const std::filesystem::path& path) const
+{
+#ifdef LIBYANG_CPP_HAVE_PRINTED_CONTEXT
+    int size;
+    auto err = ly_ctx_compiled_size(m_ctx.get(), &size);
+    throwIfError(err, "Context::saveCompiled: can't compute the size of the context");
+
+    // libyang prints into memory which it then refers to by absolute addresses. Print into fresh pages so that
+    // fromCompiled() has a chance to map the image at the very same place in another process.
+    const auto mappingSize = roundUpToPage(size);
+    auto mem = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        throwSystemError("Context::saveCompiled: can't allocate memory for the image");
+    }
+    auto unmap = std::unique_ptr<void, std::function<void(void*)>>{mem, [mappingSize](void* ptr) { munmap(ptr, mappingSize); }};
+
+    void* end;
+    err = ly_ctx_compiled_print(m_ctx.get(), mem, &end);
+    throwIfError(err, "Context::saveCompiled: can't print the context");
+
+    const CompiledImageHeader header{
+        .magic = compiledImageMagic,
+        .formatVersion = compiledImageFormat,
+        .libyangVersion = {ly_version_so.major, ly_version_so.minor, ly_version_so.micro},
+        .imageOffset = roundUpToPage(sizeof(CompiledImageHeader)),
+        .imageSize = static_cast<uint64_t>(static_cast<const char*>(end) - static_cast<const char*>(mem)),
+        .baseAddress = reinterpret_cast<uintptr_t>(mem),
+    };
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(std::string(header.imageOffset - sizeof(header), '\0').data(), header.imageOffset - sizeof(header));
+    out.write(static_cast<const char*>(mem), header.imageSize);
+    out.close();
+    if (!out) {
+        throw Error{"Context::saveCompiled: can't write '" + path.string() + "'"};
+    }
+#else
+    (void)path;
+    throw Error{"Context::saveCompiled: this libyang does not support printed contexts"};
+#endif
+}
+
+/**
+ * @brief Loads a context which was saved by saveCompiled().
+ *
+ * The image is mapped read-only and shared with all other processes which load the same file, no modules are parsed
+ * or compiled. The resulting context cannot be modified, so its schema is locked (see lockSchema()).
+ *
+ * Wraps `ly_ctx_new_printed`.
+ */
+Context Context::fromCompiled(const std::filesystem::path& path)
+{
+#ifdef LIBYANG_CPP_HAVE_PRINTED_CONTEXT
+    const auto where = "Context::fromCompiled: '" + path.string() + "'";
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throwSystemError(where);
+    }
+    auto closeFd = std::unique_ptr<int, std::function<void(int*)>>{&fd, [](int* fd) { close(*fd); }};
+
+    CompiledImageHeader header;
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        throwSystemError(where);
+    }
+    if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) || header.magic != compiledImageMagic
+        || header.formatVersion != compiledImageFormat || header.imageOffset % sysconf(_SC_PAGESIZE)
+        || header.imageOffset + header.imageSize > static_cast<uint64_t>(st.st_size)) {
+        throw Error{where + " is not a compiled context image"};
+    }
+    if (header.libyangVersion != std::array<uint32_t, 3>{ly_version_so.major, ly_version_so.minor, ly_version_so.micro}) {
+        throw Error{where + " was saved by a different version of libyang"};
+    }
+
+    const auto mappingSize = roundUpToPage(header.imageSize);
+    auto base = reinterpret_cast<void*>(header.baseAddress);
+    auto mem = mmap(base, mappingSize, PROT_READ, MAP_PRIVATE | MAP_FIXED_NOREPLACE, fd, header.imageOffset);
+    if (mem == MAP_FAILED) {
+        throwSystemError(where + ": can't map the image");
+    }
+    if (mem != base) {
+        // Kernels older than 4.17 treat MAP_FIXED_NOREPLACE as a mere hint
+        munmap(mem, mappingSize);
+        throw Error{where + ": the address of the image is already in use"};
+    }
+
+    ly_ctx* ctx;
+    auto err = ly_ctx_new_printed(mem, &ctx);
+    if (err != LY_SUCCESS) {
+        munmap(mem, mappingSize);
+        throwError(err, where + ": can't load the context");
+    }
+
+    Context res{ctx, [mem, mappingSize](ly_ctx* ctx) {
+        ly_ctx_destroy(ctx);
+        munmap(mem, mappingSize);
+    }};
+    impl::contextState(res.m_ctx)->schemaLocked = true;
+    return res;
+#else
+    throw Error{"Context::fromCompiled: this libyang does not support printed contexts, can't load '" + path.string() + "'"};
+#endif
 }
 
 /**
  * Retrieves specific information about errors.
+ *
+ * libyang keeps the errors for each thread separately, this only returns those which were raised by the calling thread.
  */
 std::vector<ErrorInfo> Context::getErrors() const
 {
     std::vector<ErrorInfo> res;
 
-    auto errIt = ly_err_first(m_ctx.get());
-    while (errIt) {
-        res.push_back(ErrorInfo{
-            .appTag = errIt->apptag ? std::optional{errIt->apptag} : std::nullopt,
-            .level = utils::toLogLevel(errIt->level),
-            .message = errIt->msg,
-            .code = static_cast<ErrorCode>(errIt->err),
-            .dataPath = errIt->data_path ? std::optional{errIt->data_path} : std::nullopt,
-            .schemaPath = errIt->schema_path ? std::optional{errIt->schema_path} : std::nullopt,
-            .line = errIt->line,
-            .validationCode = utils::toValidationErrorCode(errIt->vecode)
-        });
-
-        errIt = errIt->next;
+    for (auto errIt = ly_err_first(m_ctx.get()); errIt; errIt = errIt->next) {
+        res.push_back(errorInfoOf(errIt));
     }
 
     return res;
 }
 
 /**
- * @brief Clears up all errors within the context.
+ * @brief Returns the errors of the calling thread without copying them.
+ *
+ * Unlike getErrors(), this does not allocate. The views are valid until the errors are cleaned, e.g., by
+ * cleanAllErrors().
+ */
+ErrorViews Context::errorViews() const
+{
+    return ErrorViews{ly_err_first(m_ctx.get())};
+}
+
+/**
+ * @brief Returns the code of the last error of the calling thread, or ErrorCode::Success if there are no errors.
+ *
+ * Wraps `ly_err_last`.
+ */
+ErrorCode Context::lastErrorCode() const
+{
+    auto err = ly_err_last(m_ctx.get());
+    return err ? static_cast<ErrorCode>(err->err) : ErrorCode::Success;
+}
+
+ErrorViews::ErrorViews(const ly_err_item* first)
+    : m_first(first)
+{
+}
+
+ErrorViews::iterator ErrorViews::begin() const
+{
+    return iterator{m_first};
+}
+
+ErrorViews::iterator ErrorViews::end() const
+{
+    return iterator{};
+}
+
+bool ErrorViews::empty() const
+{
+    return !m_first;
+}
+
+ErrorViews::iterator::iterator(const ly_err_item* item)
+    : m_item(item)
+{
+}
+
+ErrorView ErrorViews::iterator::operator*() const
+{
+    auto optionalView = [](const char* str) { return str ? std::optional<std::string_view>{str} : std::nullopt; };
+    return ErrorView{
+        .level = utils::toLogLevel(m_item->level),
+        .code = static_cast<ErrorCode>(m_item->err),
+        .validationCode = utils::toValidationErrorCode(m_item->vecode),
+        .message = m_item->msg ? m_item->msg : "",
+        .appTag = optionalView(m_item->apptag),
+        .dataPath = optionalView(m_item->data_path),
+        .schemaPath = optionalView(m_item->schema_path),
+        .line = m_item->line,
+    };
+}
+
+ErrorViews::iterator& ErrorViews::iterator::operator++()
+{
+    m_item = m_item->next;
+    return *this;
+}
+
+ErrorViews::iterator ErrorViews::iterator::operator++(int)
+{
+    auto copy = *this;
+    ++*this;
+    return copy;
+}
+
+/**
+ * @brief Clears up all errors of the calling thread within the context.
  *
  * Wraps `ly_err_clean`.
  */
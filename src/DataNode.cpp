@@ -6,7 +6,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
 */
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <libyang-cpp/Collection.hpp>
 #include <libyang-cpp/DataNode.hpp>
@@ -14,25 +17,80 @@
 #include <libyang-cpp/Utils.hpp>
 #include <libyang/libyang.h>
 #include <libyang/tree_data.h>
+#include <mutex>
+#include <ostream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include "libyang-cpp/Module.hpp"
+#include "utils/arena.hpp"
+#include "utils/context.hpp"
+#include "utils/data_file.hpp"
 #include "utils/deleters.hpp"
 #include "utils/enum.hpp"
 #include "utils/newPath.hpp"
+#include "utils/parallel.hpp"
 #include "utils/ref_count.hpp"
+#include "utils/value.hpp"
 
 #ifdef _MSC_VER
 #  define __builtin_unreachable() __assume(0)
 #endif
 
+namespace {
+/**
+ * @brief State of DataNode::print with a callback sink, an exception thrown by the sink is stashed until it can be propagated.
+ */
+struct PrintSink {
+    const std::function<void(std::string_view)>& sink;
+    std::exception_ptr exception;
+};
+}
+
+extern "C" {
+static ssize_t libyang_cpp_print_ostream_cb(void* user_data, const void* buf, size_t count)
+{
+    auto& out = *reinterpret_cast<std::ostream*>(user_data);
+    out.write(reinterpret_cast<const char*>(buf), static_cast<std::streamsize>(count));
+    return out ? static_cast<ssize_t>(count) : -1;
+}
+
+static ssize_t libyang_cpp_print_sink_cb(void* user_data, const void* buf, size_t count)
+{
+    auto& state = *reinterpret_cast<PrintSink*>(user_data);
+    try {
+        state.sink(std::string_view{reinterpret_cast<const char*>(buf), count});
+    } catch (...) {
+        // Exceptions must not propagate through libyang
+        state.exception = std::current_exception();
+        return -1;
+    }
+    return static_cast<ssize_t>(count);
+}
+}
+
 namespace libyang {
+namespace {
+std::string nodePath(const lyd_node* node)
+{
+    // TODO: handle all path types, not just LYD_PATH_STD
+    auto strDeleter = std::unique_ptr<char, deleter_free_t>(lyd_path(node, LYD_PATH_STD, nullptr, 0));
+    if (!strDeleter) {
+        throw std::bad_alloc();
+    }
+
+    return strDeleter.get();
+}
+}
+
 /**
  * @brief Wraps a completely new tree. Used only internally.
  */
 DataNode::DataNode(lyd_node* node, std::shared_ptr<ly_ctx> ctx)
     : m_node(node)
-    , m_refs(std::make_shared<internal_refcount>(ctx))
+    , m_refs(impl::makeShared<internal_refcount>(ctx))
 {
     registerRef();
 }
@@ -69,6 +127,19 @@ DataNode::DataNode(const DataNode& other)
     registerRef();
 }
 
+/**
+ * @brief Takes over the wrapped node and its registration from `other`, which no longer refers to anything.
+ */
+DataNode::DataNode(DataNode&& other) noexcept
+    : m_node(std::exchange(other.m_node, nullptr))
+    , m_refs(std::move(other.m_refs))
+{
+    if (m_refs) {
+        auto lock = impl::lockIfFrozen(m_refs.get());
+        m_refs->nodes.replace(&other, this);
+    }
+}
+
 DataNode& DataNode::operator=(const DataNode& other)
 {
     if (this == &other) {
@@ -83,16 +154,36 @@ DataNode& DataNode::operator=(const DataNode& other)
     return *this;
 }
 
+DataNode& DataNode::operator=(DataNode&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    unregisterRef();
+    freeIfNoRefs();
+    this->m_node = std::exchange(other.m_node, nullptr);
+    this->m_refs = std::move(other.m_refs);
+    if (m_refs) {
+        auto lock = impl::lockIfFrozen(m_refs.get());
+        m_refs->nodes.replace(&other, this);
+    }
+    return *this;
+}
+
 void DataNode::registerRef()
 {
     if (m_refs) {
-        m_refs->nodes.emplace(this);
+        auto lock = impl::lockIfFrozen(m_refs.get());
+        m_refs->nodes.insert(this);
+        impl::countStat(m_refs->stats, &impl::context_stats::wrapperRegistrations);
     }
 }
 
 void DataNode::unregisterRef()
 {
     if (m_refs) {
+        auto lock = impl::lockIfFrozen(m_refs.get());
         m_refs->nodes.erase(this);
     }
 }
@@ -103,7 +194,18 @@ void DataNode::freeIfNoRefs()
         return;
     }
 
-    if (m_refs->nodes.size() == 0) {
+    if (m_refs->isFrozen()) {
+        // The FrozenTree keeps a reference to the tree
+        return;
+    }
+
+    if (m_refs->nodes.empty()) {
+        if (m_refs->batch) {
+            // Parts of this tree might have been moved elsewhere, only the commit can decide what to free.
+            m_refs->batch->orphanCandidates.emplace_back(m_node);
+            return;
+        }
+
         for (const auto& set : m_refs->dataSets) {
             set->invalidate();
         }
@@ -187,23 +289,102 @@ std::optional<DataNode> DataNode::parent() const
 /**
  * @brief Prints the tree into a string.
  * @param format Format of the output string.
+ * @return The printed data, or std::nullopt if there was nothing to print.
+ *
+ * The output is appended directly into the resulting string. Use DataNode::print for writing large trees without
+ * holding the whole serialized form in memory.
  *
- * Wraps `lyd_print_mem`.
+ * Wraps `lyd_print_clb`.
  */
 std::optional<std::string> DataNode::printStr(const DataFormat format, const PrintFlags flags) const
 {
-    char* str;
-    std::optional<std::string> res;
-    auto err = lyd_print_mem(&str, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    std::string str;
+    auto err = lyd_print_clb(&libyang_cpp_out_string_cb, &str, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
     throwIfError(err, "DataNode::printStr");
-    if (!str) {
+    if (str.empty()) {
         return std::nullopt;
     }
 
-    auto strDeleter = std::unique_ptr<char, deleter_free_t>(str);
     return str;
 }
 
+/**
+ * @brief Prints the tree into an output stream.
+ *
+ * The data are written in chunks as they are serialized. Throws if the stream enters a failed state.
+ *
+ * Wraps `lyd_print_clb`.
+ */
+void DataNode::print(std::ostream& out, const DataFormat format, const PrintFlags flags) const
+{
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    auto err = lyd_print_clb(&libyang_cpp_print_ostream_cb, &out, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    throwIfError(err, "DataNode::print");
+}
+
+/**
+ * @brief Prints the tree into a file descriptor.
+ *
+ * The file descriptor is not closed.
+ *
+ * Wraps `lyd_print_fd`.
+ */
+void DataNode::print(const int fd, const DataFormat format, const PrintFlags flags) const
+{
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    auto err = lyd_print_fd(fd, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    throwIfError(err, "DataNode::print");
+}
+
+/**
+ * @brief Prints the tree into a file. The file is overwritten if it already exists.
+ *
+ * Wraps `lyd_print_path`.
+ */
+void DataNode::print(const std::filesystem::path& file, const DataFormat format, const PrintFlags flags) const
+{
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    auto err = lyd_print_path(PATH_TO_LY_STRING(file), m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    throwIfError(err, "DataNode::print");
+}
+
+/**
+ * @brief Prints the tree into a file, optionally compressing it. The file is overwritten if it already exists.
+ *
+ * The output is collected into chunks of `fileOpts.bufferSize` before they are compressed and written, so that
+ * printing a large tree does not end up in many small writes. Support for gzip and zstd is optional at build time,
+ * requesting an unsupported compression throws.
+ *
+ * Wraps `lyd_print_clb`.
+ */
+void DataNode::print(const std::filesystem::path& file, const DataFormat format, const PrintFlags flags, const DataFileOptions& fileOpts) const
+{
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    impl::writeDataFile(file, fileOpts, [&](ly_write_clb writeClb, void* userData) {
+        return lyd_print_clb(writeClb, userData, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    }, "DataNode::print");
+}
+
+/**
+ * @brief Prints the tree by passing the output to a callback in chunks.
+ *
+ * The `sink` is invoked for each chunk of the output as soon as it is serialized. The chunk is only valid during the
+ * invocation. Printing stops if the `sink` throws, and the exception is propagated to the caller.
+ *
+ * Wraps `lyd_print_clb`.
+ */
+void DataNode::print(const std::function<void(std::string_view)>& sink, const DataFormat format, const PrintFlags flags) const
+{
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::Print};
+    PrintSink state{sink, nullptr};
+    auto err = lyd_print_clb(&libyang_cpp_print_sink_cb, &state, m_node, utils::toLydFormat(format), utils::toPrintFlags(flags));
+    if (state.exception) {
+        std::rethrow_exception(state.exception);
+    }
+    throwIfError(err, "DataNode::print");
+}
+
 /**
  * @brief Returns a node specified by `path`.
  * If the node is not found, returns std::nullopt.
@@ -216,18 +397,37 @@ std::optional<std::string> DataNode::printStr(const DataFormat format, const Pri
  * Wraps `lyd_find_path`.
  */
 std::optional<DataNode> DataNode::findPath(const std::string& path, const InputOutputNodes inputOutputNodes) const
+{
+    auto res = tryFindPath(path, inputOutputNodes);
+    if (!res) {
+        throwError(static_cast<int>(res.error()), "Error in DataNode::findPath");
+    }
+    return *std::move(res);
+}
+
+/**
+ * @brief Returns a node specified by `path`, reports errors via the return value instead of throwing.
+ *
+ * This is meant for hot paths where an invalid `path` is expected, e.g., because it comes from a client. The details
+ * of the error are available through Context::errorViews().
+ *
+ * @return std::nullopt if the node was not found, the ErrorCode if the search has failed.
+ *
+ * Wraps `lyd_find_path`.
+ */
+Expected<std::optional<DataNode>> DataNode::tryFindPath(const std::string& path, const InputOutputNodes inputOutputNodes) const
 {
     lyd_node* node;
     auto err = lyd_find_path(m_node, path.c_str(), inputOutputNodes == InputOutputNodes::Output ? true : false, &node);
 
     switch (err) {
     case LY_SUCCESS:
-        return DataNode{node, m_refs};
+        return std::optional{DataNode{node, m_refs}};
     case LY_ENOTFOUND:
     case LY_EINCOMPLETE: // TODO: is this really important?
-        return std::nullopt;
+        return std::optional<DataNode>{std::nullopt};
     default:
-        throwError(err, "Error in DataNode::findPath");
+        return static_cast<ErrorCode>(err);
     }
 }
 
@@ -238,13 +438,7 @@ std::optional<DataNode> DataNode::findPath(const std::string& path, const InputO
  */
 std::string DataNode::path() const
 {
-    // TODO: handle all path types, not just LYD_PATH_STD
-    auto strDeleter = std::unique_ptr<char, deleter_free_t>(lyd_path(m_node, LYD_PATH_STD, nullptr, 0));
-    if (!strDeleter) {
-        throw std::bad_alloc();
-    }
-
-    return strDeleter.get();
+    return nodePath(m_node);
 }
 
 /**
@@ -261,9 +455,30 @@ std::string DataNode::path() const
  */
 std::optional<DataNode> DataNode::newPath(const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options) const
 {
+    throwIfFrozen("DataNode::newPath");
     return impl::newPath(m_node, nullptr, m_refs, path, value, options);
 }
 
+/**
+ * @brief Creates many nodes at once, changing this tree.
+ *
+ * This is equivalent to calling newPath() for each of the nodes in order, but it is much faster when consecutive paths
+ * share their beginning, e.g., when they are sorted. Each path is only resolved from the deepest node which it has in
+ * common with the previous path, and no DataNode instances are created for the new nodes.
+ *
+ * If creating any of the nodes fails, the nodes created so far are kept in the tree.
+ *
+ * @param nodes The paths of the new nodes along with their values.
+ * @param options Options that change the behavior of this method, these apply to all of the nodes.
+ *
+ * Wraps `lyd_new_path2`.
+ */
+void DataNode::newPaths(std::span<const PathValue> nodes, const std::optional<CreationOptions> options) const
+{
+    throwIfFrozen("DataNode::newPaths");
+    impl::newPaths(m_node, nullptr, m_refs.get(), nodes, options);
+}
+
 /**
  * @brief Creates a new node with the supplied path, changing this tree.
  *
@@ -278,6 +493,7 @@ std::optional<DataNode> DataNode::newPath(const std::string& path, const std::op
  */
 CreatedNodes DataNode::newPath2(const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options) const
 {
+    throwIfFrozen("DataNode::newPath2");
     return impl::newPath2(m_node, nullptr, m_refs, path, value ? value->c_str() : nullptr, AnydataValueType::String, options);
 }
 
@@ -295,6 +511,7 @@ CreatedNodes DataNode::newPath2(const std::string& path, const std::optional<std
  */
 CreatedNodes DataNode::newPath2(const std::string& path, libyang::JSON json, const std::optional<CreationOptions> options) const
 {
+    throwIfFrozen("DataNode::newPath2");
     return impl::newPath2(m_node, nullptr, m_refs, path, json.content.data(), AnydataValueType::JSON, options);
 }
 
@@ -310,6 +527,7 @@ CreatedNodes DataNode::newPath2(const std::string& path, libyang::JSON json, con
  */
 CreatedNodes DataNode::newPath2(const std::string& path, libyang::XML xml, const std::optional<CreationOptions> options) const
 {
+    throwIfFrozen("DataNode::newPath2");
     return impl::newPath2(m_node, nullptr, m_refs, path, xml.content.data(), AnydataValueType::XML, options);
 }
 
@@ -324,7 +542,9 @@ CreatedNodes DataNode::newPath2(const std::string& path, libyang::XML xml, const
  */
 std::optional<DataNode> DataNode::newExtPath(const ExtensionInstance& ext, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options) const
 {
+    throwIfFrozen("DataNode::newExtPath");
     auto out = impl::newExtPath(m_node, ext.m_instance, nullptr, path, value, options);
+    recordChange();
 
     if (!out) {
         throw std::logic_error("Expected a new node to be created");
@@ -393,7 +613,23 @@ DataNodeAny DataNode::asAny() const
  */
 ParsedOp DataNode::parseOp(const std::string& input, const DataFormat format, const OperationType opType) const
 {
-    auto in = wrap_ly_in_new_memory(input);
+    return parseOp(asNulTerminatedBytes(input), format, opType);
+}
+
+/**
+ * @brief Parses YANG data from a memory buffer into an operation data tree.
+ *
+ * See Context::parseData for when the buffer is parsed in place.
+ *
+ * Wraps `lyd_parse_op`.
+ */
+ParsedOp DataNode::parseOp(std::span<const std::byte> input, const DataFormat format, const OperationType opType) const
+{
+    throwIfFrozen("DataNode::parseOp");
+    recordChange();
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::ParseOp};
+    std::string storage;
+    auto in = wrap_ly_in_new_memory(input, storage);
 
     switch (opType) {
     case OperationType::ReplyNetconf:
@@ -402,9 +638,13 @@ ParsedOp DataNode::parseOp(const std::string& input, const DataFormat format, co
         lyd_node* op = nullptr;
         lyd_node* tree = nullptr;
         auto err = lyd_parse_op(m_node->schema->module->ctx, m_node, in.get(), utils::toLydFormat(format), utils::toOpType(opType), &tree, nullptr);
+        // The new trees belong to the same context as this one, so that they share its state
+        auto wrap = [this](lyd_node* node) {
+            return m_refs ? DataNode{node, m_refs->context} : libyang::wrapRawNode(node);
+        };
         ParsedOp res{
-            .tree = tree ? std::optional{libyang::wrapRawNode(tree)} : std::nullopt,
-            .op = op ? std::optional{libyang::wrapRawNode(op)} : std::nullopt
+            .tree = tree ? std::optional{wrap(tree)} : std::nullopt,
+            .op = op ? std::optional{wrap(op)} : std::nullopt
         };
         throwIfError(err, "Can't parse into operation data tree");
         return res;
@@ -426,6 +666,8 @@ ParsedOp DataNode::parseOp(const std::string& input, const DataFormat format, co
  */
 AnydataValue DataNodeAny::releaseValue()
 {
+    throwIfFrozen("DataNodeAny::releaseValue");
+    recordChange();
     auto any = reinterpret_cast<lyd_node_any*>(m_node);
     switch (any->value_type) {
     case LYD_ANYDATA_DATATREE: {
@@ -468,18 +710,84 @@ bool DataNode::operator==(const DataNode& node) const
 }
 
 namespace {
-bool isDescendantOrEqual(lyd_node* node, lyd_node* target)
-{
-    do {
-        if (node == target) {
-            return true;
+/**
+ * @brief Decides whether nodes lie within any of the given subtrees.
+ *
+ * The answer is remembered for every node that is visited on the way up to the root, so that classifying all wrappers
+ * of a tree costs roughly one hash lookup per wrapper instead of a parent-chain walk per wrapper and subtree.
+ */
+class SubtreeMembership {
+public:
+    explicit SubtreeMembership(const std::vector<const lyd_node*>& roots)
+    {
+        for (auto root : roots) {
+            m_known.emplace(root, true);
         }
+    }
 
-        node = reinterpret_cast<lyd_node*>(node->parent);
-    } while (node);
+    bool contains(const lyd_node* node)
+    {
+        auto res = false;
+        m_path.clear();
+        for (; node; node = reinterpret_cast<const lyd_node*>(node->parent)) {
+            if (auto it = m_known.find(node); it != m_known.end()) {
+                res = it->second;
+                break;
+            }
+            m_path.emplace_back(node);
+        }
 
-    return false;
-}
+        for (auto visited : m_path) {
+            m_known.emplace(visited, res);
+        }
+        return res;
+    }
+
+private:
+    std::unordered_map<const lyd_node*, bool> m_known;
+    std::vector<const lyd_node*> m_path;
+};
+
+/**
+ * @brief Finds the forest (a set of top-level siblings) which nodes belong to.
+ *
+ * A forest is identified by its first top-level sibling. Every visited node is remembered, so that looking up many
+ * nodes of the same forest costs roughly one hash lookup per node.
+ */
+class ForestLookup {
+public:
+    const lyd_node* forestOf(const lyd_node* node)
+    {
+        const lyd_node* res = nullptr;
+        m_path.clear();
+        while (true) {
+            if (auto it = m_known.find(node); it != m_known.end()) {
+                res = it->second;
+                break;
+            }
+            m_path.emplace_back(node);
+
+            if (node->parent) {
+                node = reinterpret_cast<const lyd_node*>(node->parent);
+            } else if (!node->prev->next) {
+                // The first top-level sibling, its `prev` points to the last one
+                res = node;
+                break;
+            } else {
+                node = node->prev;
+            }
+        }
+
+        for (auto visited : m_path) {
+            m_known.emplace(visited, res);
+        }
+        return res;
+    }
+
+private:
+    std::unordered_map<const lyd_node*, const lyd_node*> m_known;
+    std::vector<const lyd_node*> m_path;
+};
 }
 
 /**
@@ -514,6 +822,159 @@ DataNode DataNode::duplicateWithSiblings(const std::optional<DuplicationOptions>
     return DataNode{dup, m_refs->context};
 }
 
+/**
+ * @brief Creates a copy of this DataNode directly as a child of `parent`.
+ *
+ * This is cheaper than duplicating a node and inserting it afterwards, because the wrappers of the copy are created in
+ * the tree of `parent` right away. With DuplicationOptions::WithParents, `parent` is where the copied parents of this
+ * node are connected.
+ *
+ * @return The duplicated node.
+ *
+ * Wraps `lyd_dup_single`.
+ */
+DataNode DataNode::duplicate(const std::optional<DuplicationOptions> opts, const DataNode& parent) const
+{
+    parent.throwIfFrozen("DataNode::duplicate");
+    lyd_node* dup;
+    auto ret = lyd_dup_single(m_node, reinterpret_cast<lyd_node_inner*>(parent.m_node), opts ? utils::toDuplicationOptions(*opts) : 0, &dup);
+
+    throwIfError(ret, "DataNode::duplicate:");
+    parent.recordChange();
+
+    return DataNode{dup, parent.m_refs};
+}
+
+/**
+ * @brief Creates a copy of this DataNode and its following siblings directly as children of `parent`.
+ *
+ * See the `duplicate` overload with a `parent` for details.
+ *
+ * @return The first duplicated node.
+ *
+ * Wraps `lyd_dup_siblings`.
+ */
+DataNode DataNode::duplicateWithSiblings(const std::optional<DuplicationOptions> opts, const DataNode& parent) const
+{
+    parent.throwIfFrozen("DataNode::duplicateWithSiblings");
+    lyd_node* dup;
+    auto ret = lyd_dup_siblings(m_node, reinterpret_cast<lyd_node_inner*>(parent.m_node), opts ? utils::toDuplicationOptions(*opts) : 0, &dup);
+
+    throwIfError(ret, "DataNode::duplicateWithSiblings:");
+    parent.recordChange();
+
+    return DataNode{dup, parent.m_refs};
+}
+
+namespace {
+/**
+ * @brief Duplicates `node` and those of its descendants which are within `depth` and whose schema is `accepted`.
+ */
+template <typename Accepts>
+LY_ERR duplicateFiltered(const lyd_node* node, lyd_node_inner* parent, const uint32_t options, const std::optional<uint32_t> depth, const Accepts& accepted, lyd_node** dup)
+{
+    // list keys are always copied together with the list
+    if (auto ret = lyd_dup_single(node, parent, options & ~LYD_DUP_RECURSIVE, dup); ret != LY_SUCCESS) {
+        return ret;
+    }
+    if (depth == 0u) {
+        return LY_SUCCESS;
+    }
+
+    for (auto child = lyd_child(node); child; child = child->next) {
+        if (child->schema && (lysc_is_key(child->schema) || !accepted(child->schema))) {
+            continue;
+        }
+        lyd_node* childDup;
+        auto ret = duplicateFiltered(child, reinterpret_cast<lyd_node_inner*>(*dup), options & ~LYD_DUP_WITH_PARENTS,
+                depth ? std::optional{*depth - 1} : std::nullopt, accepted, &childDup);
+        if (ret != LY_SUCCESS) {
+            return ret;
+        }
+    }
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Runs duplicateFiltered(), and frees everything which it has created if it fails or if `accepted` throws.
+ */
+template <typename Accepts>
+lyd_node* duplicateFilteredOrThrow(const lyd_node* node, lyd_node_inner* parent, const uint32_t options, const std::optional<uint32_t> depth, const Accepts& accepted)
+{
+    lyd_node* dup = nullptr;
+    auto freeCreated = [&] {
+        if (!dup) {
+            return;
+        }
+        // with DuplicationOptions::WithParents, the copies of the parents have to go as well
+        auto top = dup;
+        for (auto up = lyd_parent(top); up && up != reinterpret_cast<lyd_node*>(parent); up = lyd_parent(up)) {
+            top = up;
+        }
+        lyd_free_tree(top);
+    };
+
+    LY_ERR ret;
+    try {
+        ret = duplicateFiltered(node, parent, options, depth, accepted, &dup);
+    } catch (...) {
+        freeCreated();
+        throw;
+    }
+    if (ret != LY_SUCCESS) {
+        freeCreated();
+        throwError(ret, "DataNode::duplicatePartial:");
+    }
+    return dup;
+}
+}
+
+/**
+ * @brief Creates a copy of a part of the subtree of this DataNode.
+ *
+ * Only the descendants which are at most `depth` levels below this node are copied, and only those whose schema
+ * passes the `filter`. When a node does not pass, none of its descendants are copied. This node itself is always
+ * copied, and so are the keys of all copied list instances. Opaque nodes have no schema, they are copied whenever the
+ * depth allows.
+ *
+ * @param depth How many levels of descendants to copy, std::nullopt for no limit.
+ * @param filter Decides which nodes to copy, an empty function copies everything.
+ * @param opts DuplicationOptions::Recursive is implied.
+ * @return The duplicated node.
+ *
+ * Wraps `lyd_dup_single`.
+ */
+DataNode DataNode::duplicatePartial(const std::optional<uint32_t> depth, const std::function<bool(const SchemaNode&)>& filter, const std::optional<DuplicationOptions> opts) const
+{
+    auto accepted = [&filter, this](const lysc_node* schema) { return !filter || filter(SchemaNode{schema, m_refs->context}); };
+    auto dup = duplicateFilteredOrThrow(m_node, nullptr, opts ? utils::toDuplicationOptions(*opts) : 0, depth, accepted);
+
+    return DataNode{dup, m_refs->context};
+}
+
+/**
+ * @brief Creates a copy of a part of the subtree of this DataNode directly as a child of `parent`.
+ *
+ * See the other overload for the meaning of `depth` and `filter`, and DataNode::duplicate for the `parent`.
+ *
+ * @return The duplicated node.
+ *
+ * Wraps `lyd_dup_single`.
+ */
+DataNode DataNode::duplicatePartial(
+        const std::optional<uint32_t> depth,
+        const std::function<bool(const SchemaNode&)>& filter,
+        const std::optional<DuplicationOptions> opts,
+        const DataNode& parent) const
+{
+    parent.throwIfFrozen("DataNode::duplicatePartial");
+    auto accepted = [&filter, this](const lysc_node* schema) { return !filter || filter(SchemaNode{schema, m_refs->context}); };
+    auto dup = duplicateFilteredOrThrow(m_node, reinterpret_cast<lyd_node_inner*>(parent.m_node), opts ? utils::toDuplicationOptions(*opts) : 0, depth, accepted);
+    parent.recordChange();
+
+    return DataNode{dup, parent.m_refs};
+}
+
 enum class OperationScope {
     JustThisNode,
     AffectsFollowingSiblings,
@@ -533,13 +994,6 @@ enum class OperationScope {
 template <typename Operation, typename OperationScope>
 void handleLyTreeOperation(DataNode* affectedNode, Operation operation, OperationScope scope, std::shared_ptr<internal_refcount> newRefs)
 {
-    std::vector<DataNode*> wrappedSiblings{affectedNode};
-    if (scope == OperationScope::AffectsFollowingSiblings) {
-        auto fs = affectedNode->gatherReachableFollowingSiblings();
-        wrappedSiblings.reserve(fs.size() + 1 /* the original node */);
-        std::copy(fs.begin(), fs.end(), std::back_inserter(wrappedSiblings));
-    }
-
     auto oldRefs = affectedNode->m_refs;
 
     if (!oldRefs) {
@@ -575,61 +1029,106 @@ void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Operatio
         // and there's nothing that's being orphaned.
     }
 
+    if (auto batch = oldRefs->batch ? oldRefs->batch : newRefs ? newRefs->batch : nullptr) {
+        // Within a TreeEditBatch, nothing is freed and the wrappers are sorted out only when the batch is committed.
+        // Until then, it's enough to remember which trees might end up without any wrappers.
+        batch->join(oldRefs);
+        batch->join(newRefs);
+        batch->orphanCandidates.emplace_back(affectedNode->m_node);
+        if (oldTree) {
+            batch->orphanCandidates.emplace_back(oldTree);
+        }
+        operation();
+        return;
+    }
+
+    uint64_t invalidated = 0;
     if (oldRefs != newRefs) { // If the nodes already have the new refcounter, then there's nothing to do.
-        for (auto& node : wrappedSiblings) {
-            node->unregisterRef();
-            node->m_refs = newRefs;
-            node->registerRef();
-
-            // All references to this node and its children will need to have this new refcounter.
-            for (auto it = oldRefs->nodes.begin(); it != oldRefs->nodes.end(); /* nothing */) {
-                if (isDescendantOrEqual((*it)->m_node, node->m_node)) {
-                    // The child needs to be added to the new refcounter and removed from the old refcounter.
-                    (*it)->m_refs = node->m_refs;
-                    (*it)->registerRef();
-                    // Can't use unregisterRef, because I need the value from the erase method to continue the
-                    // iteration. FIXME: maybe unregisterRef can return that? doesn't make much sense tho.
-                    it = oldRefs->nodes.erase(it);
-                } else {
-                    it++;
-                }
+        // These are the roots of all subtrees which are going to be moved. Following siblings are always moved as a
+        // whole, regardless of whether they (or any of their descendants) are wrapped.
+        std::vector<const lyd_node*> roots{affectedNode->m_node};
+        if (scope == OperationScope::AffectsFollowingSiblings) {
+            for (auto sibling = affectedNode->m_node->next; sibling; sibling = sibling->next) {
+                roots.emplace_back(sibling);
+            }
+        }
+        SubtreeMembership affected{roots};
+
+        // All references to these nodes and their descendants will need to have the new refcounter. This is a single
+        // pass over all wrappers; the registry allows erasing the current element while iterating.
+        for (auto node : oldRefs->nodes) {
+            if (affected.contains(node->m_node)) {
+                node->unregisterRef();
+                node->m_refs = newRefs;
+                node->registerRef();
             }
+        }
 
-            // If we're updating a node that belongs to a collection, we need to invalidate it.
-            // For example:
-            //      A <- iterator starts here (that's (*it)->m_start)
-            //    |  |
-            //    B  C <- we're updating this one (that's m_node). The iterator's m_current might also be this node.
-            //
-            // We must invalidate the whole collection and all its iterators, because the iterators might point to the node
-            // being updated.
-            //
-            // If a collection is a descendant of currently updated node, we also invalidate it, because the whole
-            // subtree now has a different m_refs and it's difficult to keep track of that.
-            for (const auto& it : oldRefs->dataCollectionsDfs) {
-                if (isDescendantOrEqual(node->m_node, it->m_start) || isDescendantOrEqual(it->m_start, node->m_node)) {
-                    it->invalidate();
-                }
+        // If we're updating a node that belongs to a collection, we need to invalidate it.
+        // For example:
+        //      A <- iterator starts here (that's (*it)->m_start)
+        //    |  |
+        //    B  C <- we're updating this one (that's m_node). The iterator's m_current might also be this node.
+        //
+        // We must invalidate the whole collection and all its iterators, because the iterators might point to the node
+        // being updated. That's the case when the collection starts at one of the ancestors of the moved subtrees (all
+        // of them share the same parent).
+        //
+        // If a collection is a descendant of currently updated node, we also invalidate it, because the whole
+        // subtree now has a different m_refs and it's difficult to keep track of that.
+        std::vector<const lyd_node*> ancestors;
+        for (auto parent = reinterpret_cast<const lyd_node*>(affectedNode->m_node->parent); parent; parent = reinterpret_cast<const lyd_node*>(parent->parent)) {
+            ancestors.emplace_back(parent);
+        }
+        for (const auto& it : oldRefs->dataCollectionsDfs) {
+            if (affected.contains(it->m_start) || std::find(ancestors.begin(), ancestors.end(), it->m_start) != ancestors.end()) {
+                it->invalidate();
+                ++invalidated;
             }
+        }
 
-            // We need to invalidate all DataSets unconditionally, we can't be sure what's in them, potentially anything.
-            for (const auto& it : oldRefs->dataSets) {
+        // Sibling collections have to be invalidated when they start within the moved subtrees, or when they iterate
+        // over the siblings which are being moved.
+        for (const auto& it : oldRefs->dataCollectionsSibling) {
+            if (affected.contains(it->m_start) || it->m_start->parent == affectedNode->m_node->parent) {
                 it->invalidate();
+                ++invalidated;
             }
+        }
 
-            // Sibling collections also have to be unvalidated, in case we free something we hold an iterator to.
-            for (const auto& it : oldRefs->dataCollectionsSibling) {
+        // A DataSet can contain pretty much anything, so we have to check each of its nodes.
+        for (const auto& it : oldRefs->dataSets) {
+            if (it->m_valid && std::any_of(it->m_set->dnodes, it->m_set->dnodes + it->m_set->count, [&affected](const lyd_node* node) { return affected.contains(node); })) {
                 it->invalidate();
+                ++invalidated;
             }
         }
     }
 
     operation();
 
-    // If oldTree exists and we don't hold any references to it, we must also free it.
-    if (oldTree && oldRefs->nodes.size() == 0) {
+    // If oldTree exists and we don't hold any references to it, we must also free it. Whatever still refers to it has
+    // to be invalidated first.
+    if (oldTree && oldRefs->nodes.empty()) {
+        for (const auto& it : oldRefs->dataSets) {
+            it->invalidate();
+            ++invalidated;
+        }
+
+        for (const auto& it : oldRefs->dataCollectionsDfs) {
+            it->invalidate();
+            ++invalidated;
+        }
+
+        for (const auto& it : oldRefs->dataCollectionsSibling) {
+            it->invalidate();
+            ++invalidated;
+        }
+
         lyd_free_all(reinterpret_cast<lyd_node*>(oldTree));
+        impl::countStat(oldRefs->stats, &impl::context_stats::orphanFrees);
     }
+    impl::countStat(oldRefs->stats, &impl::context_stats::invalidations, invalidated);
 }
 
 /**
@@ -639,44 +1138,29 @@ void handleLyTreeOperation(DataNode* affectedNode, Operation operation, Operatio
  */
 void DataNode::unlink()
 {
+    throwIfFrozen("DataNode::unlink");
+    recordChange();
     handleLyTreeOperation(this, [this] () {
         lyd_unlink_tree(m_node);
-    }, OperationScope::JustThisNode, std::make_shared<internal_refcount>(m_refs ? m_refs->context : nullptr));
+    }, OperationScope::JustThisNode, impl::makeShared<internal_refcount>(m_refs ? m_refs->context : nullptr));
 }
 
 /**
- * @brief Gather all directly reachable instances of the C++ wrapper of all following siblings
+ * @brief Unlinks this node, together with all following siblings, creating a new tree.
  *
- * This is very different from "all following siblings"; only those nodes which have a libyang::DataNode already
- * instantiated (and reachable through the same reference_wrapper) are returned.
- * */
-std::vector<DataNode*> DataNode::gatherReachableFollowingSiblings()
+ * Wraps `lyd_unlink_siblings`.
+ */
+void DataNode::unlinkWithSiblings()
 {
-    std::vector<DataNode*> res;
-
-    if (!m_refs) {
-        return res;
-    }
-
-    auto sibling = m_node->next;
-    while (sibling) {
-        std::copy_if(m_refs->nodes.begin(), m_refs->nodes.end(), std::back_inserter(res), [&sibling](auto ref) { return ref->m_node == sibling; });
-        sibling = sibling->next;
+    throwIfFrozen("DataNode::unlinkWithSiblings");
+    if (m_refs) {
+        for (auto node = m_node; node; node = node->next) {
+            m_refs->touch(node);
+        }
     }
-
-    return res;
-}
-
-/**
- * @brief Unlinks this node, together with all following siblings, creating a new tree.
- *
- * Wraps `lyd_unlink_siblings`.
- */
-void DataNode::unlinkWithSiblings()
-{
     handleLyTreeOperation(this, [this] {
             lyd_unlink_siblings(m_node);
-    }, OperationScope::AffectsFollowingSiblings, std::make_shared<internal_refcount>(m_refs ? m_refs->context : nullptr));
+    }, OperationScope::AffectsFollowingSiblings, impl::makeShared<internal_refcount>(m_refs ? m_refs->context : nullptr));
 }
 
 /**
@@ -689,9 +1173,15 @@ void DataNode::unlinkWithSiblings()
  */
 void DataNode::insertChild(DataNode toInsert)
 {
+    throwIfFrozen("DataNode::insertChild");
+    toInsert.throwIfFrozen("DataNode::insertChild");
+    if (toInsert.m_node->parent) {
+        toInsert.recordChange();
+    }
     handleLyTreeOperation(&toInsert, [this, &toInsert] {
         lyd_insert_child(this->m_node, toInsert.m_node);
     }, toInsert.parent() ? OperationScope::JustThisNode : OperationScope::AffectsFollowingSiblings, m_refs);
+    recordChange();
 }
 
 /**
@@ -706,10 +1196,24 @@ void DataNode::insertChild(DataNode toInsert)
  */
 DataNode DataNode::insertSibling(DataNode toInsert)
 {
+    throwIfFrozen("DataNode::insertSibling");
+    toInsert.throwIfFrozen("DataNode::insertSibling");
+    const bool withSiblings = !toInsert.m_node->parent;
+    if (!withSiblings) {
+        toInsert.recordChange();
+    }
     lyd_node* firstSibling;
     handleLyTreeOperation(&toInsert, [this, &toInsert, &firstSibling] {
         lyd_insert_sibling(this->m_node, toInsert.m_node, &firstSibling);
     }, toInsert.parent() ? OperationScope::JustThisNode : OperationScope::AffectsFollowingSiblings, m_refs);
+    if (withSiblings && m_refs && !m_node->parent) {
+        // The inserted top-level nodes might belong to many modules, and they're now mixed with the original ones
+        for (auto node = firstSibling; node; node = node->next) {
+            m_refs->touch(node);
+        }
+    } else {
+        recordChange();
+    }
 
     return DataNode{m_node, m_refs};
 }
@@ -721,9 +1225,15 @@ DataNode DataNode::insertSibling(DataNode toInsert)
  */
 void DataNode::insertAfter(DataNode toInsert)
 {
+    throwIfFrozen("DataNode::insertAfter");
+    toInsert.throwIfFrozen("DataNode::insertAfter");
+    if (toInsert.m_node->parent) {
+        toInsert.recordChange();
+    }
     handleLyTreeOperation(&toInsert, [this, &toInsert] {
         lyd_insert_after(this->m_node, toInsert.m_node);
     }, OperationScope::JustThisNode, m_refs);
+    toInsert.recordChange();
 }
 
 /**
@@ -733,9 +1243,15 @@ void DataNode::insertAfter(DataNode toInsert)
  */
 void DataNode::insertBefore(DataNode toInsert)
 {
+    throwIfFrozen("DataNode::insertBefore");
+    toInsert.throwIfFrozen("DataNode::insertBefore");
+    if (toInsert.m_node->parent) {
+        toInsert.recordChange();
+    }
     handleLyTreeOperation(&toInsert, [this, &toInsert] {
         lyd_insert_before(this->m_node, toInsert.m_node);
     }, OperationScope::JustThisNode, m_refs);
+    toInsert.recordChange();
 }
 
 /**
@@ -747,11 +1263,590 @@ void DataNode::insertBefore(DataNode toInsert)
  */
 void DataNode::merge(DataNode toMerge)
 {
+    throwIfFrozen("DataNode::merge");
+
     // No memory management needed, the original tree is left untouched. The m_refs is not shared between `this` and
     // `toMerge` after this operation. Merge in this situation is more like a "copy stuff from `toMerge` to `this`".
     // lyd_merge_tree can also spend the source tree using LYD_MERGE_DESTRUCT, but this method does not implement that.
     // TODO: implement LYD_MERGE_DESTRUCT
     lyd_merge_tree(&this->m_node, toMerge.m_node, 0);
+    if (m_refs) {
+        m_refs->touch(toMerge.m_node);
+    }
+}
+
+/**
+ * @brief Computes the differences between all siblings of this node and all siblings of `other`.
+ *
+ * The result describes the changes which turn the forest of `this` into the forest of `other`.
+ *
+ * Wraps `lyd_diff_siblings`.
+ */
+DataDiff DataNode::diffSiblings(const DataNode& other, const DiffOptions options) const
+{
+    lyd_node* diff;
+    auto ret = lyd_diff_siblings(lyd_first_sibling(m_node), lyd_first_sibling(other.m_node), utils::toDiffOptions(options), &diff);
+    throwIfError(ret, "DataNode::diffSiblings: lyd_diff_siblings failed");
+
+    if (!diff) {
+        return DataDiff{std::nullopt};
+    }
+    return DataDiff{DataNode{diff, impl::makeShared<internal_refcount>(m_refs ? m_refs->context : nullptr)}};
+}
+
+/**
+ * @brief Computes the differences between the subtree of this node and the subtree of `other`.
+ *
+ * Siblings of both nodes are not compared. The result describes the changes which turn `this` into `other`.
+ *
+ * Wraps `lyd_diff_tree`.
+ */
+DataDiff DataNode::diffTree(const DataNode& other, const DiffOptions options) const
+{
+    lyd_node* diff;
+    auto ret = lyd_diff_tree(m_node, other.m_node, utils::toDiffOptions(options), &diff);
+    throwIfError(ret, "DataNode::diffTree: lyd_diff_tree failed");
+
+    if (!diff) {
+        return DataDiff{std::nullopt};
+    }
+    return DataDiff{DataNode{diff, impl::makeShared<internal_refcount>(m_refs ? m_refs->context : nullptr)}};
+}
+
+/**
+ * @brief Starts a batch of edits of this tree; see TreeEditBatch for details.
+ *
+ * Other trees join the batch as soon as an operation moves nodes between them and a tree which is already a part of
+ * the batch. A tree can only be a part of a single batch at a time.
+ */
+TreeEditBatch DataNode::beginBatch() const
+{
+    throwIfFrozen("DataNode::beginBatch");
+    return TreeEditBatch{m_refs};
+}
+
+TreeEditBatch::TreeEditBatch(const std::shared_ptr<internal_refcount>& refs)
+    : m_state(std::make_unique<impl::batch_state>())
+{
+    m_state->join(refs);
+}
+
+TreeEditBatch::TreeEditBatch(TreeEditBatch&&) noexcept = default;
+
+TreeEditBatch::~TreeEditBatch()
+{
+    try {
+        commit();
+    } catch (std::bad_alloc&) {
+        // Destructors must not throw, call commit() to handle running out of memory. The trees are detached from the
+        // batch so that they remain usable, but the trees which became unreachable during the batch are leaked.
+        for (const auto& refs : m_state->refs) {
+            refs->batch = nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Finishes all the deferred bookkeeping. Further edits are no longer a part of this batch.
+ *
+ * All wrappers of all involved trees are assigned to the (possibly new) trees they belong to now, and all Collection
+ * instances of the involved trees are invalidated. A Set is only invalidated when some of its nodes were moved to
+ * another tree, or when they are about to be freed. Trees which are no longer referenced by any wrapper are
+ * freed. This is done in a single pass over all wrappers, regardless of the number of edits.
+ *
+ * Everything which needs memory is prepared before any wrapper is touched. If that throws std::bad_alloc, the batch is
+ * left intact, and commit() can be called again.
+ */
+void TreeEditBatch::commit()
+{
+    if (!m_state) {
+        return;
+    }
+
+    // The registries are modified while moving the wrappers around, so let's take a snapshot first.
+    std::size_t wrapperCount = 0;
+    for (const auto& refs : m_state->refs) {
+        wrapperCount += refs->nodes.size();
+    }
+    std::vector<DataNode*> wrappers;
+    wrappers.reserve(wrapperCount);
+    for (const auto& refs : m_state->refs) {
+        std::copy(refs->nodes.begin(), refs->nodes.end(), std::back_inserter(wrappers));
+    }
+
+    // Each forest gets a single refcounter. Reuse the original ones where possible so that as few wrappers as possible
+    // need to be moved.
+    ForestLookup lookup;
+    std::unordered_map<const lyd_node*, std::shared_ptr<internal_refcount>> owners;
+    std::unordered_set<const internal_refcount*> claimed;
+    std::vector<const std::shared_ptr<internal_refcount>*> newOwners;
+    newOwners.reserve(wrappers.size());
+    for (auto wrapper : wrappers) {
+        auto& owner = owners[lookup.forestOf(wrapper->m_node)];
+        if (!owner) {
+            if (claimed.insert(wrapper->m_refs.get()).second) {
+                owner = wrapper->m_refs;
+            } else {
+                owner = impl::makeShared<internal_refcount>(wrapper->m_refs->context, wrapper->m_refs->customContext);
+            }
+        }
+        newOwners.emplace_back(&owner);
+    }
+
+    // All forests have to be looked up before anything gets freed.
+    std::vector<const lyd_node*> orphans;
+    for (auto candidate : m_state->orphanCandidates) {
+        if (auto forest = lookup.forestOf(candidate); !owners.contains(forest)) {
+            owners.emplace(forest, nullptr);
+            orphans.emplace_back(forest);
+        }
+    }
+
+    // A Set remains usable as long as all of its nodes still belong to the tree of the Set, and that tree stays.
+    std::vector<Set<DataNode>*> staleSets;
+    std::vector<uint64_t> invalidated(m_state->refs.size());
+    for (std::size_t i = 0; i < m_state->refs.size(); ++i) {
+        const auto& refs = m_state->refs[i];
+        for (const auto& it : refs->dataSets) {
+            if (it->m_valid && std::any_of(it->m_set->dnodes, it->m_set->dnodes + it->m_set->count, [&](const lyd_node* node) {
+                    auto owner = owners.find(lookup.forestOf(node));
+                    return owner == owners.end() || owner->second != refs;
+                })) {
+                staleSets.emplace_back(it);
+                ++invalidated[i];
+            }
+        }
+    }
+
+    // Nothing below allocates, so the wrappers cannot end up half-moved.
+    auto state = std::move(m_state);
+    for (const auto& refs : state->refs) {
+        refs->batch = nullptr;
+    }
+
+    for (std::size_t i = 0; i < wrappers.size(); ++i) {
+        auto wrapper = wrappers[i];
+        const auto& owner = *newOwners[i];
+        if (wrapper->m_refs != owner) {
+            wrapper->unregisterRef();
+            wrapper->m_refs = owner;
+            wrapper->registerRef();
+        }
+    }
+
+    for (auto set : staleSets) {
+        set->invalidate();
+    }
+
+    for (std::size_t i = 0; i < state->refs.size(); ++i) {
+        const auto& refs = state->refs[i];
+        for (const auto& it : refs->dataCollectionsDfs) {
+            it->invalidate();
+        }
+
+        for (const auto& it : refs->dataCollectionsSibling) {
+            it->invalidate();
+        }
+
+        impl::countStat(refs->stats, &impl::context_stats::invalidations,
+                invalidated[i] + refs->dataCollectionsDfs.size() + refs->dataCollectionsSibling.size());
+    }
+
+    for (auto forest : orphans) {
+        lyd_free_all(const_cast<lyd_node*>(forest));
+    }
+    if (!state->refs.empty()) {
+        impl::countStat(state->refs.front()->stats, &impl::context_stats::orphanFrees, orphans.size());
+    }
+}
+
+namespace {
+/**
+ * @brief Returns the node which follows `current` in a DFS of the subtree of `root`, without descending into the
+ * children of `current`.
+ */
+lyd_node* nextSkippingChildren(lyd_node* current, const lyd_node* root)
+{
+    for (; current != root; current = reinterpret_cast<lyd_node*>(current->parent)) {
+        if (current->next) {
+            return current->next;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Returns the node which follows `current` in a depth-first traversal of the subtree of `root`, or nullptr.
+ */
+lyd_node* nextInSubtree(lyd_node* current, const lyd_node* root)
+{
+    if (auto child = lyd_child(current)) {
+        return child;
+    }
+
+    return nextSkippingChildren(current, root);
+}
+
+lyd_node* firstTopLevelSibling(lyd_node* node)
+{
+    while (node->parent) {
+        node = reinterpret_cast<lyd_node*>(node->parent);
+    }
+    return lyd_first_sibling(node);
+}
+
+/**
+ * @brief Makes libyang compute and store all values which it would otherwise compute on first access.
+ */
+void materializeLazyValues(lyd_node* forest)
+{
+    for (auto top = forest; top; top = top->next) {
+        for (auto node = top; node; node = nextInSubtree(node, top)) {
+            if (node->schema && (node->schema->nodetype & LYD_NODE_TERM)) {
+                lyd_get_value(node);
+            }
+
+            for (auto meta = node->meta; meta; meta = meta->next) {
+                lyd_get_meta_value(meta);
+            }
+        }
+    }
+}
+}
+
+void DataNode::throwIfFrozen(const char* where) const
+{
+    if (m_refs && m_refs->isFrozen()) {
+        throw Error{std::string{where} + ": the tree is frozen"};
+    }
+}
+
+/**
+ * @brief Records that the subtree of this node is about to change, or has changed, see validateIncremental().
+ */
+void DataNode::recordChange() const
+{
+    if (m_refs) {
+        m_refs->touch(m_node);
+    }
+}
+
+/**
+ * @brief Freezes the whole tree which this node is a part of, so that it can be read from several threads.
+ *
+ * See FrozenTree for details. If the tree is already frozen, this returns another handle to it. Freezing itself must
+ * not run concurrently with any other use of the tree.
+ */
+FrozenTree DataNode::freeze() const
+{
+    if (!m_refs) {
+        throw Error{"DataNode::freeze: unmanaged trees cannot be frozen"};
+    }
+
+    if (auto state = m_refs->frozen.lock()) {
+        return FrozenTree{std::move(state)};
+    }
+
+    if (m_refs->batch) {
+        throw Error{"DataNode::freeze: the tree is a part of an uncommitted TreeEditBatch"};
+    }
+
+    auto forest = firstTopLevelSibling(m_node);
+
+    // Canonical values are computed and stored on first access. That's a write which must not happen while several
+    // threads are reading the tree.
+    materializeLazyValues(forest);
+
+    auto state = std::make_shared<impl::frozen_state>(DataNode{forest, m_refs});
+    m_refs->frozen = state;
+    return FrozenTree{std::move(state)};
+}
+
+/**
+ * @brief Returns a read-only copy of the whole tree which this node is a part of, as it is right now.
+ *
+ * The copy is not affected by any later changes of this tree. Unlike freeze(), this tree remains writable.
+ *
+ * libyang nodes cannot be shared between trees, so a snapshot is a full copy. However, the most recent snapshot is
+ * cached and shared: as long as the tree is only changed through libyang-cpp, calling this again without any change
+ * in between just returns another handle to the same copy. A server which hands out snapshots to readers therefore
+ * pays for one copy per version of the tree, not per reader. The cache does not keep the copy alive: it is freed as
+ * soon as the last reader drops its FrozenTree.
+ *
+ * Changes made through the C API (e.g., via getRawNode()) are not tracked, so they might not be visible in a cached
+ * snapshot. Snapshots can be taken from several threads at once, but not concurrently with changes of the tree.
+ *
+ * Wraps `lyd_dup_siblings`.
+ */
+FrozenTree DataNode::snapshot() const
+{
+    if (!m_refs) {
+        throw Error{"DataNode::snapshot: unmanaged trees cannot be snapshotted"};
+    }
+    if (m_refs->batch) {
+        throw Error{"DataNode::snapshot: the tree is a part of an uncommitted TreeEditBatch"};
+    }
+
+    std::lock_guard lock{m_refs->snapshotMutex};
+    if (m_refs->snapshotGeneration == m_refs->generation) {
+        if (auto cached = m_refs->snapshot.lock()) {
+            return FrozenTree{std::move(cached)};
+        }
+    }
+
+    lyd_node* dup;
+    auto ret = lyd_dup_siblings(firstTopLevelSibling(m_node), nullptr, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, &dup);
+    throwIfError(ret, "DataNode::snapshot");
+
+    DataNode copy{dup, m_refs->context};
+    materializeLazyValues(dup);
+    auto state = std::make_shared<impl::frozen_state>(std::move(copy));
+    state->forest.m_refs->frozen = state;
+    m_refs->snapshot = state;
+    m_refs->snapshotGeneration = m_refs->generation;
+    return FrozenTree{std::move(state)};
+}
+
+FrozenTree::FrozenTree(std::shared_ptr<impl::frozen_state> state)
+    : m_state(std::move(state))
+{
+}
+
+/**
+ * @brief Returns the first top-level node of the frozen tree.
+ */
+DataNode FrozenTree::root() const
+{
+    return m_state->forest;
+}
+
+/**
+ * @brief Invokes `callback` for each child of `parent`, spreading the calls over several threads.
+ *
+ * The callback might be invoked concurrently, in an unspecified order. If a callback throws, no further callbacks are
+ * started, and the first exception is propagated to the caller once all threads are done.
+ *
+ * @param parent A node of this tree.
+ * @param callback Invoked for each child.
+ * @param threads Maximal number of threads to use, including the calling one. Use 0 for the number of CPUs.
+ */
+void FrozenTree::parallelForEachChild(const DataNode& parent, const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads) const
+{
+    if (parent.m_refs != m_state->forest.m_refs) {
+        throw Error{"FrozenTree::parallelForEachChild: the node is not a part of this tree"};
+    }
+
+    std::vector<std::pair<lyd_node*, bool>> tasks;
+    for (auto child = lyd_child(parent.m_node); child; child = child->next) {
+        tasks.emplace_back(child, false);
+    }
+
+    run(tasks, callback, threads);
+}
+
+/**
+ * @brief Invokes `callback` for each node of the frozen tree, spreading the calls over several threads.
+ *
+ * The tree is split into subtrees, these are handed out to the threads as they become idle. Within a subtree, nodes
+ * are visited in the depth-first order, but the order of the subtrees is unspecified. Exceptions are handled like in
+ * parallelForEachChild.
+ *
+ * @param callback Invoked for each node.
+ * @param threads Maximal number of threads to use, including the calling one. Use 0 for the number of CPUs.
+ */
+void FrozenTree::parallelDfs(const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads) const
+{
+    // Each task is a node, and whether to visit its whole subtree. Split top-level subtrees into their children until
+    // there are enough tasks to keep all threads busy.
+    std::vector<std::pair<lyd_node*, bool>> tasks;
+    for (auto top = m_state->forest.m_node; top; top = top->next) {
+        tasks.emplace_back(top, true);
+    }
+
+    const auto wanted = 4 * impl::resolveThreadCount(threads);
+    for (bool expanded = true; expanded && tasks.size() < wanted;) {
+        expanded = false;
+        std::vector<std::pair<lyd_node*, bool>> next;
+        for (const auto& [node, subtree] : tasks) {
+            auto child = subtree ? lyd_child(node) : nullptr;
+            if (!child) {
+                next.emplace_back(node, subtree);
+                continue;
+            }
+
+            expanded = true;
+            next.emplace_back(node, false);
+            for (; child; child = child->next) {
+                next.emplace_back(child, true);
+            }
+        }
+        tasks = std::move(next);
+    }
+
+    run(tasks, callback, threads);
+}
+
+void FrozenTree::run(const std::vector<std::pair<lyd_node*, bool>>& tasks, const std::function<void(const DataNodeRef&)>& callback, const std::size_t threads) const
+{
+    impl::parallelFor(tasks.size(), threads, [&](const std::size_t i) {
+        const auto& [root, subtree] = tasks[i];
+        for (auto node = root; node; node = subtree ? nextInSubtree(node, root) : nullptr) {
+            callback(DataNodeRef{node, &m_state->valid, &m_state->forest.m_refs});
+        }
+    });
+}
+
+DataDiff::DataDiff(std::optional<DataNode> diff)
+    : m_diff(std::move(diff))
+{
+}
+
+namespace {
+/**
+ * @brief Returns the `yang:operation` which is set directly on this node of a diff, if any.
+ */
+std::optional<DiffOperation> ownDiffOperation(const lyd_node* node)
+{
+    auto meta = lyd_find_meta(node->meta, nullptr, "yang:operation");
+    if (!meta) {
+        return std::nullopt;
+    }
+
+    std::string_view operation = lyd_get_meta_value(meta);
+    if (operation == "none") {
+        return DiffOperation::None;
+    }
+    if (operation == "create") {
+        return DiffOperation::Create;
+    }
+    if (operation == "delete") {
+        return DiffOperation::Delete;
+    }
+    if (operation == "replace") {
+        return DiffOperation::Replace;
+    }
+    throw Error{"DataDiff: unknown diff operation \"" + std::string{operation} + "\""};
+}
+
+/**
+ * @brief Calls `callback` for each changed node of a diff, in DFS order. Subtrees of created and deleted nodes are
+ * reported as a whole.
+ */
+template <typename Callback>
+void walkDiff(lyd_node* diff, Callback&& callback)
+{
+    for (auto root = diff; root; root = root->next) {
+        for (auto node = root; node;) {
+            auto operation = ownDiffOperation(node);
+            if (operation && *operation != DiffOperation::None) {
+                callback(node, *operation);
+            }
+
+            if (operation == DiffOperation::Create || operation == DiffOperation::Delete) {
+                node = nextSkippingChildren(node, root);
+            } else {
+                node = nextInSubtree(node, root);
+            }
+        }
+    }
+}
+}
+
+/**
+ * @brief Checks whether the two compared trees were equal.
+ */
+bool DataDiff::empty() const
+{
+    return !m_diff.has_value();
+}
+
+/**
+ * @brief Returns the first top-level sibling of the diff tree, or std::nullopt if there are no differences.
+ */
+std::optional<DataNode> DataDiff::tree() const
+{
+    return m_diff;
+}
+
+/**
+ * @brief Returns all changes within the diff, see forEachChange().
+ */
+std::vector<DiffChange> DataDiff::changes() const
+{
+    std::vector<DiffChange> res;
+    if (m_diff) {
+        walkDiff(m_diff->m_node, [&](lyd_node* node, const DiffOperation operation) {
+            res.push_back(DiffChange{DataNode{node, m_diff->m_refs}, operation});
+        });
+    }
+    return res;
+}
+
+/**
+ * @brief Calls `callback` for each changed node of the diff, in DFS order.
+ *
+ * Nodes which are only present in the diff because some of their descendants have changed are skipped. Created and
+ * deleted subtrees are reported only once, via their root node. Unlike changes(), no DataNode wrappers are created, so
+ * this is the cheaper way of going through a large diff. The DataNodeRef must not be used after the callback returns.
+ */
+void DataDiff::forEachChange(const std::function<void(const DataNodeRef& node, const DiffOperation operation)>& callback) const
+{
+    if (!m_diff) {
+        return;
+    }
+
+    bool valid = true;
+    walkDiff(m_diff->m_node, [&](lyd_node* node, const DiffOperation operation) {
+        callback(DataNodeRef{node, &valid, &m_diff->m_refs}, operation);
+    });
+}
+
+/**
+ * @brief Applies the diff to `data`. DANGEROUS, the same restrictions as for validateAll() apply.
+ *
+ * Nodes might be created and deleted anywhere in the forest, so `data` must be the only reference to the tree. After
+ * the operation, `data` points to the first sibling of the forest, or it is std::nullopt if the whole forest was
+ * deleted. If `data` is std::nullopt, a new forest is created.
+ *
+ * Wraps `lyd_diff_apply_all`.
+ */
+void DataDiff::apply(std::optional<DataNode>& data) const
+{
+    if (data) {
+        data->throwIfFrozen("DataDiff::apply");
+        if (data->m_refs.use_count() > 1) {
+            throw Error("DataDiff::apply: Node is not a unique reference");
+        }
+    }
+
+    if (!m_diff) {
+        return;
+    }
+
+    lyd_node* forest = data ? lyd_first_sibling(data->m_node) : nullptr;
+    auto ret = lyd_diff_apply_all(&forest, m_diff->m_node);
+    throwIfError(ret, "DataDiff::apply: lyd_diff_apply_all failed");
+
+    if (!forest) {
+        if (data) {
+            data->m_node = nullptr;
+        }
+        data = std::nullopt;
+        return;
+    }
+
+    if (!data) {
+        data = DataNode{forest, impl::makeShared<internal_refcount>(m_diff->m_refs->context)};
+        return;
+    }
+
+    data->m_node = forest;
+    if (data->m_refs) {
+        for (auto root = m_diff->m_node; root; root = root->next) {
+            data->m_refs->touch(root);
+        }
+    }
 }
 
 /**
@@ -794,6 +1889,18 @@ const Type* valueGetSpecial(const lyd_value* value)
         return reinterpret_cast<const Type*>(value->fixed_mem);
     }
 }
+
+/**
+ * @brief Returns the value of a term node, with any (possibly nested) unions resolved to the actual member value.
+ */
+const lyd_value& resolvedValue(const lyd_node* node)
+{
+    auto value = &reinterpret_cast<const lyd_node_term*>(node)->value;
+    while (value->realtype->basetype == LY_TYPE_UNION) {
+        value = &value->subvalue->value;
+    }
+    return *value;
+}
 }
 
 /**
@@ -803,79 +1910,292 @@ const Type* valueGetSpecial(const lyd_value* value)
  */
 Value DataNodeTerm::value() const
 {
-    std::function<Value(lyd_value)> impl = [this, &impl](const lyd_value value) -> Value {
-        auto baseType = value.realtype->basetype;
-        switch (baseType) {
-        case LY_TYPE_INT8:
+    const auto& value = resolvedValue(m_node);
+    switch (value.realtype->basetype) {
+    case LY_TYPE_INT8:
+        return value.int8;
+    case LY_TYPE_INT16:
+        return value.int16;
+    case LY_TYPE_INT32:
+        return value.int32;
+    case LY_TYPE_INT64:
+        return value.int64;
+    case LY_TYPE_UINT8:
+        return value.uint8;
+    case LY_TYPE_UINT16:
+        return value.uint16;
+    case LY_TYPE_UINT32:
+        return value.uint32;
+    case LY_TYPE_UINT64:
+        return value.uint64;
+    case LY_TYPE_BOOL:
+        return static_cast<bool>(value.boolean);
+    case LY_TYPE_EMPTY:
+        return Empty{};
+    case LY_TYPE_BINARY: {
+        auto binValue = valueGetSpecial<lyd_value_binary>(&value);
+        Binary res;
+        std::copy(static_cast<uint8_t*>(binValue->data), static_cast<uint8_t*>(binValue->data) + binValue->size, std::back_inserter(res.data));
+        res.base64 = valueStr();
+        return res;
+    }
+    case LY_TYPE_STRING:
+        return valueStr();
+    case LY_TYPE_DEC64: {
+        return Decimal64{value.dec64, reinterpret_cast<const lysc_type_dec*>(value.realtype)->fraction_digits};
+    }
+    case LY_TYPE_BITS: {
+        auto bits = valueGetSpecial<lyd_value_bits>(&value);
+        std::vector<Bit> res;
+        std::transform(bits->items, bits->items + LY_ARRAY_COUNT(bits->items), std::back_inserter(res), [](const lysc_type_bitenum_item* bit) {
+            return Bit{.position = bit->position, .name = bit->name};
+        });
+
+        return res;
+    }
+    case LY_TYPE_ENUM:
+        return Enum{.name = value.enum_item->name, .value = value.enum_item->value};
+    case LY_TYPE_IDENT:
+        return IdentityRef{.module = value.ident->module->name, .name = value.ident->name, .schema = Identity(value.ident, this->m_refs ? this->m_refs->context : nullptr)};
+    case LY_TYPE_INST: {
+        lyd_node* out;
+        auto err = lyd_find_target(value.target, m_node, &out);
+        switch (err) {
+        case LY_SUCCESS:
+            return InstanceIdentifier{lyd_get_value(m_node), DataNode{out, m_refs}};
+        case LY_ENOTFOUND:
+            return InstanceIdentifier{lyd_get_value(m_node), std::nullopt};
+        default:
+            throwError(err, "Error when finding inst-id target");
+        }
+    }
+    case LY_TYPE_UNION:
+        // Unions are resolved to the actual member type by resolvedValue(), so this should never happen.
+    case LY_TYPE_LEAFREF:
+        // Leafrefs are resolved to the underlying types, so this should never happen.
+        throw std::logic_error("Unknown type");
+    case LY_TYPE_UNKNOWN:
+        throw Error("Unknown type");
+    }
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Retrieves a non-owning view of the value in a machine-readable format.
+ *
+ * Unlike value(), this never allocates. Strings, binary data and bits refer directly to the libyang storage, so the
+ * view is only valid as long as this node exists and its value is not changed. The target of an instance-identifier is
+ * not looked up, use value() for that.
+ */
+ValueView DataNodeTerm::valueView() const
+{
+    return valueViewOf(m_node);
+}
+
+ValueView DataNodeTerm::valueViewOf(const lyd_node* node)
+{
+    const auto& value = resolvedValue(node);
+    switch (value.realtype->basetype) {
+    case LY_TYPE_INT8:
+        return value.int8;
+    case LY_TYPE_INT16:
+        return value.int16;
+    case LY_TYPE_INT32:
+        return value.int32;
+    case LY_TYPE_INT64:
+        return value.int64;
+    case LY_TYPE_UINT8:
+        return value.uint8;
+    case LY_TYPE_UINT16:
+        return value.uint16;
+    case LY_TYPE_UINT32:
+        return value.uint32;
+    case LY_TYPE_UINT64:
+        return value.uint64;
+    case LY_TYPE_BOOL:
+        return static_cast<bool>(value.boolean);
+    case LY_TYPE_EMPTY:
+        return Empty{};
+    case LY_TYPE_BINARY: {
+        auto binValue = valueGetSpecial<lyd_value_binary>(&value);
+        return BinaryView{
+            .data = {static_cast<const uint8_t*>(binValue->data), binValue->size},
+            .base64 = lyd_get_value(node)};
+    }
+    case LY_TYPE_STRING:
+        return std::string_view{lyd_get_value(node)};
+    case LY_TYPE_DEC64:
+        return Decimal64{value.dec64, reinterpret_cast<const lysc_type_dec*>(value.realtype)->fraction_digits};
+    case LY_TYPE_BITS: {
+        auto bits = valueGetSpecial<lyd_value_bits>(&value);
+        return BitsView{bits->items, LY_ARRAY_COUNT(bits->items)};
+    }
+    case LY_TYPE_ENUM:
+        return EnumView{.name = value.enum_item->name, .value = value.enum_item->value};
+    case LY_TYPE_IDENT:
+        return IdentityRefView{.module = value.ident->module->name, .name = value.ident->name};
+    case LY_TYPE_INST:
+        return InstanceIdentifierView{.path = lyd_get_value(node)};
+    case LY_TYPE_UNION:
+        // Unions are resolved to the actual member type by resolvedValue(), so this should never happen.
+    case LY_TYPE_LEAFREF:
+        // Leafrefs are resolved to the underlying types, so this should never happen.
+        throw std::logic_error("Unknown type");
+    case LY_TYPE_UNKNOWN:
+        throw Error("Unknown type");
+    }
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Retrieves the value as `T`, or std::nullopt if the value has a different type.
+ *
+ * This is a fast path for reading values of a known type, it neither builds a Value nor allocates (except for
+ * `std::string`). Unions are resolved to the actual member type. Supported types are `int8_t`, `int16_t`, `int32_t`,
+ * `int64_t`, `uint8_t`, `uint16_t`, `uint32_t`, `uint64_t`, `bool`, Decimal64, `std::string_view` and `std::string`
+ * (for YANG type `string`, the view is only valid as long as this node exists and its value is not changed).
+ */
+template <typename T>
+std::optional<T> DataNodeTerm::tryValueAs() const
+{
+    const auto& value = resolvedValue(m_node);
+    const auto baseType = value.realtype->basetype;
+    if constexpr (std::is_same_v<T, int8_t>) {
+        if (baseType == LY_TYPE_INT8) {
             return value.int8;
-        case LY_TYPE_INT16:
+        }
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        if (baseType == LY_TYPE_INT16) {
             return value.int16;
-        case LY_TYPE_INT32:
+        }
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        if (baseType == LY_TYPE_INT32) {
             return value.int32;
-        case LY_TYPE_INT64:
+        }
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        if (baseType == LY_TYPE_INT64) {
             return value.int64;
-        case LY_TYPE_UINT8:
+        }
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        if (baseType == LY_TYPE_UINT8) {
             return value.uint8;
-        case LY_TYPE_UINT16:
+        }
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        if (baseType == LY_TYPE_UINT16) {
             return value.uint16;
-        case LY_TYPE_UINT32:
+        }
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        if (baseType == LY_TYPE_UINT32) {
             return value.uint32;
-        case LY_TYPE_UINT64:
+        }
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        if (baseType == LY_TYPE_UINT64) {
             return value.uint64;
-        case LY_TYPE_BOOL:
+        }
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (baseType == LY_TYPE_BOOL) {
             return static_cast<bool>(value.boolean);
-        case LY_TYPE_EMPTY:
-            return Empty{};
-        case LY_TYPE_BINARY: {
-            auto binValue = valueGetSpecial<lyd_value_binary>(&value);
-            Binary res;
-            std::copy(static_cast<uint8_t*>(binValue->data), static_cast<uint8_t*>(binValue->data) + binValue->size, std::back_inserter(res.data));
-            res.base64 = valueStr();
-            return res;
         }
-        case LY_TYPE_STRING:
-            return valueStr();
-        case LY_TYPE_UNION:
-            return impl(value.subvalue->value);
-        case LY_TYPE_DEC64: {
+    } else if constexpr (std::is_same_v<T, Decimal64>) {
+        if (baseType == LY_TYPE_DEC64) {
             return Decimal64{value.dec64, reinterpret_cast<const lysc_type_dec*>(value.realtype)->fraction_digits};
         }
-        case LY_TYPE_BITS: {
-            auto bits = valueGetSpecial<lyd_value_bits>(&value);
-            std::vector<Bit> res;
-            std::transform(bits->items, bits->items + LY_ARRAY_COUNT(bits->items), std::back_inserter(res), [](const lysc_type_bitenum_item* bit) {
-                return Bit{.position = bit->position, .name = bit->name};
-            });
-
-            return res;
-        }
-        case LY_TYPE_ENUM:
-            return Enum{.name = value.enum_item->name, .value = value.enum_item->value};
-        case LY_TYPE_IDENT:
-            return IdentityRef{.module = value.ident->module->name, .name = value.ident->name, .schema = Identity(value.ident, this->m_refs ? this->m_refs->context : nullptr)};
-        case LY_TYPE_INST: {
-            lyd_node* out;
-            auto err = lyd_find_target(value.target, m_node, &out);
-            switch (err) {
-            case LY_SUCCESS:
-                return InstanceIdentifier{lyd_get_value(m_node), DataNode{out, m_refs}};
-            case LY_ENOTFOUND:
-                return InstanceIdentifier{lyd_get_value(m_node), std::nullopt};
-            default:
-                throwError(err, "Error when finding inst-id target");
-            }
+    } else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        if (baseType == LY_TYPE_STRING) {
+            return T{lyd_get_value(m_node)};
         }
-        case LY_TYPE_LEAFREF:
-            // Leafrefs are resolved to the underlying types, so this should never happen.
-            throw std::logic_error("Unknown type");
-        case LY_TYPE_UNKNOWN:
-            throw Error("Unknown type");
-        }
-        __builtin_unreachable();
-    };
+    } else {
+        static_assert(!sizeof(T), "DataNodeTerm::tryValueAs: unsupported type");
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Retrieves the value as `T`, throwing an Error if the value has a different type.
+ *
+ * See tryValueAs() for the list of supported types.
+ */
+template <typename T>
+T DataNodeTerm::valueAs() const
+{
+    if (auto res = tryValueAs<T>()) {
+        return *std::move(res);
+    }
+    throw Error{"DataNodeTerm::valueAs: the value of " + path() + " is not of the requested type"};
+}
 
+#define LIBYANG_CPP_INSTANTIATE_VALUE_AS(TYPE) \
+    template TYPE DataNodeTerm::valueAs<TYPE>() const; \
+    template std::optional<TYPE> DataNodeTerm::tryValueAs<TYPE>() const;
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(int8_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(int16_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(int32_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(int64_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(uint8_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(uint16_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(uint32_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(uint64_t)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(bool)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(Decimal64)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(std::string_view)
+LIBYANG_CPP_INSTANTIATE_VALUE_AS(std::string)
+#undef LIBYANG_CPP_INSTANTIATE_VALUE_AS
 
-    return impl(reinterpret_cast<const lyd_node_term*>(m_node)->value);
+BitsView::BitsView(const lysc_type_bitenum_item* const* items, const std::size_t count)
+    : m_items(items)
+    , m_count(count)
+{
+}
+
+BitsView::iterator BitsView::begin() const
+{
+    return iterator{m_items};
+}
+
+BitsView::iterator BitsView::end() const
+{
+    return iterator{m_items + m_count};
+}
+
+std::size_t BitsView::size() const
+{
+    return m_count;
+}
+
+bool BitsView::empty() const
+{
+    return m_count == 0;
+}
+
+BitView BitsView::operator[](const std::size_t index) const
+{
+    if (index >= m_count) {
+        throw std::out_of_range("BitsView: index out of range");
+    }
+    return BitView{.position = m_items[index]->position, .name = m_items[index]->name};
+}
+
+BitsView::iterator::iterator(const lysc_type_bitenum_item* const* current)
+    : m_current(current)
+{
+}
+
+BitView BitsView::iterator::operator*() const
+{
+    return BitView{.position = (*m_current)->position, .name = (*m_current)->name};
+}
+
+BitsView::iterator& BitsView::iterator::operator++()
+{
+    ++m_current;
+    return *this;
+}
+
+BitsView::iterator BitsView::iterator::operator++(int)
+{
+    auto copy = *this;
+    ++m_current;
+    return copy;
 }
 
 /**
@@ -892,15 +2212,125 @@ Value DataNodeTerm::value() const
  */
 types::Type DataNodeTerm::valueType() const
 {
-    std::function<types::Type(lyd_value)> impl = [this, &impl](const lyd_value value) -> types::Type {
-        switch (value.realtype->basetype) {
-        case LY_TYPE_UNION:
-            return impl(value.subvalue->value);
-        default:
-            return types::Type{value.realtype, nullptr, m_refs->context};
+    return types::Type{resolvedValue(m_node).realtype, nullptr, m_refs->context};
+}
+
+/**
+ * @brief Checks whether this term holds the same value as another one, without printing either of them.
+ *
+ * Both values are compared by the plugin of their type, so e.g. "+1" and "1" of an int8 are equal, and so are two
+ * identityrefs written with different prefixes. Unions are resolved to the member type which holds the value first.
+ * Values of different types are never equal, and neither are values from different contexts.
+ *
+ * Wraps `lyplg_type_compare_clb`.
+ */
+bool DataNodeTerm::valueEquals(const DataNodeTerm& other) const
+{
+    const auto& mine = resolvedValue(m_node);
+    const auto& theirs = resolvedValue(other.m_node);
+    if (mine.realtype != theirs.realtype) {
+        return false;
+    }
+
+    return mine.realtype->plugin->compare(m_refs->context.get(), &mine, &theirs) == LY_SUCCESS;
+}
+
+/**
+ * @brief Returns a hash of this term's schema node and of its canonical value.
+ *
+ * Terms which are instances of the same schema node and whose values are equal according to valueEquals() have the same
+ * hash. The hash only depends on the names and on the value, so it is the same across trees, contexts and runs.
+ *
+ * For leaf-lists, libyang already hashes the value into `lyd_node::hash`, so that one is returned directly.
+ */
+std::size_t DataNodeTerm::valueHash() const
+{
+    if (m_node->schema->nodetype == LYS_LEAFLIST) {
+        return m_node->hash;
+    }
+
+    const auto canonical = lyd_get_value(m_node);
+    auto hash = lyht_hash_multi(m_node->hash, canonical, std::strlen(canonical));
+    return lyht_hash_multi(hash, nullptr, 0);
+}
+
+namespace {
+DataNodeTerm::ValueChange toValueChange(const LY_ERR ret)
+{
+    switch (ret) {
+    case LY_SUCCESS:
+        return DataNodeTerm::ValueChange::Changed;
+    case LY_EEXIST:
+        return DataNodeTerm::ValueChange::ExplicitNonDefault;
+    case LY_ENOT:
+        return DataNodeTerm::ValueChange::EqualValueNotChanged;
+    default:
+        throwIfError(ret, "DataNodeTerm::changeValue failed");
+        __builtin_unreachable();
+    }
+}
+
+/**
+ * @brief Encodes a native value into the LYB representation of the given type, if that is cheap and possible.
+ *
+ * Only numbers, booleans and decimal64 values are handled. These are stored as little-endian integers of the type's
+ * width, so the type plugin only validates them without parsing any text. Returns the length of the encoded value, or
+ * std::nullopt when the value has to go through its lexical form instead.
+ */
+std::optional<uint32_t> nativeLybValue(const lysc_type* type, const Value& value, std::array<uint8_t, sizeof(int64_t)>& buf)
+{
+    if (type->basetype == LY_TYPE_LEAFREF) {
+        type = reinterpret_cast<const lysc_type_leafref*>(type)->realtype;
+    }
+
+    auto encode = [&buf](const uint64_t raw, const uint32_t width) -> uint32_t {
+        for (uint32_t i = 0; i < width; ++i) {
+            buf[i] = static_cast<uint8_t>(raw >> (8 * i));
+        }
+        return width;
+    };
+
+    return std::visit([&]<typename ValueType>(const ValueType& val) -> std::optional<uint32_t> {
+        if constexpr (std::is_same_v<ValueType, bool>) {
+            if (type->basetype == LY_TYPE_BOOL) {
+                return encode(val, 1);
+            }
+        } else if constexpr (std::is_integral_v<ValueType>) {
+            auto fitting = [&]<typename TargetType>() -> std::optional<uint32_t> {
+                if (!std::in_range<TargetType>(val)) {
+                    // let libyang report the out-of-range value
+                    return std::nullopt;
+                }
+                return encode(static_cast<uint64_t>(static_cast<TargetType>(val)), sizeof(TargetType));
+            };
+            switch (type->basetype) {
+            case LY_TYPE_INT8:
+                return fitting.template operator()<int8_t>();
+            case LY_TYPE_INT16:
+                return fitting.template operator()<int16_t>();
+            case LY_TYPE_INT32:
+                return fitting.template operator()<int32_t>();
+            case LY_TYPE_INT64:
+                return fitting.template operator()<int64_t>();
+            case LY_TYPE_UINT8:
+                return fitting.template operator()<uint8_t>();
+            case LY_TYPE_UINT16:
+                return fitting.template operator()<uint16_t>();
+            case LY_TYPE_UINT32:
+                return fitting.template operator()<uint32_t>();
+            case LY_TYPE_UINT64:
+                return fitting.template operator()<uint64_t>();
+            default:
+                break;
+            }
+        } else if constexpr (std::is_same_v<ValueType, Decimal64>) {
+            if (type->basetype == LY_TYPE_DEC64 && reinterpret_cast<const lysc_type_dec*>(type)->fraction_digits == val.digits) {
+                return encode(static_cast<uint64_t>(val.number), sizeof(int64_t));
+            }
         }
-    };
-    return impl(reinterpret_cast<const lyd_node_term*>(m_node)->value);
+        return std::nullopt;
+    }, value);
+}
 }
 
 /** @short Change the term's value
@@ -909,19 +2339,47 @@ types::Type DataNodeTerm::valueType() const
  * */
 DataNodeTerm::ValueChange DataNodeTerm::changeValue(const std::string value)
 {
+    throwIfFrozen("DataNodeTerm::changeValue");
     auto ret = lyd_change_term(m_node, value.c_str());
+    if (ret == LY_SUCCESS || ret == LY_EEXIST) {
+        recordChange();
+    }
+    return toValueChange(ret);
+}
 
-    switch (ret) {
-    case LY_SUCCESS:
-        return ValueChange::Changed;
-    case LY_EEXIST:
-        return ValueChange::ExplicitNonDefault;
-    case LY_ENOT:
-        return ValueChange::EqualValueNotChanged;
-    default:
-        throwIfError(ret, "DataNodeTerm::changeValue failed");
-        __builtin_unreachable();
+/** @short Change the term's value
+ *
+ * Without this overload, a string literal would be ambiguous between std::string and Value.
+ * */
+DataNodeTerm::ValueChange DataNodeTerm::changeValue(const char* value)
+{
+    return changeValue(std::string{value});
+}
+
+/** @short Change the term's value to a native value
+ *
+ * Numbers, booleans and decimal64 values (with the fraction-digits of the schema type) are stored without formatting
+ * them to text and having libyang parse that again. Integers are accepted in any width as long as they fit into the
+ * schema type. Everything else, including all values of unions, goes through the lexical form of the value.
+ *
+ * The result has the same meaning as with changeValue(const std::string).
+ *
+ * Wraps `lyd_change_term_bin` and `lyd_change_term`.
+ * */
+DataNodeTerm::ValueChange DataNodeTerm::changeValue(const Value& value)
+{
+    throwIfFrozen("DataNodeTerm::changeValue");
+    std::array<uint8_t, sizeof(int64_t)> buf;
+    LY_ERR ret;
+    if (auto len = nativeLybValue(reinterpret_cast<const lysc_node_leaf*>(m_node->schema)->type, value, buf)) {
+        ret = lyd_change_term_bin(m_node, buf.data(), *len);
+    } else {
+        ret = lyd_change_term(m_node, impl::lexicalValue(value).c_str());
+    }
+    if (ret == LY_SUCCESS || ret == LY_EEXIST) {
+        recordChange();
     }
+    return toValueChange(ret);
 }
 
 /**
@@ -977,6 +2435,8 @@ SchemaNode DataNode::schema() const
  */
 void DataNode::newMeta(const Module& module, const std::string& name, const std::string& value)
 {
+    throwIfFrozen("DataNode::newMeta");
+    recordChange();
     if (!m_node->schema) {
         throw Error{"DataNode::newMeta: can't add attributes to opaque nodes"};
     }
@@ -998,33 +2458,74 @@ MetaCollection DataNode::meta() const
     return MetaCollection{m_node->meta, *this};
 }
 
-Meta::Meta(lyd_meta* meta, std::shared_ptr<ly_ctx> ctx)
-    : m_name(meta->name)
-    , m_value(lyd_get_meta_value(meta))
-    , m_mod(meta->annotation->module, ctx)
-    , m_isInternal(lyd_meta_is_internal(meta))
+/**
+ * @brief Finds the metadata `name` from `module`.
+ *
+ * Wraps `lyd_find_meta`.
+ */
+std::optional<Meta> DataNode::findMeta(const Module& module, const std::string& name) const
+{
+    if (auto meta = lyd_find_meta(m_node->meta, module.m_module, name.c_str())) {
+        return Meta{meta, *this};
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Finds the metadata by its `qualifiedName` in the form of `module:name`.
+ *
+ * Wraps `lyd_find_meta`.
+ */
+std::optional<Meta> DataNode::findMeta(const std::string& qualifiedName) const
+{
+    if (auto meta = lyd_find_meta(m_node->meta, nullptr, qualifiedName.c_str())) {
+        return Meta{meta, *this};
+    }
+    return std::nullopt;
+}
+
+Meta::Meta(lyd_meta* meta, DataNode node)
+    : m_meta(meta)
+    , m_node(std::move(node))
 {
 }
 
 std::string Meta::name() const
 {
-    return m_name;
+    return m_meta->name;
+}
+
+/**
+ * @brief Returns the name of the metadata without copying it. The view is valid for as long as the metadata exists.
+ */
+std::string_view Meta::nameView() const
+{
+    return m_meta->name;
 }
 
 std::string Meta::valueStr() const
 {
-    return m_value;
+    return lyd_get_meta_value(m_meta);
+}
+
+/**
+ * @brief Returns the value of the metadata without copying it. The view is valid for as long as the metadata exists
+ * and is not changed.
+ */
+std::string_view Meta::valueView() const
+{
+    return lyd_get_meta_value(m_meta);
 }
 
 Module Meta::module() const
 {
-    return m_mod;
+    return Module{m_meta->annotation->module, m_node.m_refs ? m_node.m_refs->context : nullptr};
 }
 
 /** @brief Checks if the meta attribute is considered internal for libyang, see `lyd_meta_is_internal` */
 bool Meta::isInternal() const
 {
-    return m_isInternal;
+    return lyd_meta_is_internal(m_meta);
 }
 
 /**
@@ -1037,6 +2538,8 @@ bool Meta::isInternal() const
  */
 void DataNode::newAttrOpaqueJSON(const std::optional<std::string>& moduleName, const std::string& attrName, const std::optional<std::string>& attrValue) const
 {
+    throwIfFrozen("DataNode::newAttrOpaqueJSON");
+    recordChange();
     if (!isOpaque()) {
         throw Error{"DataNode::newAttrOpaqueJSON: node is not opaque"};
     }
@@ -1052,6 +2555,7 @@ void DataNode::newAttrOpaqueJSON(const std::optional<std::string>& moduleName, c
  */
 Set<DataNode> DataNode::findXPath(const std::string& xpath) const
 {
+    impl::stats_span span{impl::statsOf(m_refs.get()), StatsOperation::FindXPath};
     ly_set* set;
     auto ret = lyd_find_xpath(m_node, xpath.c_str(), &set);
 
@@ -1060,6 +2564,19 @@ Set<DataNode> DataNode::findXPath(const std::string& xpath) const
     return Set<DataNode>{set, m_refs};
 }
 
+/**
+ * @brief Returns a set of nodes matching a pre-checked `xpath`.
+ *
+ * Throws if the `xpath` was checked in a different context.
+ *
+ * Wraps `lyd_find_xpath`.
+ */
+Set<DataNode> DataNode::findXPath(const CheckedXPath& xpath) const
+{
+    xpath.checkContext(m_node, "DataNode::findXPath");
+    return findXPath(*xpath.m_expression);
+}
+
 /**
  * Finds a sibling that corresponds to a SchemaNode instance.
  * @param schema The SchemaNode node used for searching.
@@ -1088,6 +2605,201 @@ std::optional<DataNode> DataNode::findSiblingVal(SchemaNode schema, const std::o
     }
 }
 
+namespace {
+/**
+ * @brief Creates a standalone instance of `list` with the given keys, for comparing it with the siblings of `sibling`.
+ *
+ * Returns nullptr when `list` cannot be a sibling of `sibling` because it is nested, and `sibling` is top-level.
+ */
+lyd_node* newListInstance(const lyd_node* sibling, const lysc_node* list, std::span<const Value> keys, const std::string& where)
+{
+    if (list->nodetype != LYS_LIST) {
+        throw Error{where + ": `list` is not a list"};
+    }
+    if (list->flags & LYS_KEYLESS) {
+        throw Error{where + ": `list` is a key-less list"};
+    }
+
+    std::size_t keyCount = 0;
+    for (auto key = lysc_node_child(list); key && lysc_is_key(key); key = key->next) {
+        ++keyCount;
+    }
+    if (keys.size() != keyCount) {
+        throw Error{where + ": expected " + std::to_string(keyCount) + " key values, got " + std::to_string(keys.size())};
+    }
+
+    // Strings of string types and the native values are passed in their LYB form, which the type plugins only have to
+    // validate. Any other key (e.g., an identity, or a type with a union) needs its lexical form, and then all of them do.
+    std::vector<std::array<uint8_t, sizeof(int64_t)>> buffers(keys.size());
+    std::vector<const char*> values;
+    values.reserve(keys.size());
+    std::vector<uint32_t> lengths;
+    lengths.reserve(keys.size());
+    auto keyNode = lysc_node_child(list);
+    for (std::size_t i = 0; i < keys.size(); ++i, keyNode = keyNode->next) {
+        auto type = reinterpret_cast<const lysc_node_leaf*>(keyNode)->type;
+        auto realType = type->basetype == LY_TYPE_LEAFREF ? reinterpret_cast<const lysc_type_leafref*>(type)->realtype : type;
+        if (auto str = std::get_if<std::string>(&keys[i]); str && realType->basetype == LY_TYPE_STRING) {
+            values.emplace_back(str->data());
+            lengths.emplace_back(static_cast<uint32_t>(str->size()));
+        } else if (auto len = nativeLybValue(type, keys[i], buffers[i])) {
+            values.emplace_back(reinterpret_cast<const char*>(buffers[i].data()));
+            lengths.emplace_back(*len);
+        } else {
+            break;
+        }
+    }
+
+    const bool binary = values.size() == keys.size();
+    std::vector<std::string> converted;
+    if (!binary) {
+        // Strings are passed as-is, only the other types need a storage for their lexical representation
+        values.clear();
+        converted.reserve(keys.size());
+        for (const auto& key : keys) {
+            if (auto str = std::get_if<std::string>(&key)) {
+                values.emplace_back(str->c_str());
+            } else {
+                values.emplace_back(converted.emplace_back(impl::lexicalValue(key)).c_str());
+            }
+        }
+    }
+
+    // libyang looks up the schema node of the new instance within its parent, so lists which are not top-level need a
+    // (shallow) copy of the parent to be created in.
+    lyd_node* holder = nullptr;
+    if (lysc_data_parent(list)) {
+        if (!sibling->parent) {
+            return nullptr;
+        }
+        auto ret = lyd_dup_single(lyd_parent(sibling), nullptr, 0, &holder);
+        throwIfError(ret, where + ": lyd_dup_single failed");
+    }
+    auto holderDeleter = std::unique_ptr<lyd_node, decltype([](lyd_node* node) { lyd_free_all(node); })>{holder};
+
+    lyd_node* target;
+    auto ret = lyd_new_list3(holder, list->module, list->name, values.data(), binary ? lengths.data() : nullptr, binary ? LYD_NEW_VAL_BIN : 0, &target);
+    throwIfError(ret, where + ": lyd_new_list3 failed");
+    if (holder) {
+        // the instance is compared by its schema node and its keys, the parent is not needed anymore
+        lyd_unlink_tree(target);
+    }
+    return target;
+}
+
+/**
+ * @brief Returns the sibling which matches `target`, or nullptr if there's none.
+ */
+lyd_node* findSiblingFirst(const lyd_node* siblings, const lyd_node* target, const std::string& where)
+{
+    lyd_node* match;
+    auto ret = lyd_find_sibling_first(siblings, target, &match);
+    switch (ret) {
+    case LY_SUCCESS:
+        return match;
+    case LY_ENOTFOUND:
+        return nullptr;
+    default:
+        throwError(ret, where + ": couldn't find sibling");
+    }
+}
+}
+
+/**
+ * @brief Finds the sibling instance of the `list` whose keys are equal to `keys`.
+ *
+ * The key values are given in the order of the keys within the schema. Unlike findSiblingVal(), there's no predicate
+ * to format and parse; numbers, booleans, decimal64 values and strings are passed to libyang in their binary form, and
+ * the lookup goes straight through the hash table of the siblings. When the same keys are looked up many times, e.g.,
+ * in several versions of a tree, prepare them just once via listInstanceKey().
+ *
+ * @return The found DataNode. std::nullopt if no node is found.
+ *
+ * Wraps `lyd_new_list3` and `lyd_find_sibling_first`.
+ */
+std::optional<DataNode> DataNode::findListInstance(const SchemaNode& list, std::span<const Value> keys) const
+{
+    auto target = std::unique_ptr<lyd_node, decltype([](lyd_node* node) { lyd_free_tree(node); })>{
+        newListInstance(m_node, list.m_node, keys, "DataNode::findListInstance")};
+    if (!target) {
+        return std::nullopt;
+    }
+    if (auto match = findSiblingFirst(m_node, target.get(), "DataNode::findListInstance")) {
+        return DataNode{match, m_refs};
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Prepares the `keys` of a `list` instance for repeated lookups via findListInstance(const ListInstanceKey&).
+ *
+ * The result can be used with the siblings of any instance of `list` within the same context, e.g., within several
+ * versions of a tree, or below several instances of its parent. This node is only needed for creating the key; if
+ * `list` is not top-level, this node has to be a child of an instance of its parent.
+ *
+ * Wraps `lyd_new_list3`.
+ */
+ListInstanceKey DataNode::listInstanceKey(const SchemaNode& list, std::span<const Value> keys) const
+{
+    auto target = newListInstance(m_node, list.m_node, keys, "DataNode::listInstanceKey");
+    if (!target) {
+        throw Error{"DataNode::listInstanceKey: `list` is not top-level, but this node is"};
+    }
+    return ListInstanceKey{target, m_refs ? m_refs->context : nullptr};
+}
+
+/**
+ * @brief Finds the sibling instance of a list with the prepared `key`.
+ *
+ * Throws if the `key` was prepared in a different context.
+ *
+ * @return The found DataNode. std::nullopt if no node is found.
+ *
+ * Wraps `lyd_find_sibling_first`.
+ */
+std::optional<DataNode> DataNode::findListInstance(const ListInstanceKey& key) const
+{
+    if (LYD_CTX(key.m_node.get()) != LYD_CTX(m_node)) {
+        throw Error{"DataNode::findListInstance: the key was prepared in a different context"};
+    }
+    if (auto match = findSiblingFirst(m_node, key.m_node.get(), "DataNode::findListInstance")) {
+        return DataNode{match, m_refs};
+    }
+    return std::nullopt;
+}
+
+ListInstanceKey::ListInstanceKey(lyd_node* node, std::shared_ptr<ly_ctx> ctx)
+    : m_node(node, lyd_free_tree)
+    , m_ctx(std::move(ctx))
+{
+}
+
+/**
+ * @brief Finds the sibling which is an instance of the same schema node as `target`, and which has the same keys (for
+ * lists) or the same value (for leaf-lists).
+ *
+ * The `target` usually comes from another tree. The lookup uses the hash table of the siblings, so it is the cheapest way
+ * of finding the counterpart of a node.
+ *
+ * @return The found DataNode. std::nullopt if no node is found.
+ *
+ * Wraps `lyd_find_sibling_first`.
+ */
+std::optional<DataNode> DataNode::findSibling(const DataNode& target) const
+{
+    lyd_node* match;
+    auto ret = lyd_find_sibling_first(m_node, target.m_node, &match);
+
+    switch (ret) {
+    case LY_SUCCESS:
+        return DataNode{match, m_refs};
+    case LY_ENOTFOUND:
+        return std::nullopt;
+    default:
+        throwError(ret, "DataNode::findSibling: couldn't find sibling");
+    }
+}
+
 /**
  * Checks whether a node is opaque, i.e. it doesn't have a schema node associated with it.
  */
@@ -1122,8 +2834,107 @@ std::string DataNodeOpaque::value() const
     return reinterpret_cast<lyd_node_opaq*>(m_node)->value;
 }
 
+DataNodeRef::DataNodeRef(lyd_node* node, const bool* valid, const std::shared_ptr<internal_refcount>* refs)
+    : m_node(node)
+    , m_valid(valid)
+    , m_refs(refs)
+{
+}
+
+void DataNodeRef::throwIfInvalid() const
+{
+    if (!*m_valid) {
+        throw std::out_of_range("DataNodeRef is invalid");
+    }
+}
+
+/**
+ * @brief Returns the name of the node. For opaque nodes, this is the name without the prefix.
+ */
+std::string_view DataNodeRef::name() const
+{
+    throwIfInvalid();
+    if (isOpaque()) {
+        return reinterpret_cast<const lyd_node_opaq*>(m_node)->name.name;
+    }
+    return m_node->schema->name;
+}
+
+/**
+ * @brief Returns the associated SchemaNode. Does not work for opaque nodes.
+ */
+SchemaNode DataNodeRef::schema() const
+{
+    throwIfInvalid();
+    if (isOpaque()) {
+        throw Error{"DataNodeRef::schema(): node is opaque"};
+    }
+    return SchemaNode{m_node->schema, *m_refs ? (*m_refs)->context : nullptr};
+}
+
+/**
+ * @brief Returns the path of the referenced node.
+ *
+ * Wraps `lyd_path`.
+ */
+std::string DataNodeRef::path() const
+{
+    throwIfInvalid();
+    return nodePath(m_node);
+}
+
+/**
+ * @brief Check whether this is a term node (a leaf or a leaf-list).
+ */
+bool DataNodeRef::isTerm() const
+{
+    throwIfInvalid();
+    return m_node->schema && (m_node->schema->nodetype & LYD_NODE_TERM);
+}
+
+/**
+ * @brief Check whether this is an opaque node.
+ */
+bool DataNodeRef::isOpaque() const
+{
+    throwIfInvalid();
+    return !m_node->schema;
+}
+
+/**
+ * @brief Retrieves a non-owning view of the value of a term node, see DataNodeTerm::valueView.
+ * @throws Error If not a leaf or a leaflist
+ */
+ValueView DataNodeRef::valueView() const
+{
+    if (!isTerm()) {
+        throw Error("Node is not a leaf or a leaflist");
+    }
+    return DataNodeTerm::valueViewOf(m_node);
+}
+
+/**
+ * @brief Returns a full DataNode which is not bound to the lifetime of the original collection.
+ */
+DataNode DataNodeRef::node() const
+{
+    throwIfInvalid();
+    return DataNode{m_node, *m_refs};
+}
+
+/**
+ * @brief Checks whether both references point to the same node.
+ */
+bool DataNodeRef::operator==(const DataNodeRef& other) const
+{
+    return m_node == other.m_node;
+}
+
 /**
  * Wraps a raw non-null lyd_node pointer.
+ *
+ * The tree is not associated with any Context, so it does not count towards Context::stats(), and
+ * SchemaNode::pathView() throws for its schema nodes.
  * @param node The pointer to be wrapped. Must not be null.
  * @returns The wrapped pointer.
  */
@@ -1135,7 +2946,7 @@ DataNode wrapRawNode(lyd_node* node, std::shared_ptr<void> customCtx)
 
     return DataNode{
         node,
-        std::make_shared<internal_refcount>(
+        impl::makeShared<internal_refcount>(
                 std::shared_ptr<ly_ctx>(node->schema ? node->schema->module->ctx : nullptr, [](ly_ctx*) {}),
                 customCtx)};
 }
@@ -1162,6 +2973,7 @@ const DataNode wrapUnmanagedRawNode(const lyd_node* node)
  */
 lyd_node* releaseRawNode(DataNode node)
 {
+    node.unregisterRef();
     node.m_refs = nullptr;
     return node.m_node;
 }
@@ -1190,12 +3002,58 @@ void validateAll(std::optional<libyang::DataNode>& node, const std::optional<Val
         throw Error("validateAll: Node is not a unique reference");
     }
 
-    // TODO: support the `diff` argument
-    auto ret = lyd_validate_all(node ? &node->m_node : nullptr, nullptr, opts ? utils::toValidationOptions(*opts) : 0, nullptr);
-    throwIfError(ret, "libyang:validateAll: lyd_validate_all failed");
+    {
+        // The span must end before the tree (and possibly the whole context) is released below
+        impl::stats_span span{impl::statsOf(node ? node->m_refs.get() : nullptr), StatsOperation::Validate};
+        // TODO: support the `diff` argument
+        auto ret = lyd_validate_all(node ? &node->m_node : nullptr, nullptr, opts ? utils::toValidationOptions(*opts) : 0, nullptr);
+        throwIfError(ret, "libyang:validateAll: lyd_validate_all failed");
+    }
+
+    if (!node->m_node) {
+        node = std::nullopt;
+    } else if (node->m_refs) {
+        node->m_refs->markValidated();
+    }
+}
+
+/**
+ * Validate `node`, but only the data of those modules which were changed since the tree was last validated. DANGEROUS,
+ * the same restrictions as for validateAll() apply.
+ *
+ * The changes are recorded by all methods which modify the tree, e.g., newPath(), DataNodeTerm::changeValue(),
+ * insertChild() or unlink(). If the tree was never validated as a whole (by validateAll(), by this function, or by
+ * Context::parseData() without ParseOptions::ParseOnly), or if it is not possible to tell which modules have changed,
+ * the whole tree is validated.
+ *
+ * Constraints which refer to data of another module (e.g., a leafref or a `must` expression which points into another
+ * module) are only checked when the module which contains them is validated. Use validateAll() after changes which
+ * could break such constraints.
+ *
+ * Wraps `lyd_validate_module`.
+ */
+void validateIncremental(std::optional<libyang::DataNode>& node, const std::optional<ValidationOptions>& opts)
+{
+    if (!node || !node->m_refs || !node->m_refs->validated) {
+        validateAll(node, opts);
+        return;
+    }
+
+    if (node->m_refs.use_count() != 1) {
+        throw Error("validateIncremental: Node is not a unique reference");
+    }
+
+    auto refs = node->m_refs;
+    impl::stats_span span{refs->stats, StatsOperation::Validate};
+    for (const auto module : refs->touchedModules) {
+        auto ret = lyd_validate_module(&node->m_node, module, opts ? utils::toValidationOptions(*opts) : 0, nullptr);
+        throwIfError(ret, std::string{"libyang:validateIncremental: lyd_validate_module failed for module '"} + module->name + "'");
+    }
 
     if (!node->m_node) {
         node = std::nullopt;
+    } else {
+        refs->markValidated();
     }
 }
 
@@ -1212,6 +3070,7 @@ Set<DataNode> findXPathAt(
         const libyang::DataNode& forest,
         const std::string& xpath)
 {
+    impl::stats_span span{impl::statsOf(forest.m_refs.get()), StatsOperation::FindXPath};
     ly_set* set;
     auto ret = lyd_find_xpath3(contextNode ? contextNode->m_node : nullptr, forest.m_node, xpath.c_str(),
             LY_VALUE_JSON, nullptr, nullptr, &set);
@@ -1221,6 +3080,40 @@ Set<DataNode> findXPathAt(
     return Set<DataNode>{set, forest.m_refs};
 }
 
+/** @short Find instances matching a pre-checked XPath
+ *
+ * Throws if the `xpath` was checked in a different context. See the `std::string` overload for details.
+ */
+Set<DataNode> findXPathAt(
+        const std::optional<libyang::DataNode>& contextNode,
+        const libyang::DataNode& forest,
+        const CheckedXPath& xpath)
+{
+    xpath.checkContext(forest.m_node, "libyang::findXPathAt");
+    return findXPathAt(contextNode, forest, *xpath.m_expression);
+}
+
+CheckedXPath::CheckedXPath(std::shared_ptr<const std::string> expression, std::shared_ptr<ly_ctx> ctx)
+    : m_expression(std::move(expression))
+    , m_ctx(std::move(ctx))
+{
+}
+
+/**
+ * @brief Returns the original XPath expression.
+ */
+const std::string& CheckedXPath::expression() const
+{
+    return *m_expression;
+}
+
+void CheckedXPath::checkContext(const lyd_node* node, const char* where) const
+{
+    if (LYD_CTX(node) != m_ctx.get()) {
+        throw Error{std::string{where} + ": XPath '" + *m_expression + "' was checked in a different context"};
+    }
+}
+
 /** @short Parses data from a string into a subtree of the current node
  *
  * Due to the C API design and operation, it's strongly recommended to use ParseOptions::ParseOnly to skip validation
@@ -1245,7 +3138,26 @@ void DataNode::parseSubtree(
         const std::optional<ParseOptions> parseOpts,
         const std::optional<ValidationOptions> validationOpts)
 {
-    auto in = wrap_ly_in_new_memory(data);
+    parseSubtree(asNulTerminatedBytes(data), format, parseOpts, validationOpts);
+}
+
+/**
+ * @brief Parses data from a memory buffer into libyang, appending them to this node.
+ *
+ * See Context::parseData for when the buffer is parsed in place.
+ *
+ * Wraps `lyd_parse_data()`.
+ */
+void DataNode::parseSubtree(
+        std::span<const std::byte> data,
+        const DataFormat format,
+        const std::optional<ParseOptions> parseOpts,
+        const std::optional<ValidationOptions> validationOpts)
+{
+    throwIfFrozen("DataNode::parseSubtree");
+    recordChange();
+    std::string storage;
+    auto in = wrap_ly_in_new_memory(data, storage);
     auto ret = lyd_parse_data(m_refs->context.get(),
             m_node,
             in.get(),
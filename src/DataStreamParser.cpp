@@ -0,0 +1,468 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/DataStreamParser.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include "utils/context.hpp"
+#include "utils/deleters.hpp"
+#include "utils/enum.hpp"
+
+namespace libyang {
+namespace {
+bool isWhitespace(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::string_view localName(std::string_view name)
+{
+    auto colon = name.find(':');
+    return colon == std::string_view::npos ? name : name.substr(colon + 1);
+}
+
+/**
+ * @brief Returns the name of the XML tag which starts at `tag` (right after the `<` or the `</`).
+ */
+std::string_view xmlTagName(std::string_view tag)
+{
+    auto end = std::find_if(tag.begin(), tag.end(), [](const char c) { return isWhitespace(c) || c == '/' || c == '>'; });
+    return tag.substr(0, end - tag.begin());
+}
+}
+
+DataStreamParser::DataStreamParser(std::shared_ptr<ly_ctx> ctx, const DataFormat format, std::function<void(DataNode)> callback, const std::optional<ParseOptions> opts, DataStreamRecordPath recordPath)
+    : m_ctx(std::move(ctx))
+    , m_format(format)
+    , m_callback(std::move(callback))
+    , m_opts(opts)
+    , m_recordPath(std::move(recordPath))
+{
+    if (m_format != DataFormat::JSON && m_format != DataFormat::XML) {
+        throw Error{"DataStreamParser: only JSON and XML can be parsed as a stream"};
+    }
+}
+
+/**
+ * @brief Parses another chunk of the input.
+ *
+ * The callback is invoked for each record which was completed by this chunk, see Context::parseDataStream(). Exceptions from parsing a record or from
+ * the callback are propagated; the record is dropped in that case, and parsing can continue with the next chunk.
+ */
+void DataStreamParser::feed(std::string_view chunk)
+{
+    m_pending.append(chunk);
+    if (m_format == DataFormat::JSON) {
+        scanJson();
+    } else {
+        scanXml();
+    }
+}
+
+/**
+ * @brief Parses another chunk of the input.
+ */
+void DataStreamParser::feed(std::span<const std::byte> chunk)
+{
+    feed(std::string_view{reinterpret_cast<const char*>(chunk.data()), chunk.size()});
+}
+
+/**
+ * @brief Checks that the input has ended at a record boundary, throws otherwise.
+ */
+void DataStreamParser::finish()
+{
+    auto rest = std::string_view{m_pending}.substr(m_pos);
+    bool onlyWhitespace = std::all_of(rest.begin(), rest.end(), isWhitespace);
+    bool complete = m_format == DataFormat::JSON ? (m_jsonState == JsonState::End || m_jsonState == JsonState::Start) : (m_depth == 0 && m_level == 0);
+    if (!complete || !onlyWhitespace) {
+        throw Error{"DataStreamParser::finish: the input has ended in the middle of a record"};
+    }
+}
+
+/**
+ * @brief Drops the first `keep` bytes of the pending input, these have been processed already.
+ */
+void DataStreamParser::compact(const std::size_t keep)
+{
+    // Erasing from the front is linear, so only bother once the consumed part dominates the buffer.
+    if (keep == 0 || keep < m_pending.size() / 2) {
+        return;
+    }
+    m_pending.erase(0, keep);
+    m_pos -= keep;
+    m_start -= std::min(m_start, keep);
+}
+
+/**
+ * @brief Checks whether a member or an element called `name` at the current position is the next wrapper or parent of
+ * the records.
+ */
+bool DataStreamParser::entersRecordParent(std::string_view name) const
+{
+    const auto& wrappers = m_recordPath.wrappers;
+    const auto& parents = m_recordPath.parents;
+    if (m_level >= wrappers.size() + parents.size()) {
+        return false;
+    }
+    std::string_view step = m_level < wrappers.size() ? wrappers[m_level] : parents[m_level - wrappers.size()];
+    return m_format == DataFormat::JSON ? name == step : localName(name) == localName(step);
+}
+
+void DataStreamParser::enterRecordParent(std::string opening, std::string closing)
+{
+    // wrappers are not data nodes, so they are not a part of the records
+    if (m_level >= m_recordPath.wrappers.size()) {
+        m_openParents.emplace_back(std::move(opening), std::move(closing));
+    }
+    ++m_level;
+}
+
+void DataStreamParser::leaveRecordParent()
+{
+    if (m_level > m_recordPath.wrappers.size()) {
+        m_openParents.pop_back();
+    }
+    --m_level;
+}
+
+/**
+ * @brief Puts the parents of the records around a record.
+ */
+std::string DataStreamParser::wrapRecord(const std::string& record) const
+{
+    std::string res = m_format == DataFormat::JSON ? "{" : "";
+    for (const auto& [opening, closing] : m_openParents) {
+        res += opening;
+    }
+    res += record;
+    for (auto it = m_openParents.rbegin(); it != m_openParents.rend(); ++it) {
+        res += it->second;
+    }
+    if (m_format == DataFormat::JSON) {
+        res += "}";
+    }
+    return res;
+}
+
+/**
+ * @brief Holds a complete JSON member until it's clear that its metadata don't follow.
+ *
+ * The `@name` member with the metadata of `name` can come either before or after it, and it must be parsed in the same
+ * record. Returns the record which is to be emitted now, if any.
+ */
+std::string DataStreamParser::holdJsonMember(std::string member, std::string name)
+{
+    if (!m_heldMember.empty() && (m_heldName == "@" + name || name == "@" + m_heldName)) {
+        auto record = wrapRecord(m_heldMember + "," + member);
+        m_heldMember.clear();
+        return record;
+    }
+    auto record = takeHeldJsonMember();
+    m_heldMember = std::move(member);
+    m_heldName = std::move(name);
+    return record;
+}
+
+/**
+ * @brief Returns the record of the held JSON member, if any. This must be called before the parents change.
+ */
+std::string DataStreamParser::takeHeldJsonMember()
+{
+    if (m_heldMember.empty()) {
+        return {};
+    }
+    auto record = wrapRecord(m_heldMember);
+    m_heldMember.clear();
+    return record;
+}
+
+void DataStreamParser::emit(const std::string& record)
+{
+    impl::stats_span span{impl::contextStats(m_ctx), StatsOperation::ParseData};
+    auto in = wrap_ly_in_new_memory(record);
+
+    // A single record cannot be validated on its own, constraints might refer to the other records.
+    lyd_node* tree;
+    auto err = lyd_parse_data(
+            m_ctx.get(),
+            nullptr,
+            in.get(),
+            utils::toLydFormat(m_format),
+            (m_opts ? utils::toParseOptions(*m_opts) : 0) | LYD_PARSE_ONLY,
+            0,
+            &tree);
+    throwIfError(err, "DataStreamParser: can't parse a record");
+
+    if (tree) {
+        m_callback(DataNode{tree, m_ctx});
+    }
+}
+
+void DataStreamParser::scanJson()
+{
+    // Unquotes a member name, escapes do not matter for telling the members apart
+    auto memberName = [](const std::string& quoted) {
+        return quoted.substr(1, quoted.size() - 2);
+    };
+
+    while (m_pos < m_pending.size()) {
+        const auto c = m_pending[m_pos];
+        switch (m_jsonState) {
+        case JsonState::Start:
+            if (c == '{') {
+                m_jsonState = JsonState::ExpectKey;
+            } else if (!isWhitespace(c)) {
+                throw Error{"DataStreamParser: a JSON document must be an object"};
+            }
+            break;
+        case JsonState::ExpectKey:
+        case JsonState::AfterMember:
+            if (m_jsonState == JsonState::ExpectKey && c == '"') {
+                m_start = m_pos;
+                m_jsonState = JsonState::InKey;
+            } else if (m_jsonState == JsonState::AfterMember && c == ',') {
+                m_jsonState = JsonState::ExpectKey;
+            } else if (c == '}') {
+                auto record = takeHeldJsonMember();
+                if (m_level == 0) {
+                    m_jsonState = JsonState::End;
+                } else {
+                    leaveRecordParent();
+                    m_jsonState = JsonState::AfterMember;
+                }
+                ++m_pos;
+                if (!record.empty()) {
+                    emit(record);
+                }
+                continue;
+            } else if (!isWhitespace(c)) {
+                throw Error{m_jsonState == JsonState::ExpectKey ? "DataStreamParser: expected a member name" : "DataStreamParser: expected a ',' or a '}'"};
+            }
+            break;
+        case JsonState::InKey:
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_jsonKey = m_pending.substr(m_start, m_pos + 1 - m_start);
+                m_jsonState = JsonState::ExpectColon;
+            }
+            break;
+        case JsonState::ExpectColon:
+            if (c == ':') {
+                m_jsonState = JsonState::ExpectValue;
+            } else if (!isWhitespace(c)) {
+                throw Error{"DataStreamParser: expected a ':'"};
+            }
+            break;
+        case JsonState::ExpectValue:
+            if (isWhitespace(c)) {
+                break;
+            }
+            if (c == '[') {
+                // each entry of a list is a record on its own, but that is only clear once the first entry starts
+                m_start = m_pos;
+                m_firstElement = true;
+                m_jsonState = JsonState::ExpectElement;
+                break;
+            }
+            if (c == '{' && entersRecordParent(memberName(m_jsonKey))) {
+                auto record = takeHeldJsonMember();
+                enterRecordParent(m_jsonKey + ":{", "}");
+                m_jsonState = JsonState::ExpectKey;
+                ++m_pos;
+                if (!record.empty()) {
+                    emit(record);
+                }
+                continue;
+            }
+            m_inArray = false;
+            m_start = m_pos;
+            m_depth = 0;
+            m_jsonState = JsonState::InValue;
+            continue; // the first character of the value is scanned below
+        case JsonState::ExpectElement:
+            if (isWhitespace(c)) {
+                break;
+            }
+            if (c == ']') {
+                m_jsonState = JsonState::AfterMember;
+                break;
+            }
+            if (m_firstElement && c != '{') {
+                // a leaf-list stays in one piece, so that its metadata can go along with it; `m_start` is at the '['
+                m_inArray = false;
+                m_depth = 1;
+            } else {
+                m_inArray = true;
+                m_start = m_pos;
+                m_depth = 0;
+            }
+            m_jsonState = JsonState::InValue;
+            continue; // the first character of the value is scanned below
+        case JsonState::InValue: {
+            bool endsBefore = false;
+            bool endsAfter = false;
+            if (m_inString) {
+                if (m_escape) {
+                    m_escape = false;
+                } else if (c == '\\') {
+                    m_escape = true;
+                } else if (c == '"') {
+                    m_inString = false;
+                    endsAfter = m_depth == 0;
+                }
+            } else if (c == '"') {
+                m_inString = true;
+            } else if (c == '{' || c == '[') {
+                ++m_depth;
+            } else if (c == '}' || c == ']') {
+                if (m_depth == 0) {
+                    endsBefore = true;
+                } else {
+                    endsAfter = --m_depth == 0;
+                }
+            } else if (m_depth == 0 && (c == ',' || isWhitespace(c))) {
+                endsBefore = true;
+            }
+
+            if (!endsBefore && !endsAfter) {
+                break;
+            }
+            auto end = endsAfter ? m_pos + 1 : m_pos;
+            auto value = std::string_view{m_pending}.substr(m_start, end - m_start);
+            m_jsonState = m_inArray ? JsonState::AfterElement : JsonState::AfterMember;
+            m_pos = end;
+            m_start = end;
+            auto record = holdJsonMember(m_jsonKey + ":" + (m_inArray ? "[" + std::string{value} + "]" : std::string{value}), memberName(m_jsonKey));
+            if (!record.empty()) {
+                emit(record);
+            }
+            compact(m_pos);
+            continue;
+        }
+        case JsonState::AfterElement:
+            if (c == ',') {
+                m_firstElement = false;
+                m_jsonState = JsonState::ExpectElement;
+            } else if (c == ']') {
+                m_jsonState = JsonState::AfterMember;
+            } else if (!isWhitespace(c)) {
+                throw Error{"DataStreamParser: expected a ',' or a ']'"};
+            }
+            break;
+        case JsonState::End:
+            if (!isWhitespace(c)) {
+                throw Error{"DataStreamParser: unexpected data after the end of the JSON document"};
+            }
+            break;
+        }
+        ++m_pos;
+    }
+
+    const bool keepStart = m_jsonState == JsonState::InKey || m_jsonState == JsonState::InValue || (m_jsonState == JsonState::ExpectElement && m_firstElement);
+    compact(keepStart ? m_start : m_pos);
+}
+
+void DataStreamParser::scanXml()
+{
+    // Returns the position right after `terminator`, or npos if it hasn't arrived yet
+    auto skipPast = [this](const std::string_view terminator) {
+        auto found = m_pending.find(terminator, m_pos);
+        return found == std::string::npos ? found : found + terminator.size();
+    };
+
+    while (m_pos < m_pending.size()) {
+        if (m_pending[m_pos] != '<') {
+            if (m_depth == 0 && !isWhitespace(m_pending[m_pos])) {
+                throw Error{"DataStreamParser: unexpected text outside of an XML element"};
+            }
+            ++m_pos;
+            continue;
+        }
+
+        // Each markup construct is only processed once it has arrived completely.
+        auto rest = std::string_view{m_pending}.substr(m_pos);
+        if (rest.size() < 2) {
+            break;
+        }
+
+        std::size_t end;
+        bool recordComplete = false;
+        if (rest.starts_with("<!--")) {
+            end = skipPast("-->");
+        } else if (rest.starts_with("<![CDATA[")) {
+            end = skipPast("]]>");
+        } else if (std::string_view{"<!--"}.starts_with(rest) || std::string_view{"<![CDATA["}.starts_with(rest)) {
+            break;
+        } else if (rest.starts_with("<?") || rest.starts_with("<!")) {
+            end = skipPast(">");
+        } else if (rest.starts_with("</")) {
+            end = skipPast(">");
+            if (end != std::string::npos) {
+                if (m_depth > 0) {
+                    recordComplete = --m_depth == 0;
+                } else if (m_level > 0) {
+                    leaveRecordParent();
+                } else {
+                    throw Error{"DataStreamParser: unexpected closing XML tag"};
+                }
+            }
+        } else {
+            // attribute values might contain '>'
+            end = std::string::npos;
+            char quote = 0;
+            for (auto pos = m_pos + 1; pos < m_pending.size(); ++pos) {
+                const auto c = m_pending[pos];
+                if (quote) {
+                    quote = c == quote ? 0 : quote;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '>') {
+                    end = pos + 1;
+                    break;
+                }
+            }
+            if (end != std::string::npos) {
+                const bool selfClosing = m_pending[end - 2] == '/';
+                auto name = xmlTagName(rest.substr(1));
+                if (m_depth == 0 && !selfClosing && entersRecordParent(name)) {
+                    enterRecordParent(m_pending.substr(m_pos, end - m_pos), "</" + std::string{name} + ">");
+                } else {
+                    if (m_depth == 0) {
+                        m_start = m_pos;
+                    }
+                    if (!selfClosing) {
+                        ++m_depth;
+                    } else {
+                        recordComplete = m_depth == 0;
+                    }
+                }
+            }
+        }
+
+        if (end == std::string::npos) {
+            break;
+        }
+        m_pos = end;
+
+        if (recordComplete) {
+            auto record = wrapRecord(m_pending.substr(m_start, m_pos - m_start));
+            m_start = m_pos;
+            emit(record);
+        }
+        if (m_depth == 0) {
+            compact(m_pos);
+        }
+    }
+
+    compact(m_depth ? m_start : m_pos);
+}
+}
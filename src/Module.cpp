@@ -14,6 +14,7 @@
 #include <libyang/libyang.h>
 #include <span>
 #include <stack>
+#include "utils/context.hpp"
 #include "utils/deleters.hpp"
 #include "utils/enum.hpp"
 
@@ -114,6 +115,8 @@ bool Module::featureEnabled(const std::string& featureName) const
  */
 void Module::setImplemented()
 {
+    impl::throwIfSchemaLocked(m_ctx, "Module::setImplemented");
+    impl::schemaChanged(m_ctx);
     auto err = lys_set_implemented(m_module, nullptr);
     throwIfError(err, "Couldn't set module '" + name() + "' to implemented");
 }
@@ -128,6 +131,8 @@ void Module::setImplemented()
  */
 void Module::setImplemented(std::vector<std::string> features)
 {
+    impl::throwIfSchemaLocked(m_ctx, "Module::setImplemented");
+    impl::schemaChanged(m_ctx);
     auto featuresArray = std::make_unique<const char*[]>(features.size() + 1);
     std::transform(features.begin(), features.end(), featuresArray.get(), [](const auto& feature) {
         return feature.c_str();
@@ -199,14 +204,16 @@ std::optional<SchemaNode> Module::child() const
 /**
  * @brief Returns a collection of data instantiable top-level nodes of this module.
  *
+ * The nodes are looked up once for each set of `options`, and then cached within the context until the schema changes.
+ *
  * Wraps `lys_getnext`.
  */
-ChildInstanstiables Module::childInstantiables() const
+ChildInstanstiables Module::childInstantiables(const std::optional<GetNextOptions> options) const
 {
     if (!m_module->implemented) {
         throw Error{"Module::childInstantiables: module is not implemented"};
     }
-    return ChildInstanstiables{nullptr, m_module->compiled, m_ctx};
+    return ChildInstanstiables{nullptr, m_module->compiled, options ? utils::toGetNextOptions(*options) : 0, m_ctx};
 }
 
 /**
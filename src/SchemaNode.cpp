@@ -15,7 +15,10 @@
 #include <libyang/libyang.h>
 #include <libyang/tree.h>
 #include <libyang/tree_schema.h>
+#include <mutex>
 #include <span>
+#include <type_traits>
+#include "utils/context.hpp"
 #include "utils/deleters.hpp"
 #include "utils/enum.hpp"
 
@@ -47,6 +50,38 @@ Module SchemaNode::module() const
     return Module{m_node->module, m_ctx};
 }
 
+namespace {
+std::string computePath(const lysc_node* node)
+{
+    // TODO: support all path formats
+    auto strDeleter = std::unique_ptr<char, deleter_free_t>(lysc_path(node, LYSC_PATH_DATA, nullptr, 0));
+    if (!strDeleter) {
+        throw std::bad_alloc();
+    }
+
+    return strDeleter.get();
+}
+
+std::string_view cachedPath(const lysc_node* node, const std::shared_ptr<ly_ctx>& ctx, const char* where)
+{
+    auto state = ctx ? impl::contextState(ctx) : nullptr;
+    if (!state) {
+        throw Error(std::string{where} + ": the node does not belong to a managed context");
+    }
+
+    {
+        std::shared_lock lock{state->pathsMutex};
+        if (auto it = state->paths.find(node); it != state->paths.end()) {
+            return it->second;
+        }
+    }
+
+    auto path = computePath(node);
+    std::unique_lock lock{state->pathsMutex};
+    return state->paths.try_emplace(node, std::move(path)).first->second;
+}
+}
+
 /**
  * @brief Returns the schema path of this node.
  *
@@ -54,13 +89,25 @@ Module SchemaNode::module() const
  */
 std::string SchemaNode::path() const
 {
-    // TODO: support all path formats
-    auto strDeleter = std::unique_ptr<char, deleter_free_t>(lysc_path(m_node, LYSC_PATH_DATA, nullptr, 0));
-    if (!strDeleter) {
-        throw std::bad_alloc();
+    if (m_ctx && impl::contextState(m_ctx)) {
+        return std::string{pathView()};
     }
 
-    return strDeleter.get();
+    return computePath(m_node);
+}
+
+/**
+ * @brief Returns the schema path of this node without copying it.
+ *
+ * The path is computed once and then cached within the context. The view remains valid for as long as the schema of
+ * the context does not change (i.e., until the next module is parsed, loaded or implemented), and as long as the
+ * context is alive. This is safe to call from several threads if the schema is locked (see Context::lockSchema()).
+ *
+ * Wraps `lysc_path`.
+ */
+std::string_view SchemaNode::pathView() const
+{
+    return cachedPath(m_node, m_ctx, "SchemaNode::pathView");
 }
 
 /**
@@ -75,14 +122,29 @@ std::string SchemaNode::name() const
     return m_node->name;
 }
 
+/**
+ * @brief Returns the name of this node without copying it.
+ *
+ * The view points directly into the schema, it remains valid for as long as the schema of the context does not change.
+ *
+ * Wraps `lysc_node::name`.
+ */
+std::string_view SchemaNode::nameView() const
+{
+    return m_node->name;
+}
+
 /**
  * @brief Returns a collection of data-instantiable children. The order of schema order.
  *
+ * The children are looked up once for each node and set of `options`, and then cached within the context until the
+ * schema changes.
+ *
  * Wraps `lys_getnext`.
  */
-ChildInstanstiables SchemaNode::childInstantiables() const
+ChildInstanstiables SchemaNode::childInstantiables(const std::optional<GetNextOptions> options) const
 {
-    return ChildInstanstiables{m_node, nullptr, m_ctx};
+    return ChildInstanstiables{m_node, nullptr, options ? utils::toGetNextOptions(*options) : 0, m_ctx};
 }
 
 /**
@@ -336,6 +398,98 @@ bool SchemaNode::operator!=(const SchemaNode& other) const
     return m_node != other.m_node;
 }
 
+/**
+ * @brief Returns a borrowed reference to this node, see SchemaNodeView for the lifetime rules.
+ */
+SchemaNodeView SchemaNode::view() const&
+{
+    return SchemaNodeView{m_node, &m_ctx};
+}
+
+static_assert(std::is_trivially_copyable_v<SchemaNodeView>);
+
+SchemaNodeView::SchemaNodeView(const lysc_node* node, const std::shared_ptr<ly_ctx>* ctx)
+    : m_node(node)
+    , m_ctx(ctx)
+{
+}
+
+/**
+ * @brief Returns the name of this node, see SchemaNode::nameView.
+ */
+std::string_view SchemaNodeView::name() const
+{
+    return m_node->name;
+}
+
+/**
+ * @brief Returns the name of the module of this node.
+ */
+std::string_view SchemaNodeView::moduleName() const
+{
+    return m_node->module->name;
+}
+
+/**
+ * @brief Returns the schema path of this node, see SchemaNode::pathView.
+ */
+std::string_view SchemaNodeView::pathView() const
+{
+    return cachedPath(m_node, *m_ctx, "SchemaNodeView::pathView");
+}
+
+NodeType SchemaNodeView::nodeType() const
+{
+    return utils::toNodeType(m_node->nodetype);
+}
+
+/**
+ * @brief Returns the first child node of this node, see SchemaNode::child.
+ */
+std::optional<SchemaNodeView> SchemaNodeView::child() const
+{
+    auto child = lysc_node_child(m_node);
+    if (!child) {
+        return std::nullopt;
+    }
+    return SchemaNodeView{child, m_ctx};
+}
+
+/**
+ * @brief Returns the parent node of this node, see SchemaNode::parent.
+ */
+std::optional<SchemaNodeView> SchemaNodeView::parent() const
+{
+    if (!m_node->parent) {
+        return std::nullopt;
+    }
+    return SchemaNodeView{m_node->parent, m_ctx};
+}
+
+/**
+ * @brief Returns the following sibling of this node.
+ */
+std::optional<SchemaNodeView> SchemaNodeView::nextSibling() const
+{
+    if (!m_node->next) {
+        return std::nullopt;
+    }
+    return SchemaNodeView{m_node->next, m_ctx};
+}
+
+/**
+ * @brief Returns a SchemaNode for this node, which keeps the context alive on its own.
+ */
+SchemaNode SchemaNodeView::node() const
+{
+    return SchemaNode{m_node, *m_ctx};
+}
+
+bool SchemaNodeView::operator==(const SchemaNodeView& other) const
+{
+    return m_node == other.m_node;
+}
+
 /**
  * @brief Wraps a lysc_when pointer with managed context.
  */
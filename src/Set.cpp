@@ -11,6 +11,8 @@
 #include <libyang/libyang.h>
 #include <span>
 #include <stdexcept>
+#include <utility>
+#include "utils/arena.hpp"
 #include "utils/ref_count.hpp"
 
 namespace libyang {
@@ -21,7 +23,86 @@ SetIterator<NodeType>::SetIterator(underlying_node_t<NodeType>*const * start, un
     , m_end(end)
     , m_set(set)
 {
-    m_set->m_iterators.emplace(this);
+    m_set->m_iterators.insert(this);
+}
+
+/**
+ * @brief Creates an iterator which does not point into any Set. It can only be assigned to.
+ */
+template <typename NodeType>
+SetIterator<NodeType>::SetIterator()
+    : m_start(nullptr)
+    , m_current(nullptr)
+    , m_end(nullptr)
+    , m_set(nullptr)
+{
+}
+
+template <typename NodeType>
+SetIterator<NodeType>::SetIterator(const SetIterator<NodeType>& other)
+    : m_start(other.m_start)
+    , m_current(other.m_current)
+    , m_end(other.m_end)
+    , m_set(other.m_set)
+{
+    if (m_set) {
+        m_set->m_iterators.insert(this);
+    }
+}
+
+/**
+ * @brief Takes over the position and the registration of `other`, which becomes invalid.
+ */
+template <typename NodeType>
+SetIterator<NodeType>::SetIterator(SetIterator<NodeType>&& other) noexcept
+    : m_start(other.m_start)
+    , m_current(other.m_current)
+    , m_end(other.m_end)
+    , m_set(std::exchange(other.m_set, nullptr))
+{
+    if (m_set) {
+        m_set->m_iterators.replace(&other, this);
+    }
+}
+
+template <typename NodeType>
+SetIterator<NodeType>& SetIterator<NodeType>::operator=(const SetIterator<NodeType>& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    if (m_set) {
+        m_set->m_iterators.erase(this);
+    }
+    m_start = other.m_start;
+    m_current = other.m_current;
+    m_end = other.m_end;
+    m_set = other.m_set;
+    if (m_set) {
+        m_set->m_iterators.insert(this);
+    }
+    return *this;
+}
+
+template <typename NodeType>
+SetIterator<NodeType>& SetIterator<NodeType>::operator=(SetIterator<NodeType>&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    if (m_set) {
+        m_set->m_iterators.erase(this);
+    }
+    m_start = other.m_start;
+    m_current = other.m_current;
+    m_end = other.m_end;
+    m_set = std::exchange(other.m_set, nullptr);
+    if (m_set) {
+        m_set->m_iterators.replace(&other, this);
+    }
+    return *this;
 }
 
 template <typename NodeType>
@@ -34,22 +115,112 @@ SetIterator<NodeType>::~SetIterator()
 
 template <typename NodeType>
 Set<NodeType>::Set(ly_set* set, impl::refs_type_t<NodeType> refs)
-    : m_set(set, [] (auto* set) { ly_set_free(set, nullptr); })
+    : m_set(impl::wrapShared(set, [] (auto* set) { ly_set_free(set, nullptr); }))
     , m_refs(refs)
 {
+    registerThis();
+}
+
+/**
+ * @brief Creates a copy of the Set. The copy shares the underlying `ly_set`, but not the iterators.
+ */
+template <typename NodeType>
+Set<NodeType>::Set(const Set<NodeType>& other)
+    : m_set(other.m_set)
+    , m_refs(other.m_refs)
+    , m_valid(other.m_valid)
+{
+    registerThis();
+}
+
+/**
+ * @brief Takes over the underlying `ly_set`, the registration and the iterators of `other`, which becomes invalid.
+ */
+template <typename NodeType>
+Set<NodeType>::Set(Set<NodeType>&& other) noexcept
+    : m_set(std::move(other.m_set))
+    , m_refs(std::move(other.m_refs))
+    , m_valid(other.m_valid)
+{
+    takeOverFrom(other);
+}
+
+template <typename NodeType>
+void Set<NodeType>::takeOverFrom(Set<NodeType>& other) noexcept
+{
+    m_iterators = std::move(other.m_iterators);
+    for (auto iterator : m_iterators) {
+        iterator->m_set = this;
+    }
+
     if constexpr (std::is_same_v<NodeType, DataNode>) {
         if (m_refs) {
-            m_refs->dataSets.emplace(this);
+            auto lock = impl::lockIfFrozen(m_refs.get());
+            m_refs->dataSets.replace(&other, this);
         }
     }
+
+    other.m_valid = false;
+}
+
+template <typename NodeType>
+Set<NodeType>& Set<NodeType>::operator=(const Set<NodeType>& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    // Our iterators must be invalidated, since we're assigning a different set.
+    invalidate();
+    unregisterThis();
+    m_set = other.m_set;
+    m_refs = other.m_refs;
+    m_valid = other.m_valid;
+    registerThis();
+    return *this;
+}
+
+template <typename NodeType>
+Set<NodeType>& Set<NodeType>::operator=(Set<NodeType>&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    // Our iterators must be invalidated, the ones from `other` are taken over.
+    invalidate();
+    unregisterThis();
+    m_set = std::move(other.m_set);
+    m_refs = std::move(other.m_refs);
+    m_valid = other.m_valid;
+    takeOverFrom(other);
+    return *this;
 }
 
 template <typename NodeType>
 Set<NodeType>::~Set()
 {
     invalidate();
+    unregisterThis();
+}
+
+template <typename NodeType>
+void Set<NodeType>::registerThis()
+{
+    if constexpr (std::is_same_v<NodeType, DataNode>) {
+        if (m_refs) {
+            auto lock = impl::lockIfFrozen(m_refs.get());
+            m_refs->dataSets.insert(this);
+        }
+    }
+}
+
+template <typename NodeType>
+void Set<NodeType>::unregisterThis()
+{
     if constexpr (std::is_same_v<NodeType, DataNode>) {
         if (m_refs) {
+            auto lock = impl::lockIfFrozen(m_refs.get());
             m_refs->dataSets.erase(this);
         }
     }
@@ -79,12 +250,63 @@ SetIterator<NodeType> Set<NodeType>::end() const
 {
     throwIfInvalid();
     if constexpr (std::is_same_v<NodeType, DataNode>) {
-        return SetIterator<NodeType>{m_set->dnodes, m_set->dnodes + m_set->count, this} + int(m_set->count);;
+        return SetIterator<NodeType>{m_set->dnodes, m_set->dnodes + m_set->count, this} + int(m_set->count);
     } else {
         return SetIterator<SchemaNode>{m_set->snodes, m_set->snodes + m_set->count, this} + int(m_set->count);
     }
 }
 
+template <typename NodeType>
+NodeType Set<NodeType>::nodeAt(const std::size_t index) const
+{
+    if constexpr (std::is_same_v<NodeType, DataNode>) {
+        return NodeType{m_set->dnodes[index], m_refs};
+    } else {
+        return NodeType{m_set->snodes[index], m_refs};
+    }
+}
+
+/**
+ * @brief Returns the node at `index` without creating an iterator. The index is not checked, see at().
+ */
+template <typename NodeType>
+NodeType Set<NodeType>::operator[](const std::size_t index) const
+{
+    throwIfInvalid();
+    return nodeAt(index);
+}
+
+/**
+ * @brief Returns the node at `index`, throws std::out_of_range if there's no such node.
+ */
+template <typename NodeType>
+NodeType Set<NodeType>::at(const std::size_t index) const
+{
+    throwIfInvalid();
+    if (index >= m_set->count) {
+        throw std::out_of_range("Set::at: index out of range");
+    }
+    return nodeAt(index);
+}
+
+/**
+ * @brief Copies all nodes into a vector.
+ *
+ * Unlike the Set, the vector is not invalidated by changes of the tree, and it can be sorted or processed by the
+ * parallel algorithms, since no iterators have to be registered.
+ */
+template <typename NodeType>
+std::vector<NodeType> Set<NodeType>::toVector() const
+{
+    throwIfInvalid();
+    std::vector<NodeType> res;
+    res.reserve(m_set->count);
+    for (uint32_t i = 0; i < m_set->count; ++i) {
+        res.emplace_back(nodeAt(i));
+    }
+    return res;
+}
+
 template <typename NodeType>
 NodeType Set<NodeType>::front() const
 {
@@ -182,29 +404,64 @@ SetIterator<NodeType> SetIterator<NodeType>::operator--(int)
 }
 
 template <typename NodeType>
-SetIterator<NodeType> SetIterator<NodeType>::operator-(int n) const
+SetIterator<NodeType>& SetIterator<NodeType>::operator+=(const difference_type n)
 {
-    if (m_current - n < m_start) {
+    throwIfInvalid();
+    auto position = (m_current - m_start) + n;
+    if (position < 0) {
         throw std::out_of_range("Cannot go past the beginning");
     }
+    if (position > m_end - m_start) {
+        throw std::out_of_range("Cannot go past the end");
+    }
+
+    m_current = m_start + position;
+    return *this;
+}
 
+template <typename NodeType>
+SetIterator<NodeType>& SetIterator<NodeType>::operator-=(const difference_type n)
+{
+    return *this += -n;
+}
+
+template <typename NodeType>
+SetIterator<NodeType> SetIterator<NodeType>::operator-(const difference_type n) const
+{
     auto copy = *this;
-    copy.m_current = copy.m_current - n;
+    copy -= n;
     return copy;
 }
 
 template <typename NodeType>
-SetIterator<NodeType> SetIterator<NodeType>::operator+(int n) const
+SetIterator<NodeType> SetIterator<NodeType>::operator+(const difference_type n) const
 {
-    if (m_current + n > m_end) {
-        throw std::out_of_range("Cannot go past the end");
-    }
-
     auto copy = *this;
-    copy.m_current = copy.m_current + n;
+    copy += n;
     return copy;
 }
 
+template <typename NodeType>
+typename SetIterator<NodeType>::difference_type SetIterator<NodeType>::operator-(const SetIterator& other) const
+{
+    throwIfInvalid();
+    return m_current - other.m_current;
+}
+
+/**
+ * @brief Returns the node `n` positions away, without creating another iterator.
+ */
+template <typename NodeType>
+NodeType SetIterator<NodeType>::operator[](const difference_type n) const
+{
+    throwIfInvalid();
+    auto position = (m_current - m_start) + n;
+    if (position < 0 || position >= m_end - m_start) {
+        throw std::out_of_range("Dereferenced an iterator out of the Set");
+    }
+    return NodeType{m_start[position], m_set->m_refs};
+}
+
 template <typename NodeType>
 bool SetIterator<NodeType>::operator==(const SetIterator& other) const
 {
@@ -212,6 +469,13 @@ bool SetIterator<NodeType>::operator==(const SetIterator& other) const
     return this->m_current == other.m_current;
 }
 
+template <typename NodeType>
+std::strong_ordering SetIterator<NodeType>::operator<=>(const SetIterator& other) const
+{
+    throwIfInvalid();
+    return (m_current - m_start) <=> (other.m_current - other.m_start);
+}
+
 template <typename NodeType>
 typename SetIterator<NodeType>::NodeProxy SetIterator<NodeType>::operator->() const
 {
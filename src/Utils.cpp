@@ -12,7 +12,10 @@
 #include <iomanip>
 #include <libyang-cpp/Utils.hpp>
 #include <sstream>
+#include <utility>
+#include "utils/arena.hpp"
 #include "utils/enum.hpp"
+#include "utils/value.hpp"
 
 namespace libyang {
 LogOptions setLogOptions(const libyang::LogOptions options)
@@ -28,6 +31,51 @@ LogLevel setLogLevel(const LogLevel level)
     return utils::toLogLevel(ly_log_level(utils::toLogLevel(level)));
 }
 
+/**
+ * @brief Sets a new log level, the previous one is restored on destruction.
+ *
+ * The log level is shared by all threads, so other threads are affected as well.
+ *
+ * Wraps `ly_log_level`.
+ */
+ScopedLogLevel::ScopedLogLevel(const LogLevel level)
+    : m_previous(setLogLevel(level))
+{
+}
+
+ScopedLogLevel::~ScopedLogLevel()
+{
+    setLogLevel(m_previous);
+}
+
+namespace {
+/**
+ * @brief The options which are currently in effect via ScopedLogOptions, libyang doesn't provide a way to query them.
+ */
+thread_local uint32_t* currentTempLogOptions = nullptr;
+}
+
+/**
+ * @brief Sets new log options for the current thread, the previous ones are restored on destruction.
+ *
+ * Unlike setLogOptions, other threads are not affected. These guards can be nested, but they must be destroyed in the
+ * reverse order of creation, and they must not be mixed with direct calls to `ly_temp_log_options`.
+ *
+ * Wraps `ly_temp_log_options`.
+ */
+ScopedLogOptions::ScopedLogOptions(const LogOptions options)
+    : m_options(utils::toLogOptions(options))
+    , m_previous(std::exchange(currentTempLogOptions, &m_options))
+{
+    ly_temp_log_options(&m_options);
+}
+
+ScopedLogOptions::~ScopedLogOptions()
+{
+    currentTempLogOptions = m_previous;
+    ly_temp_log_options(m_previous);
+}
+
 bool SomeOrder::operator()(const DataNode& a, const DataNode& b) const
 {
     return getRawNode(a) < getRawNode(b);
@@ -38,6 +86,16 @@ bool SomeOrder::operator()(const Identity& a, const Identity& b) const
     return std::make_tuple(a.module().name(), a.name()) < std::make_tuple(b.module().name(), b.name());
 }
 
+std::size_t TermValueHash::operator()(const DataNodeTerm& term) const
+{
+    return term.valueHash();
+}
+
+bool TermValueHash::operator()(const DataNodeTerm& a, const DataNodeTerm& b) const
+{
+    return getRawNode(a)->schema == getRawNode(b)->schema && a.valueEquals(b);
+}
+
 std::string ValuePrinter::operator()(const libyang::Empty) const
 {
     return "empty";
@@ -109,6 +167,93 @@ template std::string LIBYANG_CPP_EXPORT ValuePrinter::operator()(const int64_t&
 template std::string LIBYANG_CPP_EXPORT ValuePrinter::operator()(const bool& val) const;
 template std::string LIBYANG_CPP_EXPORT ValuePrinter::operator()(const std::string& val) const;
 
+namespace impl {
+namespace {
+thread_local arena_state* currentArenaState = nullptr;
+}
+
+arena_state::arena_state(const std::size_t initialSize)
+    : resource(initialSize)
+{
+}
+
+/**
+ * @brief Returns the arena of the innermost ScopedArena of the calling thread, if any.
+ */
+arena_state* currentArena()
+{
+    return currentArenaState;
+}
+}
+
+/**
+ * @brief Starts taking the bookkeeping of new wrappers from an arena.
+ *
+ * While this object is alive, the shared state which is allocated for each new data tree and for each Set (e.g., by
+ * Context::parseData(), Context::newPath(), DataNode::findXPath() or DataNode::unlink()) on the calling thread comes
+ * from a single monotonic buffer. Nothing is returned to the buffer before it is released as a whole, which happens
+ * once this object and all the wrappers which use its memory are destroyed. Wrappers are therefore free to outlive
+ * the ScopedArena, but memory is only reclaimed when the last of them is gone. This suits short-lived units of work,
+ * such as processing a single request, where most of the wrappers die together.
+ *
+ * Other threads are not affected. ScopedArena instances can be nested, but they must be destroyed in the reverse
+ * order of creation.
+ *
+ * @param initialSize The size of the first chunk of memory, in bytes.
+ */
+ScopedArena::ScopedArena(const std::size_t initialSize)
+    : m_arena(std::make_shared<impl::arena_state>(initialSize))
+    , m_previous(std::exchange(impl::currentArenaState, m_arena.get()))
+{
+}
+
+ScopedArena::~ScopedArena()
+{
+    impl::currentArenaState = m_previous;
+}
+
+namespace impl {
+namespace {
+/**
+ * @brief Formats a decimal64 with exactly `digits` fraction digits, including the sign of values between -1 and 0.
+ */
+std::string lexicalDecimal64(const Decimal64& val)
+{
+    const auto magnitude = val.number < 0 ? -static_cast<uint64_t>(val.number) : static_cast<uint64_t>(val.number);
+    const auto mul = static_cast<uint64_t>(pow10int(val.digits));
+    std::ostringstream oss;
+    if (val.number < 0) {
+        oss << '-';
+    }
+    oss << (magnitude / mul);
+    if (val.digits) {
+        oss << '.' << std::setfill('0') << std::setw(val.digits) << (magnitude % mul);
+    }
+    return oss.str();
+}
+}
+
+/**
+ * @brief Converts a Value into the JSON lexical form which libyang accepts when creating nodes.
+ *
+ * Unlike ValuePrinter, which produces a human-readable representation, this can be fed back to libyang.
+ */
+std::string lexicalValue(const Value& value)
+{
+    return std::visit([]<typename ValueType>(const ValueType& val) -> std::string {
+        if constexpr (std::is_same_v<ValueType, Empty>) {
+            return "";
+        } else if constexpr (std::is_same_v<ValueType, InstanceIdentifier>) {
+            return val.path;
+        } else if constexpr (std::is_same_v<ValueType, Decimal64>) {
+            return lexicalDecimal64(val);
+        } else {
+            return ValuePrinter{}(val);
+        }
+    }, value);
+}
+}
+
 std::string qualifiedName(const Identity& identity)
 {
     return identity.module().name() + ':' + identity.name();
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace libyang::impl {
+/**
+ * @brief The memory of a ScopedArena. Internal use only.
+ *
+ * Every block allocated from the arena keeps it alive, so the memory is released only once both the ScopedArena and
+ * all objects allocated within its scope are gone.
+ */
+struct arena_state : std::enable_shared_from_this<arena_state> {
+    explicit arena_state(const std::size_t initialSize);
+
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+arena_state* currentArena();
+
+/**
+ * @brief An allocator which takes memory from an arena_state and which keeps it alive. Internal use only.
+ */
+template <typename T>
+struct arena_allocator {
+    using value_type = T;
+
+    explicit arena_allocator(std::shared_ptr<arena_state> arena) noexcept
+        : arena(std::move(arena))
+    {
+    }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena(other.arena)
+    {
+    }
+
+    T* allocate(const std::size_t n)
+    {
+        return static_cast<T*>(arena->resource.allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, const std::size_t n) noexcept
+    {
+        arena->resource.deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U>& other) const noexcept
+    {
+        return arena == other.arena;
+    }
+
+    std::shared_ptr<arena_state> arena;
+};
+
+/**
+ * @brief Like std::make_shared, but takes the memory from the ScopedArena of the calling thread, if there's one.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> makeShared(Args&&... args)
+{
+    if (auto arena = currentArena()) {
+        return std::allocate_shared<T>(arena_allocator<T>{arena->shared_from_this()}, std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Like the std::shared_ptr constructor, but takes the memory from the ScopedArena of the calling thread, if there's
+ * one.
+ */
+template <typename T, typename Deleter>
+std::shared_ptr<T> wrapShared(T* ptr, Deleter deleter)
+{
+    if (auto arena = currentArena()) {
+        return std::shared_ptr<T>(ptr, std::move(deleter), arena_allocator<T>{arena->shared_from_this()});
+    }
+    return std::shared_ptr<T>(ptr, std::move(deleter));
+}
+}
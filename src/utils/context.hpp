@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <libyang-cpp/Context.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct ly_ctx;
+struct lysc_module;
+struct lysc_node;
+namespace libyang::impl {
+constexpr auto statsOperationCount = static_cast<std::size_t>(StatsOperation::FindXPath) + 1;
+
+/**
+ * @brief The counters behind Context::stats(). Internal use only.
+ *
+ * Everything is a relaxed atomic, so that trees of the same context can be used from several threads. When the stats
+ * are disabled, the only cost is a check of the `enabled` flag.
+ */
+struct context_stats {
+    std::atomic<bool> enabled = false;
+    std::array<std::atomic<uint64_t>, statsOperationCount> calls{};
+    std::array<std::atomic<uint64_t>, statsOperationCount> nanoseconds{};
+    std::atomic<uint64_t> wrapperRegistrations = 0;
+    std::atomic<uint64_t> invalidations = 0;
+    std::atomic<uint64_t> orphanFrees = 0;
+
+    std::mutex spanCallbackMutex;
+    std::shared_ptr<const std::function<SpanCallback>> spanCallback;
+
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+};
+
+inline void countStat(context_stats* stats, std::atomic<uint64_t> context_stats::*counter, const uint64_t amount = 1)
+{
+    if (stats && amount && stats->isEnabled()) {
+        (stats->*counter).fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Measures one operation for Context::stats(), from the construction until the destruction. Internal use only.
+ */
+class stats_span {
+public:
+    stats_span(context_stats* stats, const StatsOperation operation)
+        : m_stats(stats && stats->isEnabled() ? stats : nullptr)
+        , m_operation(operation)
+    {
+        if (m_stats) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~stats_span()
+    {
+        if (m_stats) {
+            finish();
+        }
+    }
+
+    stats_span(const stats_span&) = delete;
+    stats_span& operator=(const stats_span&) = delete;
+
+private:
+    void finish() noexcept;
+
+    context_stats* m_stats;
+    StatsOperation m_operation;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+inline std::size_t hashCombine(const std::size_t seed, const std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * @brief Identifies a schema node by its data parent (choices and cases are skipped), its module and its name.
+ *
+ * The views point into the schema. `output` is set for the nodes within the output of an RPC or an action.
+ * Internal use only.
+ */
+struct schema_child_key {
+    const lysc_node* parent;
+    std::string_view module;
+    std::string_view name;
+    bool output;
+
+    bool operator==(const schema_child_key&) const = default;
+};
+
+struct schema_child_key_hash {
+    std::size_t operator()(const schema_child_key& key) const noexcept;
+};
+
+/**
+ * @brief Identifies the child instantiables of a schema node or of a module. Internal use only.
+ */
+struct child_table_key {
+    const lysc_node* parent;
+    const lysc_module* module;
+    uint32_t options;
+
+    bool operator==(const child_table_key&) const = default;
+};
+
+struct child_table_key_hash {
+    std::size_t operator()(const child_table_key& key) const noexcept
+    {
+        auto res = hashCombine(std::hash<const lysc_node*>{}(key.parent), std::hash<const lysc_module*>{}(key.module));
+        return hashCombine(res, key.options);
+    }
+};
+
+/**
+ * @brief The lookup tables behind Context::buildSchemaIndex(). Internal use only.
+ */
+struct schema_index {
+    /** @brief Schema nodes by their data path, except for the output nodes of RPCs and actions. */
+    std::unordered_map<std::string, const lysc_node*> paths;
+    /** @brief The output nodes of RPCs and actions by their data path. */
+    std::unordered_map<std::string, const lysc_node*> outputPaths;
+    std::unordered_map<schema_child_key, const lysc_node*, schema_child_key_hash> children;
+};
+
+/**
+ * @brief State shared by all Context instances which wrap the same ly_ctx. Internal use only.
+ */
+struct context_state {
+    std::function<ModuleCallback> moduleCallback;
+    std::atomic<bool> schemaLocked = false;
+    context_stats stats;
+
+    /** @brief How many ModuleBatch instances are active, only the outermost one compiles the schema. */
+    unsigned moduleBatches = 0;
+    /** @brief Whether the outermost ModuleBatch has enabled LY_CTX_EXPLICIT_COMPILE, and should disable it again. */
+    bool moduleBatchCompiles = false;
+
+    /** @brief Schema paths computed by SchemaNode::pathView, these are dropped whenever the schema changes. */
+    std::unordered_map<const lysc_node*, std::string> paths;
+    std::shared_mutex pathsMutex;
+
+    /** @brief Whether the schema index is used. It is dropped whenever the schema changes, and rebuilt when needed. */
+    std::atomic<bool> schemaIndexEnabled = false;
+    std::optional<schema_index> schemaIndex;
+    std::shared_mutex schemaIndexMutex;
+
+    /** @brief Memoized ChildInstanstiables, these are dropped whenever the schema changes. */
+    std::unordered_map<child_table_key, std::shared_ptr<const std::vector<const lysc_node*>>, child_table_key_hash> childTables;
+    std::shared_mutex childTablesMutex;
+};
+
+/**
+ * @brief The deleter of every shared_ptr<ly_ctx> created by Context. Internal use only.
+ *
+ * Storing the state in the deleter makes it reachable from every copy of the shared_ptr, including those held by
+ * Module or SchemaNode.
+ */
+struct context_deleter {
+    ContextDeleter destroy;
+    std::shared_ptr<context_state> state;
+
+    void operator()(ly_ctx* ctx) const;
+};
+
+context_state* contextState(const std::shared_ptr<ly_ctx>& ctx);
+context_stats* contextStats(const std::shared_ptr<ly_ctx>& ctx);
+void throwIfSchemaLocked(const std::shared_ptr<ly_ctx>& ctx, const char* where);
+void schemaChanged(const std::shared_ptr<ly_ctx>& ctx);
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <exception>
+#include <fstream>
+#include <libyang-cpp/Utils.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include "data_file.hpp"
+#include "exception.hpp"
+#include "filesystem_path.hpp"
+
+#ifdef _MSC_VER
+#  define __builtin_unreachable() __assume(0)
+#endif
+
+namespace libyang::impl {
+namespace {
+constexpr std::array<unsigned char, 2> gzipMagic{0x1f, 0x8b};
+constexpr std::array<unsigned char, 4> zstdMagic{0x28, 0xb5, 0x2f, 0xfd};
+
+Compression detectCompression(const std::filesystem::path& path)
+{
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw Error{"Can't open '" + path.string() + "'"};
+    }
+    std::array<unsigned char, 4> head{};
+    in.read(reinterpret_cast<char*>(head.data()), head.size());
+    auto size = static_cast<std::size_t>(in.gcount());
+
+    if (size >= gzipMagic.size() && std::equal(gzipMagic.begin(), gzipMagic.end(), head.begin())) {
+        return Compression::Gzip;
+    }
+    if (size >= zstdMagic.size() && std::equal(zstdMagic.begin(), zstdMagic.end(), head.begin())) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+[[noreturn]] void throwNotCompiledIn(const std::string& where, const char* library)
+{
+    throw Error{where + ": libyang-cpp was built without " + library + " support"};
+}
+
+/**
+ * @brief Writes what libyang prints into a file, in chunks of `bufferSize`, compressing them on the way.
+ */
+class data_file_writer {
+public:
+    data_file_writer(const std::filesystem::path& path, const DataFileOptions& options, const std::string& where)
+        : m_path(path)
+        , m_options(options)
+        , m_where(where)
+    {
+        if (m_options.bufferSize == 0) {
+            throw std::out_of_range{where + ": the buffer size must be positive"};
+        }
+
+        switch (m_options.compression) {
+        case Compression::None:
+            openFile();
+            m_pending.reserve(m_options.bufferSize);
+            break;
+        case Compression::Gzip:
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+            m_gzip = gzopen(PATH_TO_LY_STRING(m_path), "wb");
+            if (!m_gzip) {
+                throw Error{m_where + ": can't open '" + m_path.string() + "'"};
+            }
+            // both have to be set before the first write
+            gzbuffer(m_gzip, static_cast<unsigned>(std::min<std::size_t>(m_options.bufferSize, UINT_MAX)));
+            if (m_options.level && gzsetparams(m_gzip, *m_options.level, Z_DEFAULT_STRATEGY) != Z_OK) {
+                throw Error{m_where + ": invalid gzip compression level " + std::to_string(*m_options.level)};
+            }
+            break;
+#else
+            throwNotCompiledIn(m_where, "zlib");
+#endif
+        case Compression::Zstd:
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+            openFile();
+            m_zstd = ZSTD_createCCtx();
+            if (!m_zstd) {
+                throw std::bad_alloc{};
+            }
+            if (m_options.level) {
+                checkZstd(ZSTD_CCtx_setParameter(m_zstd, ZSTD_c_compressionLevel, *m_options.level));
+            }
+            m_pending.resize(std::max(m_options.bufferSize, ZSTD_CStreamOutSize()));
+            break;
+#else
+            throwNotCompiledIn(m_where, "zstd");
+#endif
+        }
+    }
+
+    ~data_file_writer()
+    {
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+        if (m_gzip) {
+            gzclose(m_gzip);
+        }
+#endif
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+        ZSTD_freeCCtx(m_zstd);
+#endif
+    }
+
+    data_file_writer(const data_file_writer&) = delete;
+    data_file_writer& operator=(const data_file_writer&) = delete;
+
+    void write(std::string_view data)
+    {
+        switch (m_options.compression) {
+        case Compression::None:
+            if (m_pending.size() + data.size() > m_options.bufferSize) {
+                writeOut(m_pending);
+                m_pending.clear();
+            }
+            if (data.size() >= m_options.bufferSize) {
+                writeOut(data);
+            } else {
+                m_pending.append(data);
+            }
+            break;
+        case Compression::Gzip:
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+            while (!data.empty()) {
+                auto chunk = static_cast<unsigned>(std::min<std::size_t>(data.size(), INT_MAX));
+                if (gzwrite(m_gzip, data.data(), chunk) <= 0) {
+                    throw Error{m_where + ": can't write '" + m_path.string() + "'"};
+                }
+                data.remove_prefix(chunk);
+            }
+#endif
+            break;
+        case Compression::Zstd:
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+            compressZstd(data, ZSTD_e_continue);
+#endif
+            break;
+        }
+    }
+
+    void finish()
+    {
+        switch (m_options.compression) {
+        case Compression::None:
+            writeOut(m_pending);
+            break;
+        case Compression::Gzip:
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+        {
+            auto err = gzclose(std::exchange(m_gzip, nullptr));
+            if (err != Z_OK) {
+                throw Error{m_where + ": can't write '" + m_path.string() + "'"};
+            }
+        }
+#endif
+            return;
+        case Compression::Zstd:
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+            compressZstd({}, ZSTD_e_end);
+#endif
+            break;
+        }
+
+        m_out.close();
+        if (!m_out) {
+            throw Error{m_where + ": can't write '" + m_path.string() + "'"};
+        }
+    }
+
+private:
+    void openFile()
+    {
+        m_out.open(m_path, std::ios::binary | std::ios::trunc);
+        if (!m_out) {
+            throw Error{m_where + ": can't open '" + m_path.string() + "'"};
+        }
+    }
+
+    void writeOut(const std::string_view data)
+    {
+        m_out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!m_out) {
+            throw Error{m_where + ": can't write '" + m_path.string() + "'"};
+        }
+    }
+
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+    std::size_t checkZstd(const std::size_t ret)
+    {
+        if (ZSTD_isError(ret)) {
+            throw Error{m_where + ": zstd: " + ZSTD_getErrorName(ret)};
+        }
+        return ret;
+    }
+
+    void compressZstd(const std::string_view data, const ZSTD_EndDirective mode)
+    {
+        // zstd buffers the input internally, the output is written whenever a whole buffer is ready
+        ZSTD_inBuffer in{data.data(), data.size(), 0};
+        bool done;
+        do {
+            ZSTD_outBuffer out{m_pending.data(), m_pending.size(), 0};
+            auto remaining = checkZstd(ZSTD_compressStream2(m_zstd, &out, &in, mode));
+            writeOut({m_pending.data(), out.pos});
+            done = mode == ZSTD_e_end ? remaining == 0 : in.pos == in.size;
+        } while (!done);
+    }
+#endif
+
+    std::filesystem::path m_path;
+    DataFileOptions m_options;
+    std::string m_where;
+    std::ofstream m_out;
+    /** @brief Data waiting to be written, or the output buffer of the compressor. */
+    std::string m_pending;
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+    gzFile m_gzip = nullptr;
+#endif
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+    ZSTD_CCtx* m_zstd = nullptr;
+#endif
+};
+
+struct DataFileSink {
+    data_file_writer& writer;
+    std::exception_ptr exception;
+};
+}
+}
+
+extern "C" {
+static ssize_t libyang_cpp_data_file_cb(void* user_data, const void* buf, size_t count)
+{
+    auto& state = *reinterpret_cast<libyang::impl::DataFileSink*>(user_data);
+    try {
+        state.writer.write(std::string_view{reinterpret_cast<const char*>(buf), count});
+    } catch (...) {
+        // Exceptions must not propagate through libyang
+        state.exception = std::current_exception();
+        return -1;
+    }
+    return static_cast<ssize_t>(count);
+}
+}
+
+namespace libyang::impl {
+/**
+ * @brief Reads and decompresses a data file which was compressed by gzip or zstd.
+ *
+ * The compression is recognized by the magic bytes at the start of the file.
+ *
+ * @return The decompressed data, or std::nullopt if the file is not compressed. Such files are best left to libyang,
+ * which maps them into memory.
+ */
+std::optional<std::string> readCompressedDataFile(const std::filesystem::path& path, const std::size_t bufferSize)
+{
+    if (bufferSize == 0) {
+        throw std::out_of_range{"Context::parseData: the buffer size must be positive"};
+    }
+
+    std::string res;
+    switch (detectCompression(path)) {
+    case Compression::None:
+        return std::nullopt;
+    case Compression::Gzip: {
+#ifdef LIBYANG_CPP_HAVE_ZLIB
+        auto file = std::unique_ptr<gzFile_s, decltype(&gzclose)>{gzopen(PATH_TO_LY_STRING(path), "rb"), &gzclose};
+        if (!file) {
+            throw Error{"Context::parseData: can't open '" + path.string() + "'"};
+        }
+        const auto chunk = static_cast<unsigned>(std::min<std::size_t>(bufferSize, INT_MAX));
+        gzbuffer(file.get(), chunk);
+        while (true) {
+            auto used = res.size();
+            res.resize(used + chunk);
+            auto read = gzread(file.get(), res.data() + used, chunk);
+            if (read < 0) {
+                int errnum;
+                throw Error{"Context::parseData: can't decompress '" + path.string() + "': " + gzerror(file.get(), &errnum)};
+            }
+            res.resize(used + static_cast<std::size_t>(read));
+            if (read == 0) {
+                break;
+            }
+        }
+        return res;
+#else
+        throwNotCompiledIn("Context::parseData", "zlib");
+#endif
+    }
+    case Compression::Zstd: {
+#ifdef LIBYANG_CPP_HAVE_ZSTD
+        std::ifstream file{path, std::ios::binary};
+        auto ctx = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+        if (!ctx) {
+            throw std::bad_alloc{};
+        }
+        std::vector<char> input(bufferSize);
+        const auto outChunk = std::max(bufferSize, ZSTD_DStreamOutSize());
+        std::size_t remaining = 0;
+        while (file) {
+            file.read(input.data(), static_cast<std::streamsize>(input.size()));
+            ZSTD_inBuffer in{input.data(), static_cast<std::size_t>(file.gcount()), 0};
+            // zstd might still hold decoded data after it has consumed all of the input, when the output was full
+            bool outputFull = false;
+            while (in.pos < in.size || outputFull) {
+                auto used = res.size();
+                res.resize(used + outChunk);
+                ZSTD_outBuffer out{res.data() + used, outChunk, 0};
+                remaining = ZSTD_decompressStream(ctx.get(), &out, &in);
+                if (ZSTD_isError(remaining)) {
+                    throw Error{"Context::parseData: can't decompress '" + path.string() + "': " + ZSTD_getErrorName(remaining)};
+                }
+                res.resize(used + out.pos);
+                outputFull = out.pos == out.size;
+            }
+        }
+        if (!file.eof()) {
+            throw Error{"Context::parseData: can't read '" + path.string() + "'"};
+        }
+        if (remaining != 0) {
+            throw Error{"Context::parseData: '" + path.string() + "' is truncated"};
+        }
+        return res;
+#else
+        throwNotCompiledIn("Context::parseData", "zstd");
+#endif
+    }
+    }
+    __builtin_unreachable();
+}
+
+/**
+ * @brief Guesses the format of a compressed data file from its name, e.g., `running.json.zst`.
+ *
+ * libyang only does this for files it opens on its own.
+ */
+DataFormat dataFormatOf(const std::filesystem::path& path)
+{
+    auto name = path;
+    if (name.extension() == ".gz" || name.extension() == ".zst") {
+        name.replace_extension();
+    }
+    if (name.extension() == ".xml") {
+        return DataFormat::XML;
+    }
+    if (name.extension() == ".json") {
+        return DataFormat::JSON;
+    }
+    if (name.extension() == ".lyb") {
+        return DataFormat::LYB;
+    }
+    throw Error{"Context::parseData: can't detect the format of '" + path.string() + "', specify it explicitly"};
+}
+
+/**
+ * @brief Creates (or overwrites) a data file and writes into it whatever `print` prints via the callback.
+ */
+void writeDataFile(const std::filesystem::path& path, const DataFileOptions& options, const std::function<LY_ERR(ly_write_clb, void*)>& print, const std::string& where)
+{
+    data_file_writer writer{path, options, where};
+    DataFileSink state{writer, nullptr};
+    auto err = print(&libyang_cpp_data_file_cb, &state);
+    if (state.exception) {
+        std::rethrow_exception(state.exception);
+    }
+    throwIfError(err, where);
+    writer.finish();
+}
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <libyang-cpp/DataNode.hpp>
+#include <libyang/libyang.h>
+#include <optional>
+#include <string>
+
+namespace libyang::impl {
+std::optional<std::string> readCompressedDataFile(const std::filesystem::path& path, const std::size_t bufferSize);
+DataFormat dataFormatOf(const std::filesystem::path& path);
+void writeDataFile(const std::filesystem::path& path, const DataFileOptions& options, const std::function<LY_ERR(ly_write_clb, void*)>& print, const std::string& where);
+}
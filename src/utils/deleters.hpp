@@ -5,8 +5,10 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
 */
+#include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <libyang/libyang.h>
 #include <sys/types.h>
@@ -42,6 +44,33 @@ inline auto wrap_ly_in_new_memory(const std::string& buf)
     return std::unique_ptr<ly_in, deleter_ly_in_free_false_t>{in};
 }
 
+/**
+ * @brief Wraps a byte buffer for parsing.
+ *
+ * libyang requires its input to be NUL-terminated. A buffer whose last byte is NUL is parsed in place, anything else is
+ * copied into the `storage` first. The `storage` must outlive the returned object.
+ */
+inline auto wrap_ly_in_new_memory(std::span<const std::byte> buf, std::string& storage)
+{
+    if (buf.empty() || buf.back() != std::byte{0}) {
+        storage.assign(reinterpret_cast<const char*>(buf.data()), buf.size());
+        return wrap_ly_in_new_memory(storage);
+    }
+
+    struct ly_in* in;
+    auto ret = ly_in_new_memory(reinterpret_cast<const char*>(buf.data()), &in);
+    throwIfError(ret, "ly_in_new_memory failed");
+    return std::unique_ptr<ly_in, deleter_ly_in_free_false_t>{in};
+}
+
+/**
+ * @brief Views the string as a byte buffer which includes the terminating NUL, so that it can be parsed in place.
+ */
+inline std::span<const std::byte> asNulTerminatedBytes(const std::string& str)
+{
+    return std::as_bytes(std::span{str.c_str(), str.size() + 1});
+}
+
 inline auto wrap_ly_in_new_file(const std::filesystem::path& file)
 {
     struct ly_in* in;
@@ -26,6 +26,7 @@ constexpr LYD_FORMAT toLydFormat(const DataFormat format)
 static_assert(LYD_FORMAT::LYD_UNKNOWN == toLydFormat(DataFormat::Detect));
 static_assert(LYD_FORMAT::LYD_XML == toLydFormat(DataFormat::XML));
 static_assert(LYD_FORMAT::LYD_JSON == toLydFormat(DataFormat::JSON));
+static_assert(LYD_FORMAT::LYD_LYB == toLydFormat(DataFormat::LYB));
 
 constexpr uint32_t toPrintFlags(const PrintFlags flags)
 {
@@ -95,6 +96,16 @@ static_assert(LYD_DUP_WITH_PRIV == toDuplicationOptions(DuplicationOptions::With
 static_assert((LYD_DUP_NO_META | LYD_DUP_NO_EXT) ==
         toDuplicationOptions(DuplicationOptions::NoMeta | DuplicationOptions::NoExt));
 
+constexpr uint32_t toGetNextOptions(const GetNextOptions options)
+{
+    return static_cast<uint32_t>(options);
+}
+static_assert(LYS_GETNEXT_WITHCHOICE == toGetNextOptions(GetNextOptions::WithChoice));
+static_assert(LYS_GETNEXT_NOCHOICE == toGetNextOptions(GetNextOptions::NoChoice));
+static_assert(LYS_GETNEXT_WITHCASE == toGetNextOptions(GetNextOptions::WithCase));
+static_assert(LYS_GETNEXT_INTONPCONT == toGetNextOptions(GetNextOptions::IntoNonPresenceContainer));
+static_assert(LYS_GETNEXT_OUTPUT == toGetNextOptions(GetNextOptions::Output));
+
 constexpr NodeType toNodeType(const uint16_t type)
 {
     return static_cast<NodeType>(type);
@@ -275,4 +286,10 @@ static_assert(toDataCompareOptions(DataCompare::FullRecursion) == LYD_COMPARE_FU
 static_assert(toDataCompareOptions(DataCompare::OpaqueAsData) == LYD_COMPARE_OPAQ);
 static_assert(toDataCompareOptions(DataCompare::FullRecursion | DataCompare::NoOptions) == LYD_COMPARE_FULL_RECURSION);
 static_assert(toDataCompareOptions(DataCompare::DistinguishExplicitDefaults | DataCompare::FullRecursion | DataCompare::OpaqueAsData) == (LYD_COMPARE_DEFAULTS | LYD_COMPARE_FULL_RECURSION | LYD_COMPARE_OPAQ));
+
+constexpr uint16_t toDiffOptions(const DiffOptions flags)
+{
+    return static_cast<uint16_t>(flags);
+}
+static_assert(toDiffOptions(DiffOptions::Defaults) == LYD_DIFF_DEFAULTS);
 }
@@ -44,4 +44,11 @@ void throwIfError(int code, std::string msg)
     oss << msg << ": " << static_cast<ErrorCode>(code);
     throw ErrorWithCode(oss.str(), code);
 }
+
+namespace impl {
+[[noreturn]] void throwExpectedError(const ErrorCode code)
+{
+    throwError(static_cast<int>(code), "Expected::value: the operation has failed");
+}
+}
 }
@@ -7,20 +7,30 @@
 */
 
 #include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <string_view>
+#include <vector>
 #include "enum.hpp"
 #include "exception.hpp"
+#include "context.hpp"
 #include "newPath.hpp"
+#include "ref_count.hpp"
 
 using namespace std::string_literals;
 
 namespace libyang::impl {
 std::optional<DataNode> newPath(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options)
 {
+    stats_span span{statsOf(refs.get()), StatsOperation::NewPath};
     lyd_node* out;
     auto err = lyd_new_path(node, ctx, path.c_str(), value ? value->c_str() : nullptr, options ? utils::toCreationOptions(*options) : 0, &out);
 
     throwIfError(err, "Couldn't create a node with path '"s + path + "'");
 
+    if (node && refs) {
+        refs->touchByPath(node, path, out);
+    }
+
     if (out) {
         return DataNode{out, refs};
     } else {
@@ -30,12 +40,17 @@ std::optional<DataNode> newPath(lyd_node* node, ly_ctx* ctx, std::shared_ptr<int
 
 CreatedNodes newPath2(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refcount> refs, const std::string& path, const void* value, const AnydataValueType valueType, const std::optional<CreationOptions> options)
 {
+    stats_span span{statsOf(refs.get()), StatsOperation::NewPath};
     lyd_node* newParent;
     lyd_node* newNode;
     auto err = lyd_new_path2(node, ctx, path.c_str(), value, 0, utils::toAnydataValueType(valueType), options ? utils::toCreationOptions(*options) : 0, &newParent, &newNode);
 
     throwIfError(err, "Couldn't create a node with path '"s + path + "'");
 
+    if (node && refs) {
+        refs->touchByPath(node, path, newNode);
+    }
+
     return {
         .createdParent = (newParent ? std::optional{DataNode{newParent, refs}} : std::nullopt),
         .createdNode = (newNode ? std::optional{DataNode{newNode, refs}} : std::nullopt),
@@ -44,6 +59,7 @@ CreatedNodes newPath2(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refc
 
 std::optional<DataNode> newExtPath(lyd_node* node, const lysc_ext_instance* ext, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options)
 {
+    stats_span span{statsOf(refs.get()), StatsOperation::NewPath};
     lyd_node* out;
     auto err = lyd_new_ext_path(node, ext, path.c_str(), value ? value->c_str() : nullptr, options ? utils::toCreationOptions(*options) : 0, &out);
 
@@ -55,4 +71,135 @@ std::optional<DataNode> newExtPath(lyd_node* node, const lysc_ext_instance* ext,
         return std::nullopt;
     }
 }
+
+namespace {
+/**
+ * @brief Splits a path into its node segments, i.e., at each slash which is not inside of a predicate.
+ */
+std::vector<std::string_view> splitPath(const std::string& path)
+{
+    std::vector<std::string_view> res;
+    std::size_t start = path.starts_with('/') ? 1 : 0;
+    int depth = 0;
+    char quote = 0;
+    for (std::size_t i = start; i < path.size(); ++i) {
+        auto c = path[i];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+        } else if (c == '[') {
+            ++depth;
+        } else if (c == ']') {
+            --depth;
+        } else if (c == '/' && !depth) {
+            res.emplace_back(path.data() + start, i - start);
+            start = i + 1;
+        }
+    }
+    res.emplace_back(path.data() + start, path.size() - start);
+    return res;
+}
+
+/**
+ * @brief Checks whether the node created for `segment` is the one which the same segment in another path refers to.
+ *
+ * That doesn't hold for lists and leaf-lists without predicates, because each of these paths creates a new instance.
+ * Opaque nodes are never shared, because the module of their children cannot be inferred.
+ */
+bool isShareable(const lyd_node* node, const std::string_view segment)
+{
+    return node->schema && (!(node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) || segment.find('[') != std::string_view::npos);
+}
+
+bool hasPrefix(const std::string_view segment)
+{
+    return segment.substr(0, segment.find('[')).find(':') != std::string_view::npos;
+}
+}
+
+/**
+ * @brief Creates all nodes from `nodes`, returns some node of the forest which contains them, or nullptr.
+ *
+ * When `node` is nullptr, a new forest is created, and it is freed if any of the nodes cannot be created. Otherwise,
+ * the changes are recorded in `refs` (if any) for validateIncremental().
+ *
+ * Consecutive paths usually share their beginning. The nodes which were created for the previous path are remembered,
+ * and each path is created relative to the deepest of them which it has in common with the previous path, so that
+ * libyang does not have to resolve the common part again.
+ */
+lyd_node* newPaths(lyd_node* node, ly_ctx* ctx, internal_refcount* refs, std::span<const PathValue> nodes, const std::optional<CreationOptions> options)
+{
+    stats_span span{statsOf(refs), StatsOperation::NewPath};
+    const auto opts = options ? utils::toCreationOptions(*options) : 0;
+    lyd_node* forest = node;
+
+    // The segments of the previous path, and the nodes which correspond to the leading shareable ones
+    std::vector<std::string_view> previous;
+    std::vector<lyd_node*> ancestors;
+    bool previousAbsolute = false;
+
+    for (const auto& [path, value] : nodes) {
+        auto segments = splitPath(path);
+        const bool absolute = path.starts_with('/');
+
+        std::size_t common = 0;
+        if (absolute == previousAbsolute) {
+            // At least the last segment has to be created by libyang, otherwise there would be no path to pass to it
+            while (common < ancestors.size() && common + 1 < segments.size() && segments[common] == previous[common]) {
+                ++common;
+            }
+        }
+
+        lyd_node* newParent;
+        lyd_node* newNode;
+        LY_ERR err;
+        if (common) {
+            auto parent = ancestors[common - 1];
+            std::string relative{path, static_cast<std::size_t>(segments[common].data() - path.data())};
+            if (!hasPrefix(segments[common])) {
+                // Unlike in the full path, there's no preceding node to inherit the module from
+                relative = parent->schema->module->name + ":"s + relative;
+            }
+            err = lyd_new_path2(parent, nullptr, relative.c_str(), value ? value->c_str() : nullptr, 0, utils::toAnydataValueType(AnydataValueType::String), opts, &newParent, &newNode);
+        } else {
+            err = lyd_new_path2(forest, forest ? nullptr : ctx, path.c_str(), value ? value->c_str() : nullptr, 0, utils::toAnydataValueType(AnydataValueType::String), opts, &newParent, &newNode);
+        }
+        if (err != LY_SUCCESS) {
+            if (!node) {
+                // Nobody else knows about the partially built tree
+                lyd_free_all(forest);
+            }
+            throwError(err, "Couldn't create a node with path '"s + path + "'");
+        }
+
+        if (!forest) {
+            forest = newParent;
+        }
+
+        if (refs) {
+            refs->touchByPath(common ? ancestors[common - 1] : node, common ? std::string{} : path, newNode);
+        }
+
+        // Remember the nodes on the path, this only works if the final node is known
+        ancestors.resize(common);
+        if (newNode) {
+            std::vector<lyd_node*> created(segments.size() - common);
+            auto current = newNode;
+            for (auto level = created.size(); level-- > 0 && current; current = reinterpret_cast<lyd_node*>(current->parent)) {
+                created[level] = current;
+            }
+            for (std::size_t i = 0; i < created.size() && created[i] && isShareable(created[i], segments[common + i]); ++i) {
+                ancestors.emplace_back(created[i]);
+            }
+        }
+
+        previous = std::move(segments);
+        previousAbsolute = absolute;
+    }
+
+    return forest;
+}
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <libyang-cpp/DataNode.hpp>
+#include <span>
 #include "ref_count.hpp"
 
 struct ly_ctx;
@@ -15,4 +16,5 @@ namespace libyang::impl {
 std::optional<DataNode> newPath(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options);
 CreatedNodes newPath2(lyd_node* node, ly_ctx* ctx, std::shared_ptr<internal_refcount> refs, const std::string& path, const void* value, const AnydataValueType valueType, const std::optional<CreationOptions> options);
 std::optional<DataNode> newExtPath(lyd_node* node, const lysc_ext_instance* ext, std::shared_ptr<internal_refcount> refs, const std::string& path, const std::optional<std::string>& value, const std::optional<CreationOptions> options);
+lyd_node* newPaths(lyd_node* node, ly_ctx* ctx, internal_refcount* refs, std::span<const PathValue> nodes, const std::optional<CreationOptions> options);
 }
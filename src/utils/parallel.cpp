@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "parallel.hpp"
+
+namespace libyang::impl {
+/**
+ * @brief Returns the number of threads to use when the user asks for `threads`, 0 means one per CPU core.
+ */
+std::size_t resolveThreadCount(const std::size_t threads)
+{
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Calls `fn` for each index below `count` on a pool of up to `threads` threads, including the calling one.
+ *
+ * The indexes are handed out one by one, so uneven work items still keep all threads busy. The first exception stops
+ * handing out any more indexes, and it is rethrown once all threads have finished.
+ */
+void parallelFor(const std::size_t count, const std::size_t threads, const std::function<void(std::size_t)>& fn)
+{
+    std::atomic<std::size_t> next{0};
+    std::mutex errorLock;
+    std::exception_ptr error;
+
+    auto worker = [&] {
+        for (auto i = next++; i < count; i = next++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard lock{errorLock};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        for (std::size_t i = 1; i < std::min(resolveThreadCount(threads), count); ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+}
@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace libyang::impl {
+std::size_t resolveThreadCount(const std::size_t threads);
+void parallelFor(const std::size_t count, const std::size_t threads, const std::function<void(std::size_t)>& fn);
+}
@@ -5,12 +5,100 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
 */
+#include <algorithm>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <utility>
+#include "context.hpp"
 #include "ref_count.hpp"
 
 namespace libyang {
 internal_refcount::internal_refcount(std::shared_ptr<ly_ctx> ctx, std::shared_ptr<void> customCtx)
     : context(ctx)
     , customContext(customCtx)
+    , stats(impl::contextStats(context))
 {
 }
+
+/**
+ * @brief Records that the data of the module which owns `node` have changed, see validateIncremental().
+ */
+void internal_refcount::touch(const lyd_node* node)
+{
+    ++generation;
+    auto module = lyd_owner_module(node);
+    if (!module) {
+        // Opaque nodes of unknown modules: don't guess, validate everything next time
+        validated = false;
+        return;
+    }
+
+    if (std::find(touchedModules.begin(), touchedModules.end(), module) == touchedModules.end()) {
+        touchedModules.emplace_back(module);
+    }
+}
+
+/**
+ * @brief Records a change made by creating `path` from `parent`, `created` is the node reported by libyang, if any.
+ */
+void internal_refcount::touchByPath(const lyd_node* parent, const std::string& path, const lyd_node* created)
+{
+    if (created) {
+        touch(created);
+    } else if (parent && !path.starts_with('/')) {
+        touch(parent);
+    } else {
+        // An existing node was updated, and it could be anywhere
+        ++generation;
+        validated = false;
+    }
+}
+
+void internal_refcount::markValidated()
+{
+    // validation might have added or removed default nodes
+    ++generation;
+    validated = true;
+    touchedModules.clear();
+}
+
+bool internal_refcount::isFrozen() const
+{
+    return !frozen.expired();
+}
+
+namespace impl {
+frozen_state::frozen_state(DataNode forest)
+    : forest(std::move(forest))
+{
+}
+
+/**
+ * @brief Locks the registries of a frozen tree, does nothing for trees which are not frozen.
+ */
+std::unique_lock<std::mutex> lockIfFrozen(internal_refcount* refcount)
+{
+    if (refcount && refcount->isFrozen()) {
+        return std::unique_lock{refcount->frozenMutex};
+    }
+    return {};
+}
+
+/**
+ * @brief Makes `refcount` a part of this batch. Does nothing for unmanaged nodes.
+ */
+void batch_state::join(const std::shared_ptr<internal_refcount>& refcount)
+{
+    if (!refcount || refcount->batch == this) {
+        return;
+    }
+
+    if (refcount->batch) {
+        throw Error{"TreeEditBatch: the tree is already a part of another batch"};
+    }
+
+    refcount->batch = this;
+    refs.emplace_back(refcount);
+}
+}
 }
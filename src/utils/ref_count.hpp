@@ -6,12 +6,18 @@
  * SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
+#include <libyang-cpp/DataNode.hpp>
 #include <libyang-cpp/Enum.hpp>
 #include <libyang-cpp/export.h>
+#include <cstdint>
 #include <memory>
-#include <set>
+#include <mutex>
+#include <string>
+#include <vector>
 
 struct ly_ctx;
+struct lyd_node;
+struct lys_module;
 namespace libyang {
 class DataNode;
 template <typename NodeType>
@@ -21,16 +27,79 @@ template <typename NodeType, IterationType ITER_TYPE>
 class Collection;
 template <typename NodeType, IterationType ITER_TYPE>
 class Iterator;
+namespace impl {
+struct context_stats;
+}
+
 /**
  * @brief A structure containing info needed for automatic memory management. Internal use only.
  */
 struct internal_refcount {
     explicit internal_refcount(std::shared_ptr<ly_ctx> ctx, std::shared_ptr<void> customContext = nullptr);
-    std::set<DataNode*> nodes;
-    std::set<Collection<DataNode, IterationType::Dfs>*> dataCollectionsDfs;
-    std::set<Collection<DataNode, IterationType::Sibling>*> dataCollectionsSibling;
-    std::set<Set<DataNode>*> dataSets;
+    impl::registry<DataNode> nodes;
+    impl::registry<Collection<DataNode, IterationType::Dfs>> dataCollectionsDfs;
+    impl::registry<Collection<DataNode, IterationType::Sibling>> dataCollectionsSibling;
+    impl::registry<Set<DataNode>> dataSets;
     std::shared_ptr<ly_ctx> context;
     std::shared_ptr<void> customContext;
+    /** @brief The stats of the context, if any, see Context::stats(). */
+    impl::context_stats* stats;
+    /** @brief The TreeEditBatch which this tree is a part of, if any. */
+    impl::batch_state* batch = nullptr;
+    /** @brief Shared by all FrozenTree handles of this tree, expires when the tree is no longer frozen. */
+    std::weak_ptr<impl::frozen_state> frozen;
+    /** @brief Serializes changes of the registries while the tree is frozen. */
+    std::mutex frozenMutex;
+
+    /** @brief Whether the tree passed a full validation, so that only the touchedModules need validating again. */
+    bool validated = false;
+    /** @brief Modules whose data were changed since the last validation. */
+    std::vector<const lys_module*> touchedModules;
+
+    /** @brief Incremented on each change made through the wrappers, see DataNode::snapshot(). */
+    uint64_t generation = 0;
+    /** @brief The most recent snapshot of the tree while any reader holds it, it is up to date if `snapshotGeneration` matches `generation`. */
+    std::weak_ptr<impl::frozen_state> snapshot;
+    uint64_t snapshotGeneration = 0;
+    /** @brief Serializes DataNode::snapshot(). */
+    std::mutex snapshotMutex;
+
+    bool isFrozen() const;
+    void touch(const lyd_node* node);
+    void touchByPath(const lyd_node* parent, const std::string& path, const lyd_node* created);
+    void markValidated();
+};
+
+namespace impl {
+/**
+ * @brief Bookkeeping of an uncommitted TreeEditBatch. Internal use only.
+ */
+struct batch_state {
+    void join(const std::shared_ptr<internal_refcount>& refcount);
+
+    /** @brief All refcounters whose trees were touched by the batch. These are kept alive until the batch is committed. */
+    std::vector<std::shared_ptr<internal_refcount>> refs;
+    /** @brief Nodes whose trees might have lost all their wrappers during the batch. */
+    std::vector<lyd_node*> orphanCandidates;
 };
+
+/**
+ * @brief State shared by all FrozenTree handles of a tree. Internal use only.
+ */
+struct frozen_state {
+    explicit frozen_state(DataNode forest);
+
+    /** @brief The first top-level sibling of the tree, this also keeps the whole tree alive. */
+    DataNode forest;
+    /** @brief DataNodeRef instances handed out by FrozenTree refer to this, it never changes. */
+    bool valid = true;
+};
+
+std::unique_lock<std::mutex> lockIfFrozen(internal_refcount* refcount);
+
+inline context_stats* statsOf(const internal_refcount* refcount)
+{
+    return refcount ? refcount->stats : nullptr;
+}
+}
 }
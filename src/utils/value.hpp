@@ -0,0 +1,13 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <libyang-cpp/Value.hpp>
+#include <string>
+
+namespace libyang::impl {
+std::string lexicalValue(const Value& value);
+}
@@ -6,10 +6,16 @@
  * SPDX-License-Identifier: BSD-3-Clause
 */
 
+#include <algorithm>
 #include <doctest/doctest.h>
 #include <fstream>
 #include <libyang-cpp/Context.hpp>
 #include <libyang-cpp/Utils.hpp>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "example_schema.hpp"
 #include "pretty_printers.hpp"
 #include "test_vars.hpp"
@@ -448,6 +454,236 @@ TEST_CASE("context")
         REQUIRE(ctx->getModuleLatest("importedModule"));
     }
 
+    DOCTEST_SUBCASE("Context::loadModules")
+    {
+        std::mutex mutex;
+        std::vector<std::string> requested;
+        ctx->registerModuleCallback([&](auto modName, auto, auto, auto) -> std::optional<libyang::ModuleInfo> {
+            {
+                std::lock_guard lock{mutex};
+                requested.emplace_back(modName);
+            }
+            if (modName == "withImport") {
+                return libyang::ModuleInfo{.data = model_with_import, .format = libyang::SchemaFormat::YANG};
+            }
+            if (modName == "importedModule") {
+                return libyang::ModuleInfo{.data = imported_module, .format = libyang::SchemaFormat::YANG};
+            }
+            if (modName == "example-schema") {
+                return libyang::ModuleInfo{.data = example_schema, .format = libyang::SchemaFormat::YANG};
+            }
+            if (modName == "broken") {
+                throw std::runtime_error{"fetch failed"};
+            }
+            return std::nullopt;
+        });
+
+        DOCTEST_SUBCASE("all modules are fetched upfront")
+        {
+            auto modules = ctx->loadModules({{.name = "withImport"}, {.name = "importedModule"}, {.name = "example-schema"}});
+            REQUIRE(modules.size() == 3);
+            REQUIRE(modules[0].name() == "withImport");
+            REQUIRE(modules[0].implemented());
+            REQUIRE(modules[1].implemented());
+            REQUIRE(ctx->findPath("/example-schema:leafInt32").nodeType() == libyang::NodeType::Leaf);
+            // the import was served from the prefetched sources
+            std::sort(requested.begin(), requested.end());
+            REQUIRE(requested == std::vector<std::string>{"example-schema", "importedModule", "withImport"});
+
+            requested.clear();
+            REQUIRE(ctx->loadModules({{.name = "example-schema"}}, 1).front().name() == "example-schema");
+            REQUIRE(requested.empty());
+        }
+
+        DOCTEST_SUBCASE("unlisted imports are fetched on demand")
+        {
+            auto modules = ctx->loadModules({{.name = "withImport"}}, 1);
+            REQUIRE(modules.size() == 1);
+            REQUIRE(!ctx->getModule("importedModule", std::nullopt)->implemented());
+            REQUIRE(requested == std::vector<std::string>{"withImport", "importedModule"});
+        }
+
+        DOCTEST_SUBCASE("errors")
+        {
+            REQUIRE_THROWS_WITH_AS(ctx->loadModules({{.name = "example-schema"}, {.name = "broken"}}), "fetch failed", std::runtime_error);
+            REQUIRE(!ctx->getModule("example-schema", std::nullopt));
+            REQUIRE_THROWS_WITH_AS(ctx->loadModules({{.name = "doesnt-exist"}}), "Can't load module 'doesnt-exist'", libyang::Error);
+
+            // the context is usable afterwards
+            REQUIRE(ctx->loadModule("example-schema").implemented());
+        }
+    }
+
+    DOCTEST_SUBCASE("Context::beginModuleBatch")
+    {
+        ctx->setSearchDir(TESTS_DIR / "yang");
+        {
+            auto batch = ctx->beginModuleBatch();
+            auto mod = ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+            {
+                auto nested = ctx->beginModuleBatch();
+                ctx->loadModule("mod1", std::nullopt, {"feature1"});
+                nested.commit();
+            }
+            // nothing is compiled until the outermost batch is done
+            REQUIRE_THROWS(ctx->findPath("/example-schema:leafInt32"));
+            REQUIRE_THROWS_WITH_AS(ctx->lockSchema(), "Context::lockSchema: a ModuleBatch is still active", libyang::Error);
+
+            DOCTEST_SUBCASE("explicit commit")
+            {
+                batch.commit();
+                REQUIRE(ctx->findPath("/example-schema:leafInt32").nodeType() == libyang::NodeType::Leaf);
+            }
+
+            DOCTEST_SUBCASE("commit on destruction")
+            {
+            }
+        }
+        REQUIRE(ctx->findPath("/example-schema:leafInt32").nodeType() == libyang::NodeType::Leaf);
+        REQUIRE(ctx->getModuleImplemented("mod1")->featureEnabled("feature1"));
+
+        // without a batch, changes are compiled right away
+        ctx->parseModule(example_schema2, libyang::SchemaFormat::YANG);
+        REQUIRE(ctx->findPath("/example-schema2:contWithTwoNodes").nodeType() == libyang::NodeType::Container);
+    }
+
+    DOCTEST_SUBCASE("Stats")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        const auto data = R"({"example-schema:leafInt32": 420})"s;
+
+        // Nothing is collected by default
+        ctx->parseData(data, libyang::DataFormat::JSON);
+        REQUIRE(ctx->stats().parseData.calls == 0);
+
+        std::vector<libyang::StatsOperation> spans;
+        ctx->registerSpanCallback([&spans](const libyang::StatsOperation operation, const auto, const auto duration) {
+            REQUIRE(duration >= std::chrono::nanoseconds::zero());
+            spans.emplace_back(operation);
+        });
+        ctx->enableStats();
+
+        auto tree = ctx->parseData(data, libyang::DataFormat::JSON);
+        tree->newPath("/example-schema:leafInt8", "1");
+        tree->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings);
+        libyang::validateAll(tree);
+        auto set = tree->findXPath("/example-schema:leafInt8");
+        auto node = *tree->findPath("/example-schema:leafInt8");
+        node.unlink();
+
+        auto stats = ctx->stats();
+        REQUIRE(stats.parseData.calls == 1);
+        REQUIRE(stats.parseOp.calls == 0);
+        REQUIRE(stats.newPath.calls == 1);
+        REQUIRE(stats.print.calls == 1);
+        REQUIRE(stats.findXPath.calls == 1);
+        REQUIRE(stats.validate.calls == 1);
+        REQUIRE(stats.parseData.time > std::chrono::nanoseconds::zero());
+        REQUIRE(stats.wrapperRegistrations > 0);
+        REQUIRE(stats.invalidations == 1);
+        REQUIRE(spans == std::vector{
+            libyang::StatsOperation::ParseData,
+            libyang::StatsOperation::NewPath,
+            libyang::StatsOperation::Print,
+            libyang::StatsOperation::Validate,
+            libyang::StatsOperation::FindXPath,
+        });
+
+        ctx->resetStats();
+        REQUIRE(ctx->stats().parseData == libyang::OperationStats{});
+        REQUIRE(ctx->stats().wrapperRegistrations == 0);
+
+        ctx->enableStats(false);
+        ctx->parseData(data, libyang::DataFormat::JSON);
+        REQUIRE(ctx->stats().parseData.calls == 0);
+        REQUIRE(spans.size() == 5);
+    }
+
+    DOCTEST_SUBCASE("Locked schema")
+    {
+        {
+            // the callback is shared by all copies of the context
+            auto copy = *ctx;
+            copy.registerModuleCallback([](auto modName, auto, auto, auto) -> std::optional<libyang::ModuleInfo> {
+                if (modName == "example-schema") {
+                    return libyang::ModuleInfo{.data = example_schema, .format = libyang::SchemaFormat::YANG};
+                }
+                return std::nullopt;
+            });
+        }
+        auto mod = ctx->loadModule("example-schema");
+
+        auto copy = *ctx;
+        REQUIRE(!ctx->isSchemaLocked());
+        copy.lockSchema();
+        REQUIRE(ctx->isSchemaLocked());
+        copy.lockSchema();
+
+        REQUIRE_THROWS_WITH_AS(ctx->parseModule(valid_yang_model, libyang::SchemaFormat::YANG), "Context::parseModule: the schema of the context is locked", libyang::Error);
+        REQUIRE_THROWS_WITH_AS(ctx->loadModule("example-schema2"), "Context::loadModule: the schema of the context is locked", libyang::Error);
+        REQUIRE_THROWS_WITH_AS(ctx->setSearchDir(TESTS_DIR), "Context::setSearchDir: the schema of the context is locked", libyang::Error);
+        REQUIRE_THROWS_WITH_AS(ctx->registerModuleCallback([](auto, auto, auto, auto) { return std::nullopt; }),
+                "Context::registerModuleCallback: the schema of the context is locked", libyang::Error);
+        REQUIRE_THROWS_WITH_AS(mod.setImplemented(), "Module::setImplemented: the schema of the context is locked", libyang::Error);
+
+        // Each thread only sees its own errors
+        std::vector<int> failures(8);
+        {
+            std::vector<std::jthread> threads;
+            for (int i = 0; i < 8; ++i) {
+                threads.emplace_back([&ctx, &failures, i] {
+                    libyang::ScopedLogOptions quiet{libyang::LogOptions::Store};
+                    for (int round = 0; round < 50; ++round) {
+                        ctx->cleanAllErrors();
+                        auto tree = ctx->parseData(R"({"example-schema:leafInt8": )"s + std::to_string(i) + "}", libyang::DataFormat::JSON);
+                        if (!tree || tree->findPath("/example-schema:leafInt8")->asTerm().valueStr() != std::to_string(i)) {
+                            ++failures[i];
+                        }
+                        if (ctx->findPath("/example-schema:leafInt8").path() != "/example-schema:leafInt8") {
+                            ++failures[i];
+                        }
+                        if (i % 2) {
+                            try {
+                                ctx->newPath("/example-schema:leafInt8", "9001");
+                                ++failures[i];
+                            } catch (libyang::Error&) {
+                            }
+                        }
+                        if (ctx->getErrors().size() != static_cast<std::size_t>(i % 2)) {
+                            ++failures[i];
+                        }
+                    }
+                });
+            }
+        }
+        REQUIRE(failures == std::vector<int>(8, 0));
+    }
+
+    DOCTEST_SUBCASE("Compiled context images")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        auto image = std::filesystem::temp_directory_path() / "libyang-cpp-test-context.img";
+
+#ifdef LIBYANG_CPP_HAVE_PRINTED_CONTEXT
+        ctx->saveCompiled(image);
+        {
+            auto loaded = libyang::Context::fromCompiled(image);
+            REQUIRE(loaded.isSchemaLocked());
+            REQUIRE(loaded.getModuleImplemented("example-schema"));
+            auto tree = loaded.parseData(R"({"example-schema:leafInt8": 42})"s, libyang::DataFormat::JSON);
+            REQUIRE(tree->findPath("/example-schema:leafInt8")->asTerm().valueStr() == "42");
+            REQUIRE_THROWS_WITH_AS(loaded.loadModule("example-schema2"), "Context::loadModule: the schema of the context is locked", libyang::Error);
+        }
+
+        std::ofstream{image, std::ios::trunc} << "garbage";
+        REQUIRE_THROWS_WITH_AS(libyang::Context::fromCompiled(image), ("Context::fromCompiled: '" + image.string() + "' is not a compiled context image").c_str(), libyang::Error);
+        std::filesystem::remove(image);
+#else
+        REQUIRE_THROWS_AS(ctx->saveCompiled(image), libyang::Error);
+        REQUIRE_THROWS_AS(libyang::Context::fromCompiled(image), libyang::Error);
+#endif
+    }
+
     DOCTEST_SUBCASE("Context::parseData")
     {
         ctx->parseModule(example_schema2, libyang::SchemaFormat::YANG);
@@ -464,6 +700,31 @@ TEST_CASE("context")
         REQUIRE(data->findPath("/example-schema:leafInt8")->asTerm().valueStr() == "-43");
     }
 
+    DOCTEST_SUBCASE("Context::parseData from a memory buffer")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        // Only a part of the buffer is passed in, so there is no NUL byte right after the data
+        const auto buf = R"({"example-schema:leafInt8": -43}garbage)"sv;
+        const auto json = buf.substr(0, buf.size() - "garbage"sv.size());
+
+        DOCTEST_SUBCASE("not NUL-terminated")
+        {
+            auto data = ctx->parseData(std::as_bytes(std::span{json}), libyang::DataFormat::JSON);
+            REQUIRE(data);
+            REQUIRE(data->findPath("/example-schema:leafInt8")->asTerm().valueStr() == "-43");
+        }
+
+        DOCTEST_SUBCASE("NUL-terminated")
+        {
+            std::vector<std::byte> terminated;
+            std::ranges::copy(std::as_bytes(std::span{json}), std::back_inserter(terminated));
+            terminated.push_back(std::byte{0});
+            auto data = ctx->parseData(terminated, libyang::DataFormat::JSON);
+            REQUIRE(data);
+            REQUIRE(data->findPath("/example-schema:leafInt8")->asTerm().valueStr() == "-43");
+        }
+    }
+
     DOCTEST_SUBCASE("Context::parseOp")
     {
         DOCTEST_SUBCASE("RPC")
@@ -473,6 +734,14 @@ TEST_CASE("context")
             auto pop = ctx->parseOp(dataJson, libyang::DataFormat::JSON, libyang::OperationType::RpcYang);
             REQUIRE(pop.op->schema().name() == "myRpc");
             REQUIRE(pop.tree->findPath("/example-schema:myRpc/inputLeaf")->asTerm().valueStr() == "str");
+
+            // the parsed trees belong to this context, and they share its state
+            ctx->enableStats();
+            auto notif = ctx->parseOp(R"({"example-schema:event": {"event-class": "fault"}})"s, libyang::DataFormat::JSON, libyang::OperationType::NotificationYang);
+            notif.tree->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings);
+            REQUIRE(ctx->stats().parseOp.calls == 1);
+            REQUIRE(ctx->stats().print.calls == 1);
+            REQUIRE(notif.op->schema().pathView().data() == ctx->findPath("/example-schema:event").pathView().data());
         }
         DOCTEST_SUBCASE("action")
         {
@@ -612,9 +881,28 @@ TEST_CASE("context")
 
     DOCTEST_SUBCASE("Log level")
     {
+        libyang::setLogLevel(libyang::LogLevel::Debug);
         REQUIRE(libyang::setLogLevel(libyang::LogLevel::Error) == libyang::LogLevel::Debug);
         REQUIRE(libyang::setLogLevel(libyang::LogLevel::Warning) == libyang::LogLevel::Error);
         REQUIRE(libyang::setLogLevel(libyang::LogLevel::Verbose) == libyang::LogLevel::Warning);
+
+        {
+            libyang::ScopedLogLevel guard{libyang::LogLevel::Error};
+            {
+                libyang::ScopedLogLevel nested{libyang::LogLevel::Debug};
+                REQUIRE(libyang::setLogLevel(libyang::LogLevel::Debug) == libyang::LogLevel::Debug);
+            }
+            REQUIRE(libyang::setLogLevel(libyang::LogLevel::Error) == libyang::LogLevel::Error);
+        }
+        REQUIRE(libyang::setLogLevel(libyang::LogLevel::Warning) == libyang::LogLevel::Verbose);
+    }
+
+    DOCTEST_SUBCASE("Parsing from a file does not change the log level")
+    {
+        libyang::setLogLevel(libyang::LogLevel::Warning);
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        ctx->parseData(TESTS_DIR / "test_data.json", libyang::DataFormat::JSON);
+        REQUIRE(libyang::setLogLevel(libyang::LogLevel::Warning) == libyang::LogLevel::Warning);
     }
 
     DOCTEST_SUBCASE("Error info")
@@ -644,6 +932,7 @@ TEST_CASE("context")
         DOCTEST_SUBCASE("Data restriction failure - multiple errors")
         {
             ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+            std::optional<libyang::ScopedLogOptions> silenced;
 
             DOCTEST_SUBCASE("Store only last error")
             {
@@ -689,6 +978,13 @@ TEST_CASE("context")
                 };
             }
 
+            DOCTEST_SUBCASE("Storing suppressed in this thread")
+            {
+                libyang::setLogOptions(libyang::LogOptions::Log | libyang::LogOptions::Store);
+                silenced.emplace(libyang::LogOptions::NoLog);
+                expected = {};
+            }
+
             REQUIRE_THROWS(ctx->newPath("/example-schema:leafInt8"));
             REQUIRE_THROWS(ctx->newPath("/example-schema:leafInt8", "9001"));
 
@@ -700,6 +996,224 @@ TEST_CASE("context")
         }
 
         REQUIRE(ctx->getErrors() == expected);
+
+        std::vector<libyang::ErrorInfo> fromViews;
+        for (const auto& view : ctx->errorViews()) {
+            fromViews.push_back(libyang::ErrorInfo{
+                .appTag = view.appTag ? std::optional<std::string>{*view.appTag} : std::nullopt,
+                .level = view.level,
+                .message = std::string{view.message},
+                .code = view.code,
+                .dataPath = view.dataPath ? std::optional<std::string>{*view.dataPath} : std::nullopt,
+                .schemaPath = view.schemaPath ? std::optional<std::string>{*view.schemaPath} : std::nullopt,
+                .line = view.line,
+                .validationCode = view.validationCode,
+            });
+        }
+        REQUIRE(fromViews == expected);
+        REQUIRE(ctx->errorViews().empty() == expected.empty());
+        REQUIRE(ctx->lastErrorCode() == (expected.empty() ? libyang::ErrorCode::Success : expected.back().code));
+    }
+
+    DOCTEST_SUBCASE("parseDataStream")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        std::vector<std::string> records;
+        auto collect = [&records](libyang::DataNode tree) {
+            records.emplace_back(*tree.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::Shrink));
+        };
+
+        std::string input;
+        std::optional<libyang::DataStreamParser> parser;
+        DOCTEST_SUBCASE("JSON")
+        {
+            parser.emplace(ctx->parseDataStream(libyang::DataFormat::JSON, collect));
+            input = R"({
+                "example-schema:leafInt32": 420,
+                "example-schema:person": [{"name": "Dan"}, {"name": "George\"}"}],
+                "example-schema:first": {"second": {"third": {"fourth": {"fifth": "}"}}}}
+            })";
+        }
+
+        DOCTEST_SUBCASE("XML")
+        {
+            parser.emplace(ctx->parseDataStream(libyang::DataFormat::XML, collect));
+            input = R"(<?xml version="1.0"?>
+                <leafInt32 xmlns="http://example.com/coze">420</leafInt32>
+                <!-- <comment/> -->
+                <person xmlns="http://example.com/coze"><name>Dan</name></person>
+                <person xmlns='http://example.com/coze'><name>George"}</name></person>
+                <first xmlns="http://example.com/coze"><second><third><fourth><fifth><![CDATA[}]]></fifth></fourth></third></second></first>
+            )";
+        }
+
+        // feed the input in small chunks, records span several of them
+        for (std::size_t i = 0; i < input.size(); i += 7) {
+            parser->feed(std::string_view{input}.substr(i, 7));
+        }
+        parser->finish();
+
+        std::vector<std::string> expectedRecords{
+            R"({"example-schema:leafInt32":420})",
+            R"({"example-schema:person":[{"name":"Dan"}]})",
+            R"({"example-schema:person":[{"name":"George\"}"}]})",
+            R"({"example-schema:first":{"second":{"third":{"fourth":{"fifth":"}"}}}}})",
+        };
+        REQUIRE(records == expectedRecords);
+
+        auto truncated = ctx->parseDataStream(libyang::DataFormat::JSON, collect);
+        truncated.feed(std::string_view{R"({"example-schema:leafInt32": 1)"});
+        REQUIRE_THROWS_WITH_AS(truncated.finish(), "DataStreamParser::finish: the input has ended in the middle of a record", libyang::Error);
+    }
+
+    DOCTEST_SUBCASE("parseDataStream with a record path")
+    {
+        ctx->setSearchDir(TESTS_DIR / "yang");
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        ctx->loadModule("ietf-netconf", "2011-06-01");
+        std::vector<std::string> records;
+        auto collect = [&records](libyang::DataNode tree) {
+            records.emplace_back(*tree.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::Shrink));
+        };
+
+        std::string input;
+        std::optional<libyang::DataStreamParser> parser;
+        DOCTEST_SUBCASE("JSON")
+        {
+            parser.emplace(ctx->parseDataStream(libyang::DataFormat::JSON, collect, std::nullopt, {
+                .wrappers = {"ietf-restconf:data"},
+                .parents = {"example-schema:bigTree", "two"},
+            }));
+            // the metadata come before the node which they annotate
+            input = R"({"ietf-restconf:data": {
+                "@example-schema:leafInt32": {"ietf-netconf:operation": "delete"},
+                "example-schema:leafInt32": 420,
+                "example-schema:bigTree": {
+                    "one": {"myLeaf": "}"},
+                    "two": {"myList": [{"thekey": 1}, {"thekey": 2}]}
+                }
+            }})";
+        }
+
+        DOCTEST_SUBCASE("XML")
+        {
+            parser.emplace(ctx->parseDataStream(libyang::DataFormat::XML, collect, std::nullopt, {
+                .wrappers = {"data"},
+                .parents = {"example-schema:bigTree", "two"},
+            }));
+            input = R"(<data xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+                <leafInt32 xmlns="http://example.com/coze" xmlns:nc="urn:ietf:params:xml:ns:netconf:base:1.0" nc:operation="delete">420</leafInt32>
+                <bigTree xmlns="http://example.com/coze">
+                    <one><myLeaf>}</myLeaf></one>
+                    <two><myList><thekey>1</thekey></myList><myList><thekey>2</thekey></myList></two>
+                </bigTree>
+            </data>)";
+        }
+
+        for (std::size_t i = 0; i < input.size(); i += 7) {
+            parser->feed(std::string_view{input}.substr(i, 7));
+        }
+        parser->finish();
+
+        std::vector<std::string> expectedRecords{
+            R"({"example-schema:leafInt32":420,"@example-schema:leafInt32":{"ietf-netconf:operation":"delete"}})",
+            R"({"example-schema:bigTree":{"one":{"myLeaf":"}"}}})",
+            R"({"example-schema:bigTree":{"two":{"myList":[{"thekey":1}]}}})",
+            R"({"example-schema:bigTree":{"two":{"myList":[{"thekey":2}]}}})",
+        };
+        REQUIRE(records == expectedRecords);
+    }
+
+    DOCTEST_SUBCASE("Non-throwing variants")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        // store the errors, but don't log them
+        libyang::ScopedLogOptions silenced{libyang::LogOptions::Store};
+        ctx->cleanAllErrors();
+
+        auto bad = ctx->tryParseData(R"({"example-schema:leafInt8": 9001})", libyang::DataFormat::JSON);
+        REQUIRE(!bad);
+        REQUIRE(bad.error() == libyang::ErrorCode::ValidationFailure);
+        REQUIRE_THROWS_WITH_AS(bad.value(), "Expected::value: the operation has failed: LY_EVALID", libyang::ErrorWithCode);
+        REQUIRE(ctx->lastErrorCode() == libyang::ErrorCode::ValidationFailure);
+        REQUIRE(!ctx->errorViews().empty());
+        REQUIRE((*ctx->errorViews().begin()).message == "Value \"9001\" is out of type int8 min/max bounds.");
+
+        ctx->cleanAllErrors();
+        REQUIRE(ctx->lastErrorCode() == libyang::ErrorCode::Success);
+        REQUIRE(ctx->errorViews().empty());
+
+        auto empty = ctx->tryParseData(std::string{}, libyang::DataFormat::JSON);
+        REQUIRE(empty);
+        REQUIRE(empty.error() == libyang::ErrorCode::Success);
+        REQUIRE(!*empty);
+
+        auto good = ctx->tryParseData(R"({"example-schema:leafInt8": 42})", libyang::DataFormat::JSON);
+        REQUIRE(good.has_value());
+        REQUIRE((*good)->path() == "/example-schema:leafInt8");
+        REQUIRE(good.value()->findPath("/example-schema:leafInt8"));
+
+        auto path = good.value()->tryFindPath("/example-schema:leafInt8");
+        REQUIRE(path);
+        REQUIRE(path->has_value());
+        REQUIRE(!good.value()->tryFindPath("/example-schema:dummy").value());
+        REQUIRE(good.value()->tryFindPath("/example-schema:leafInt8[").error() == libyang::ErrorCode::ValidationFailure);
+
+        auto op = ctx->tryParseOp(R"({"example-schema:leafInt8": 42})", libyang::DataFormat::JSON, libyang::OperationType::RpcYang);
+        REQUIRE(!op);
+        REQUIRE(op.error() != libyang::ErrorCode::Success);
+        REQUIRE_THROWS_AS(ctx->tryParseOp("", libyang::DataFormat::JSON, libyang::OperationType::ReplyNetconf), libyang::Error);
+    }
+
+    DOCTEST_SUBCASE("Context::parseMany")
+    {
+        ctx->parseModule(example_schema, libyang::SchemaFormat::YANG);
+        std::vector<std::string> inputs;
+        for (int i = 0; i < 200; ++i) {
+            inputs.push_back(R"({"example-schema:leafInt8": )"s + (i % 10 == 7 ? "9001" : std::to_string(i % 100)) + "}");
+        }
+        inputs.emplace_back();
+
+        REQUIRE_THROWS_WITH_AS(ctx->parseMany(inputs, libyang::DataFormat::JSON), "Context::parseMany: the schema must be locked first", libyang::Error);
+        ctx->lockSchema();
+
+        // errors from before are kept, and the new ones are not left behind
+        libyang::ScopedLogOptions silenced{libyang::LogOptions::Store};
+        ctx->cleanAllErrors();
+        REQUIRE_THROWS(ctx->newPath("/example-schema:leafInt8", "9001"));
+        REQUIRE(ctx->getErrors().size() == 1);
+
+        auto results = ctx->parseMany(inputs, libyang::DataFormat::JSON, std::nullopt, std::nullopt, 4);
+        REQUIRE(results.size() == inputs.size());
+        for (int i = 0; i < 200; ++i) {
+            CAPTURE(i);
+            if (i % 10 == 7) {
+                REQUIRE(!results[i].result);
+                REQUIRE(results[i].result.error() == libyang::ErrorCode::ValidationFailure);
+                REQUIRE(!results[i].errors.empty());
+                REQUIRE(results[i].errors[0].message == "Value \"9001\" is out of type int8 min/max bounds.");
+            } else {
+                REQUIRE(results[i].result);
+                REQUIRE(results[i].errors.empty());
+                REQUIRE((*results[i].result)->asTerm().valueStr() == std::to_string(i % 100));
+            }
+        }
+        REQUIRE(results.back().result);
+        REQUIRE(!*results.back().result);
+        REQUIRE(ctx->getErrors().size() == 1);
+
+        std::vector<std::string> notifications{
+            R"({"example-schema:event": {"event-class": "fault"}})",
+            R"({"example-schema:event": {"no-such-leaf": "fault"}})",
+        };
+        auto ops = ctx->parseMany(notifications, libyang::DataFormat::JSON, libyang::OperationType::NotificationYang);
+        REQUIRE(ops.size() == 2);
+        REQUIRE(ops[0].result);
+        REQUIRE(ops[0].result->op->findPath("/example-schema:event/event-class")->asTerm().valueStr() == "fault");
+        REQUIRE(!ops[1].result);
+        REQUIRE(!ops[1].errors.empty());
+
+        REQUIRE_THROWS_AS(ctx->parseMany(notifications, libyang::DataFormat::JSON, libyang::OperationType::ReplyNetconf), libyang::Error);
     }
 
     DOCTEST_SUBCASE("schema printing")
@@ -7,11 +7,20 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <doctest/doctest.h>
+#include <fstream>
+#include <libyang-cpp/Binding.hpp>
 #include <libyang-cpp/Context.hpp>
 #include <libyang-cpp/Utils.hpp>
 #include <libyang/libyang.h>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
+#include <unordered_set>
 #include "example_schema.hpp"
 #include "pretty_printers.hpp"
 #include "test_vars.hpp"
@@ -159,6 +168,104 @@ TEST_CASE("Data Node manipulation")
 
         auto emptyCont = ctx.newPath("/example-schema:first");
         REQUIRE(emptyCont.printStr(libyang::DataFormat::XML, libyang::PrintFlags::WithSiblings) == std::nullopt);
+
+        DOCTEST_SUBCASE("into a stream")
+        {
+            std::ostringstream oss;
+            node->print(oss, libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont);
+            REQUIRE(oss.str() == expected);
+        }
+
+        DOCTEST_SUBCASE("into a callback")
+        {
+            std::string res;
+            std::size_t chunks = 0;
+            node->print([&](std::string_view chunk) {
+                res += chunk;
+                ++chunks;
+            }, libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont);
+            REQUIRE(res == expected);
+            REQUIRE(chunks > 1);
+
+            REQUIRE_THROWS_WITH_AS(node->print([](std::string_view) {
+                throw std::runtime_error{"sink is full"};
+            }, libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings), "sink is full", std::runtime_error);
+        }
+
+        DOCTEST_SUBCASE("into a file")
+        {
+            auto file = std::filesystem::temp_directory_path() / "libyang-cpp-test-print.json";
+            node->print(file, libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont);
+            std::ifstream ifs{file};
+            REQUIRE(std::string{std::istreambuf_iterator<char>{ifs}, {}} == expected);
+            ifs.close();
+            std::filesystem::remove(file);
+        }
+
+        DOCTEST_SUBCASE("as LYB")
+        {
+            auto lyb = node->printStr(libyang::DataFormat::LYB, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont);
+            REQUIRE(lyb);
+            auto parsed = ctx.parseData(*lyb, libyang::DataFormat::LYB);
+            REQUIRE(parsed->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont) == expected);
+        }
+
+        DOCTEST_SUBCASE("into a compressed file")
+        {
+            libyang::DataFileOptions opts{.bufferSize = 16};
+            std::string suffix;
+            bool supported = true;
+            DOCTEST_SUBCASE("uncompressed")
+            {
+            }
+            DOCTEST_SUBCASE("gzip")
+            {
+                opts.compression = libyang::Compression::Gzip;
+                suffix = ".gz";
+#ifndef LIBYANG_CPP_HAVE_ZLIB
+                supported = false;
+#endif
+            }
+            DOCTEST_SUBCASE("zstd")
+            {
+                opts.compression = libyang::Compression::Zstd;
+                opts.level = 19;
+                suffix = ".zst";
+#ifndef LIBYANG_CPP_HAVE_ZSTD
+                supported = false;
+#endif
+            }
+
+            for (const auto format : {libyang::DataFormat::JSON, libyang::DataFormat::LYB}) {
+                auto file = std::filesystem::temp_directory_path() / ("libyang-cpp-test-print"s + (format == libyang::DataFormat::JSON ? ".json" : ".lyb") + suffix);
+                if (!supported) {
+                    REQUIRE_THROWS_AS(node->print(file, format, libyang::PrintFlags::WithSiblings, opts), libyang::Error);
+                    continue;
+                }
+
+                node->print(file, format, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont, opts);
+                auto parsed = ctx.parseData(file, libyang::DataFormat::Detect, libyang::DataFileOptions{.bufferSize = 7});
+                REQUIRE(parsed->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings | libyang::PrintFlags::KeepEmptyCont) == expected);
+                std::filesystem::remove(file);
+            }
+
+            if (supported && opts.compression != libyang::Compression::None) {
+                // A highly compressible document which decompresses to several MB, so that the decoder's output fills up
+                // long before it runs out of input.
+                auto big = ctx.newPath("/example-schema:person[name='person-0']");
+                for (int i = 1; i < 100'000; ++i) {
+                    big.newPath("/example-schema:person[name='person-" + std::to_string(i) + "']");
+                }
+                auto bigExpected = *big.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings);
+                REQUIRE(bigExpected.size() > 4 * 1024 * 1024);
+
+                auto file = std::filesystem::temp_directory_path() / ("libyang-cpp-test-print-big.json" + suffix);
+                big.print(file, libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings, libyang::DataFileOptions{.compression = opts.compression, .level = opts.level});
+                auto parsed = ctx.parseData(file, libyang::DataFormat::JSON);
+                REQUIRE(parsed->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings) == bigExpected);
+                std::filesystem::remove(file);
+            }
+        }
     }
 
     DOCTEST_SUBCASE("Overwriting a tree with a different tree")
@@ -168,6 +275,46 @@ TEST_CASE("Data Node manipulation")
         node = ctx.parseData(data, libyang::DataFormat::JSON);
     }
 
+    DOCTEST_SUBCASE("Moving nodes")
+    {
+        auto node = *ctx.parseData(data, libyang::DataFormat::JSON);
+
+        DOCTEST_SUBCASE("move construction keeps the tree alive")
+        {
+            auto moved = std::move(node);
+            REQUIRE(moved.path() == "/example-schema:leafInt32");
+            REQUIRE(moved.findPath("/example-schema:first/second/third/fourth"));
+        }
+
+        DOCTEST_SUBCASE("move assignment releases the previous tree")
+        {
+            auto other = *ctx.parseData(data, libyang::DataFormat::JSON);
+            other = std::move(node);
+            REQUIRE(other.path() == "/example-schema:leafInt32");
+        }
+
+        DOCTEST_SUBCASE("moved wrappers are still tracked")
+        {
+            std::vector<libyang::DataNode> nodes;
+            for (int i = 0; i < 10; ++i) {
+                nodes.push_back(*node.findPath("/example-schema:first/second"));
+            }
+            auto moved = std::move(node);
+            moved.findPath("/example-schema:first")->unlink();
+            for (const auto& it : nodes) {
+                REQUIRE(it.path() == "/example-schema:first/second");
+            }
+            REQUIRE(!moved.findPath("/example-schema:first"));
+        }
+
+        DOCTEST_SUBCASE("subclasses")
+        {
+            auto term = node.asTerm();
+            auto movedTerm = std::move(term);
+            REQUIRE(movedTerm.valueStr() == "420");
+        }
+    }
+
     DOCTEST_SUBCASE("findPath")
     {
         auto node = ctx.parseData(data, libyang::DataFormat::JSON);
@@ -431,6 +578,63 @@ TEST_CASE("Data Node manipulation")
             REQUIRE(std::visit(libyang::ValuePrinter{}, term.value()) == expectedPrinter);
         }
 
+        DOCTEST_SUBCASE("valueView")
+        {
+            auto view = [&data](const char* path) { return data->findPath(path)->asTerm().valueView(); };
+
+            REQUIRE(std::get<int8_t>(view("/example-schema:leafInt8")) == -43);
+            REQUIRE(std::get<uint64_t>(view("/example-schema:leafUInt64")) == 453545335344);
+            using namespace libyang::literals;
+            REQUIRE(std::get<libyang::Decimal64>(view("/example-schema:leafDecimal")) == 23212131231.43242_decimal64);
+            REQUIRE(std::get<std::string_view>(view("/example-schema:leafString")) == "AHOJ");
+            REQUIRE(std::get<std::string_view>(view("/example-schema:bossPerson")) == "Dan");
+            REQUIRE(std::holds_alternative<libyang::Empty>(view("/example-schema:leafEmpty")));
+            REQUIRE(std::get<int32_t>(view("/example-schema:intOrString")) == 14332);
+
+            auto binary = std::get<libyang::BinaryView>(view("/example-schema:leafBinary"));
+            REQUIRE(std::vector<uint8_t>(binary.data.begin(), binary.data.end()) == std::vector<uint8_t>{0, 0, 0, 4, 16, 65, 8, 32});
+            REQUIRE(binary.base64 == "AAAABBBBCCC=");
+
+            auto bits = std::get<libyang::BitsView>(view("/example-schema:flagBits"));
+            REQUIRE(bits.size() == 2);
+            REQUIRE(bits[1].position == 2);
+            REQUIRE(bits[1].name == "overflow");
+            std::vector<std::string_view> bitNames;
+            for (const auto& bit : bits) {
+                bitNames.emplace_back(bit.name);
+            }
+            REQUIRE(bitNames == std::vector<std::string_view>{"carry", "overflow"});
+            REQUIRE_THROWS_WITH_AS(bits[2], "BitsView: index out of range", std::out_of_range);
+
+            auto enumView = std::get<libyang::EnumView>(view("/example-schema:pizzaSize"));
+            REQUIRE(enumView.name == "large");
+            REQUIRE(enumView.value == 0);
+
+            auto ident = std::get<libyang::IdentityRefView>(view("/example-schema:leafFoodTypedef"));
+            REQUIRE(ident.module == "example-schema");
+            REQUIRE(ident.name == "hawaii");
+
+            REQUIRE(std::get<libyang::InstanceIdentifierView>(view("/example-schema:targetInstance")).path == "/example-schema:leafBool");
+        }
+
+        DOCTEST_SUBCASE("valueAs")
+        {
+            auto term = [&data](const char* path) { return data->findPath(path)->asTerm(); };
+
+            REQUIRE(term("/example-schema:leafInt16").valueAs<int16_t>() == 3000);
+            REQUIRE(term("/example-schema:leafUInt64").valueAs<uint64_t>() == 453545335344);
+            REQUIRE(term("/example-schema:leafBool").valueAs<bool>() == false);
+            REQUIRE(term("/example-schema:leafString").valueAs<std::string>() == "AHOJ");
+            REQUIRE(term("/example-schema:leafString").valueAs<std::string_view>() == "AHOJ");
+            // unions are resolved to their actual type
+            REQUIRE(term("/example-schema:intOrString").valueAs<int32_t>() == 14332);
+            REQUIRE(term("/example-schema:intOrString").tryValueAs<std::string>() == std::nullopt);
+
+            REQUIRE(term("/example-schema:leafInt16").tryValueAs<int32_t>() == std::nullopt);
+            REQUIRE_THROWS_WITH_AS(term("/example-schema:leafInt16").valueAs<uint16_t>(),
+                    "DataNodeTerm::valueAs: the value of /example-schema:leafInt16 is not of the requested type", libyang::Error);
+        }
+
         DOCTEST_SUBCASE("querying Identity schema from a value")
         {
             auto node = data->findPath("/example-schema:leafFoodTypedef");
@@ -448,6 +652,49 @@ TEST_CASE("Data Node manipulation")
         }
     }
 
+    DOCTEST_SUBCASE("comparing values")
+    {
+        auto first = ctx.newPath("/example-schema:leafInt32", "+42");
+        first.newPath("/example-schema:leafString", "42");
+        auto second = ctx.newPath("/example-schema:leafInt32", "42");
+        auto term = [](const libyang::DataNode& tree, const char* path) { return tree.findPath(path)->asTerm(); };
+
+        DOCTEST_SUBCASE("valueEquals")
+        {
+            REQUIRE(term(first, "/example-schema:leafInt32").valueEquals(term(second, "/example-schema:leafInt32")));
+            REQUIRE(!term(first, "/example-schema:leafString").valueEquals(term(second, "/example-schema:leafInt32")));
+            second.findPath("/example-schema:leafInt32")->asTerm().changeValue("43");
+            REQUIRE(!term(first, "/example-schema:leafInt32").valueEquals(term(second, "/example-schema:leafInt32")));
+        }
+
+        DOCTEST_SUBCASE("valueHash")
+        {
+            REQUIRE(term(first, "/example-schema:leafInt32").valueHash() == term(second, "/example-schema:leafInt32").valueHash());
+            second.findPath("/example-schema:leafInt32")->asTerm().changeValue("43");
+            REQUIRE(term(first, "/example-schema:leafInt32").valueHash() != term(second, "/example-schema:leafInt32").valueHash());
+        }
+
+        DOCTEST_SUBCASE("in an unordered_set")
+        {
+            auto listA = ctx.newPath("/example-schema3:valuesOrderedBySystem[.='1']");
+            listA.newPath("/example-schema3:valuesOrderedBySystem[.='2']");
+            auto listB = ctx.newPath("/example-schema3:valuesOrderedBySystem[.='2']");
+            listB.newPath("/example-schema3:valuesOrderedBySystem[.='3']");
+
+            std::unordered_set<libyang::DataNodeTerm, libyang::TermValueHash, libyang::TermValueHash> seen;
+            for (const auto& tree : {first, second, listA, listB}) {
+                for (const auto& node : tree.firstSibling().siblings()) {
+                    seen.insert(node.asTerm());
+                }
+            }
+
+            // leafInt32 = 42 appears twice, and so does the leaf-list entry 2
+            REQUIRE(seen.size() == 5);
+            REQUIRE(seen.contains(term(second, "/example-schema:leafInt32")));
+            REQUIRE(seen.contains(term(listB, "/example-schema3:valuesOrderedBySystem[.='3']")));
+        }
+    }
+
     DOCTEST_SUBCASE("default values")
     {
         auto data = ctx.parseData(data4, libyang::DataFormat::JSON);
@@ -491,6 +738,44 @@ TEST_CASE("Data Node manipulation")
                 REQUIRE(term.changeValue("cau") == libyang::DataNodeTerm::ValueChange::EqualValueNotChanged);
             }
         }
+
+        DOCTEST_SUBCASE("changing values to native values")
+        {
+            auto tree = ctx.newPath("/example-schema:leafInt32", "1");
+            tree.newPath("/example-schema:leafBool", "false");
+            tree.newPath("/example-schema:leafDecimal", "1.5");
+            tree.newPath("/example-schema:intOrString", "foo");
+            auto term = [&tree](const char* path) { return tree.findPath(path)->asTerm(); };
+
+            REQUIRE(term("/example-schema:leafInt32").changeValue(int32_t{5}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:leafInt32").valueStr() == "5");
+            // integers of other widths are fine as long as they fit
+            REQUIRE(term("/example-schema:leafInt32").changeValue(uint64_t{5}) == libyang::DataNodeTerm::ValueChange::EqualValueNotChanged);
+            REQUIRE(term("/example-schema:leafInt32").changeValue(int8_t{-7}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:leafInt32").valueAs<int32_t>() == -7);
+            REQUIRE_THROWS_AS(term("/example-schema:leafInt32").changeValue(int64_t{1} << 40), libyang::Error);
+            REQUIRE(term("/example-schema:leafInt32").valueAs<int32_t>() == -7);
+
+            REQUIRE(term("/example-schema:leafBool").changeValue(true) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:leafBool").valueAs<bool>() == true);
+
+            REQUIRE(term("/example-schema:leafDecimal").changeValue(libyang::Decimal64{-250000, 5}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:leafDecimal").valueStr() == "-2.5");
+            // different fraction-digits go through the lexical form
+            REQUIRE(term("/example-schema:leafDecimal").changeValue(libyang::Decimal64{-25, 1}) == libyang::DataNodeTerm::ValueChange::EqualValueNotChanged);
+            REQUIRE(term("/example-schema:leafDecimal").changeValue(libyang::Decimal64{-5, 1}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:leafDecimal").valueStr() == "-0.5");
+
+            // union members go through the lexical form as well
+            tree.newPath("/example-schema:pwnedUnion", "1.0");
+            REQUIRE(term("/example-schema:pwnedUnion").changeValue(libyang::Decimal64{-5, 1}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:pwnedUnion").valueStr() == "-0.5");
+
+            REQUIRE(term("/example-schema:intOrString").changeValue(int32_t{123}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:intOrString").valueAs<int32_t>() == 123);
+            REQUIRE(term("/example-schema:intOrString").changeValue(std::string{"bar"}) == libyang::DataNodeTerm::ValueChange::Changed);
+            REQUIRE(term("/example-schema:intOrString").changeValue(libyang::Value{std::string{"bar"}}) == libyang::DataNodeTerm::ValueChange::EqualValueNotChanged);
+        }
     }
 
     DOCTEST_SUBCASE("isTerm")
@@ -508,6 +793,49 @@ TEST_CASE("Data Node manipulation")
         REQUIRE(str == data);
     }
 
+    DOCTEST_SUBCASE("newPaths")
+    {
+        const std::vector<libyang::PathValue> nodes{
+            {"/example-schema:bigTree/one/myLeaf", "AHOJ"},
+            {"/example-schema:bigTree/two/myList[thekey='1']", std::nullopt},
+            {"/example-schema:bigTree/two/myList[thekey='2']", std::nullopt},
+            {"/example-schema:leafInt32", "420"},
+            {"/example-schema:person[name='Dan']", std::nullopt},
+            {"/example-schema:bigTree/two/myList[thekey='3']", std::nullopt},
+        };
+
+        auto expected = ctx.newPath(nodes[0].path, nodes[0].value);
+        for (const auto& node : std::span{nodes}.subspan(1)) {
+            expected.newPath(node.path, node.value);
+        }
+
+        DOCTEST_SUBCASE("Context::newPaths")
+        {
+            auto tree = ctx.newPaths(nodes);
+            REQUIRE(tree);
+            REQUIRE(tree->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings) == expected.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings));
+            REQUIRE(!ctx.newPaths({}));
+        }
+
+        DOCTEST_SUBCASE("DataNode::newPaths")
+        {
+            auto tree = ctx.newPath("/example-schema:leafInt8", "1");
+            tree.newPaths(nodes);
+            REQUIRE(tree.findPath("/example-schema:leafInt8")->asTerm().valueStr() == "1");
+            REQUIRE(tree.findPath("/example-schema:bigTree/one/myLeaf")->asTerm().valueStr() == "AHOJ");
+            REQUIRE(tree.findXPath("/example-schema:bigTree/two/myList").size() == 3);
+            REQUIRE(tree.findPath("/example-schema:person[name='Dan']"));
+
+            REQUIRE_THROWS_WITH_AS(tree.newPaths(std::vector<libyang::PathValue>{{"/example-schema:bigTree/one/myLeaf", "AHOJ"}}),
+                    "Couldn't create a node with path '/example-schema:bigTree/one/myLeaf': LY_EEXIST", libyang::Error);
+        }
+
+        DOCTEST_SUBCASE("errors")
+        {
+            REQUIRE_THROWS_AS(ctx.newPaths(std::vector<libyang::PathValue>{{"/example-schema:bigTree/one/myLeaf", "AHOJ"}, {"/example-schema:bigTree/doesntExist", std::nullopt}}), libyang::Error);
+        }
+    }
+
     DOCTEST_SUBCASE("validateAll throws when you have more references to the node")
     {
         auto node = std::optional{ctx.newPath("/example-schema:leafInt32", "420")};
@@ -522,6 +850,140 @@ TEST_CASE("Data Node manipulation")
         REQUIRE_THROWS_WITH_AS(libyang::validateAll(node, libyang::ValidationOptions::NoState), "libyang:validateAll: lyd_validate_all failed: LY_EVALID", libyang::ErrorWithCode);
     }
 
+    DOCTEST_SUBCASE("validateIncremental")
+    {
+        ctx.parseModule(type_module, libyang::SchemaFormat::YANG);
+
+        DOCTEST_SUBCASE("only the changed modules are validated")
+        {
+            auto node = ctx.parseData(data, libyang::DataFormat::JSON);
+            libyang::validateIncremental(node, libyang::ValidationOptions::NoState);
+            node->findPath("/example-schema:leafInt32")->asTerm().changeValue("123");
+            libyang::validateIncremental(node, libyang::ValidationOptions::NoState);
+
+            node->newPath("/type_module:leafWithConfigFalse", "hi");
+            REQUIRE_THROWS_WITH_AS(libyang::validateIncremental(node, libyang::ValidationOptions::NoState),
+                    "libyang:validateIncremental: lyd_validate_module failed for module 'type_module': LY_EVALID", libyang::ErrorWithCode);
+        }
+
+        DOCTEST_SUBCASE("trees which were never validated are validated as a whole")
+        {
+            auto node = std::optional{ctx.newPath("/type_module:leafWithConfigFalse", "hi")};
+            REQUIRE_THROWS_WITH_AS(libyang::validateIncremental(node, libyang::ValidationOptions::NoState),
+                    "libyang:validateAll: lyd_validate_all failed: LY_EVALID", libyang::ErrorWithCode);
+        }
+
+        DOCTEST_SUBCASE("more references")
+        {
+            auto node = ctx.parseData(data, libyang::DataFormat::JSON);
+            auto node2 = node;
+            REQUIRE_THROWS_WITH_AS(libyang::validateIncremental(node), "validateIncremental: Node is not a unique reference", libyang::Error);
+        }
+    }
+
+    DOCTEST_SUBCASE("ScopedArena")
+    {
+        std::optional<libyang::DataNode> survivor;
+        {
+            libyang::ScopedArena arena;
+            auto tree = ctx.parseData(data, libyang::DataFormat::JSON);
+            REQUIRE(tree->findXPath("/example-schema:first/second").size() == 1);
+            auto node = ctx.newPath("/example-schema:leafInt8", "10");
+
+            {
+                libyang::ScopedArena nested{128};
+                node.newPath("/example-schema:leafInt16", "20");
+                auto unlinked = *tree->findPath("/example-schema:bigTree");
+                unlinked.unlink();
+                REQUIRE(unlinked.findPath("/example-schema:bigTree/one"));
+            }
+
+            survivor = tree->findPath("/example-schema:first/second");
+        }
+
+        // The memory is still alive, because the tree still uses it
+        REQUIRE(survivor->path() == "/example-schema:first/second");
+        REQUIRE(survivor->findXPath("third").size() == 1);
+    }
+
+    DOCTEST_SUBCASE("DataDiff")
+    {
+        auto first = ctx.parseData(data, libyang::DataFormat::JSON);
+        auto second = ctx.parseData(data, libyang::DataFormat::JSON);
+
+        DOCTEST_SUBCASE("equal trees")
+        {
+            auto diff = first->diffSiblings(*second);
+            REQUIRE(diff.empty());
+            REQUIRE(!diff.tree());
+            REQUIRE(diff.changes().empty());
+        }
+
+        DOCTEST_SUBCASE("changes")
+        {
+            first->newPath("/example-schema:leafBool", "true");
+            second->findPath("/example-schema:leafInt32")->asTerm().changeValue("123");
+            second->newPath("/example-schema:leafString", "hi");
+            auto diff = first->diffSiblings(*second);
+            REQUIRE(!diff.empty());
+
+            std::map<std::string, libyang::DiffOperation> expected{
+                {"/example-schema:leafInt32", libyang::DiffOperation::Replace},
+                {"/example-schema:leafBool", libyang::DiffOperation::Delete},
+                {"/example-schema:leafString", libyang::DiffOperation::Create},
+            };
+
+            std::map<std::string, libyang::DiffOperation> streamed;
+            diff.forEachChange([&](const libyang::DataNodeRef& node, const libyang::DiffOperation operation) {
+                streamed.emplace(node.path(), operation);
+            });
+            REQUIRE(streamed == expected);
+
+            std::map<std::string, libyang::DiffOperation> collected;
+            for (const auto& change : diff.changes()) {
+                collected.emplace(change.node.path(), change.operation);
+            }
+            REQUIRE(collected == expected);
+
+            DOCTEST_SUBCASE("apply")
+            {
+                diff.apply(first);
+                REQUIRE(first->findPath("/example-schema:leafInt32")->asTerm().valueStr() == "123");
+                REQUIRE(first->findPath("/example-schema:leafString"));
+                REQUIRE(!first->findPath("/example-schema:leafBool"));
+                REQUIRE(first->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings)
+                        == second->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings));
+            }
+
+            DOCTEST_SUBCASE("more references")
+            {
+                auto copy = first;
+                REQUIRE_THROWS_WITH_AS(diff.apply(first), "DataDiff::apply: Node is not a unique reference", libyang::Error);
+            }
+        }
+
+        DOCTEST_SUBCASE("apply to an empty tree")
+        {
+            second->newPath("/example-schema:leafString", "hi");
+            auto diff = first->diffSiblings(*second);
+            std::optional<libyang::DataNode> empty;
+            diff.apply(empty);
+            REQUIRE(empty);
+            REQUIRE(empty->path() == "/example-schema:leafString");
+        }
+
+        DOCTEST_SUBCASE("diffTree")
+        {
+            second->findPath("/example-schema:leafInt32")->asTerm().changeValue("123");
+            REQUIRE(first->findPath("/example-schema:first")->diffTree(*second->findPath("/example-schema:first")).empty());
+
+            auto changes = first->findPath("/example-schema:leafInt32")->diffTree(*second->findPath("/example-schema:leafInt32")).changes();
+            REQUIRE(changes.size() == 1);
+            REQUIRE(changes[0].node.path() == "/example-schema:leafInt32");
+            REQUIRE(changes[0].operation == libyang::DiffOperation::Replace);
+        }
+    }
+
     DOCTEST_SUBCASE("unlink")
     {
         auto root = ctx.parseData(data2, libyang::DataFormat::JSON);
@@ -686,6 +1148,194 @@ TEST_CASE("Data Node manipulation")
         }
     }
 
+    DOCTEST_SUBCASE("TreeEditBatch")
+    {
+        auto root = *ctx.parseData(data3, libyang::DataFormat::JSON);
+
+        DOCTEST_SUBCASE("inserting temporary nodes")
+        {
+            auto batch = root.beginBatch();
+            for (const auto name : {"Dan", "George", "John"}) {
+                // The temporary tree loses its last wrapper within the batch, but it must not be freed.
+                root.insertSibling(ctx.newPath("/example-schema:person[name='"s + name + "']"));
+            }
+            batch.commit();
+
+            REQUIRE(root.findXPath("/example-schema:person").size() == 3);
+            REQUIRE(root.findPath("/example-schema:person[name='George']")->path() == "/example-schema:person[name='George']");
+        }
+
+        DOCTEST_SUBCASE("unlinking")
+        {
+            auto one = *root.findPath("/example-schema2:contWithTwoNodes/one");
+            auto set = root.findXPath("/example-schema2:contWithTwoNodes/two");
+            auto setOfOne = root.findXPath("/example-schema2:contWithTwoNodes/one");
+
+            DOCTEST_SUBCASE("keep a reference")
+            {
+                {
+                    auto batch = root.beginBatch();
+                    one.unlink();
+                    REQUIRE(one.path() == "/example-schema2:one");
+                    // nothing is invalidated until the batch is committed...
+                    REQUIRE(setOfOne.size() == 1);
+                }
+                // ...and then only the sets whose nodes have moved to another tree are
+                REQUIRE_THROWS_WITH_AS(setOfOne.begin(), "Set is invalid", std::out_of_range);
+                REQUIRE(set.front().path() == "/example-schema2:contWithTwoNodes/two");
+
+                // `one` now lives in a separate tree
+                root = *ctx.parseData(data3, libyang::DataFormat::JSON);
+                REQUIRE(one.path() == "/example-schema2:one");
+                REQUIRE(one.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings) == "{\n  \"example-schema2:one\": 123\n}\n");
+            }
+
+            DOCTEST_SUBCASE("drop the reference")
+            {
+                auto batch = root.beginBatch();
+                one.unlink();
+                one = root;
+                batch.commit();
+                // the unlinked tree was freed, the original one is still there
+                REQUIRE(root.findPath("/example-schema2:contWithTwoNodes/two"));
+                REQUIRE(!root.findPath("/example-schema2:contWithTwoNodes/one"));
+            }
+
+            DOCTEST_SUBCASE("moving between trees")
+            {
+                auto other = ctx.newPath("/example-schema2:contWithTwoNodes");
+                {
+                    auto batch = root.beginBatch();
+                    other.insertChild(one);
+                    other.insertChild(*root.findPath("/example-schema2:contWithTwoNodes/two"));
+                }
+                root = other;
+                REQUIRE(one.path() == "/example-schema2:contWithTwoNodes/one");
+                REQUIRE(other.findPath("/example-schema2:contWithTwoNodes/two"));
+            }
+        }
+
+        DOCTEST_SUBCASE("a tree can only be in a single batch")
+        {
+            auto batch = root.beginBatch();
+            REQUIRE_THROWS_WITH_AS(root.beginBatch(), "TreeEditBatch: the tree is already a part of another batch", libyang::Error);
+            auto other = ctx.newPath("/example-schema2:contWithTwoNodes");
+            auto otherBatch = other.beginBatch();
+            REQUIRE_THROWS_WITH_AS(root.insertSibling(other), "TreeEditBatch: the tree is already a part of another batch", libyang::Error);
+        }
+    }
+
+    DOCTEST_SUBCASE("FrozenTree")
+    {
+        auto root = *ctx.parseData(data, libyang::DataFormat::JSON);
+        auto leaf = *root.findPath("/example-schema:leafInt32");
+        std::optional<libyang::FrozenTree> frozen = leaf.freeze();
+        REQUIRE(frozen->root() == root);
+
+        DOCTEST_SUBCASE("the tree cannot be modified")
+        {
+            REQUIRE_THROWS_WITH_AS(leaf.unlink(), "DataNode::unlink: the tree is frozen", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(root.newPath("/example-schema:leafInt8", "3"), "DataNode::newPath: the tree is frozen", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(leaf.asTerm().changeValue("3"), "DataNodeTerm::changeValue: the tree is frozen", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(root.beginBatch(), "DataNode::beginBatch: the tree is frozen", libyang::Error);
+
+            // once the last handle is gone, the tree is writable again
+            std::optional<libyang::FrozenTree> another = root.freeze();
+            frozen.reset();
+            REQUIRE_THROWS_WITH_AS(leaf.unlink(), "DataNode::unlink: the tree is frozen", libyang::Error);
+            another.reset();
+            leaf.unlink();
+            REQUIRE(!root.findPath("/example-schema:leafInt32"));
+        }
+
+        DOCTEST_SUBCASE("parallelDfs")
+        {
+            std::vector<std::string> expected;
+            for (const auto& sibling : root.siblings()) {
+                for (const auto& node : sibling.childrenDfs()) {
+                    expected.emplace_back(node.path());
+                }
+            }
+
+            std::mutex lock;
+            std::vector<std::string> visited;
+            frozen->parallelDfs([&](const libyang::DataNodeRef& ref) {
+                // promoting to a DataNode touches the shared registry
+                auto node = ref.node();
+                std::lock_guard guard{lock};
+                visited.emplace_back(node.path());
+            }, 4);
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(visited.begin(), visited.end());
+            REQUIRE(visited == expected);
+        }
+
+        DOCTEST_SUBCASE("parallelForEachChild")
+        {
+            std::atomic<int> count{0};
+            std::atomic<int> unexpected{0};
+            frozen->parallelForEachChild(*root.findPath("/example-schema:bigTree"), [&](const libyang::DataNodeRef& ref) {
+                if (ref.name() != "one" && ref.name() != "two") {
+                    ++unexpected;
+                }
+                ++count;
+            });
+            REQUIRE(count == 2);
+            REQUIRE(unexpected == 0);
+
+            auto other = ctx.newPath("/example-schema:bigTree");
+            REQUIRE_THROWS_WITH_AS(frozen->parallelForEachChild(other, [](const auto&) {}),
+                    "FrozenTree::parallelForEachChild: the node is not a part of this tree", libyang::Error);
+        }
+
+        DOCTEST_SUBCASE("exceptions are propagated")
+        {
+            REQUIRE_THROWS_WITH_AS(frozen->parallelDfs([](const libyang::DataNodeRef& ref) {
+                if (ref.name() == "third") {
+                    throw std::runtime_error{"boom"};
+                }
+            }, 3), "boom", std::runtime_error);
+        }
+    }
+
+    DOCTEST_SUBCASE("DataNode::snapshot")
+    {
+        auto root = *ctx.parseData(data, libyang::DataFormat::JSON);
+        auto leaf = *root.findPath("/example-schema:leafInt32");
+        auto snapshot = leaf.snapshot();
+        REQUIRE(snapshot.root() != root);
+        REQUIRE(*snapshot.root().printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings) == *root.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::WithSiblings));
+
+        // the snapshot is read-only, the original tree is not
+        REQUIRE_THROWS_WITH_AS(snapshot.root().newPath("/example-schema:leafInt8", "3"), "DataNode::newPath: the tree is frozen", libyang::Error);
+
+        // without changes, the copy is shared
+        REQUIRE(root.snapshot().root() == snapshot.root());
+
+        leaf.asTerm().changeValue("666");
+        REQUIRE(std::get<int32_t>(snapshot.root().findPath("/example-schema:leafInt32")->asTerm().value()) == 420);
+        auto newer = root.snapshot();
+        REQUIRE(newer.root() != snapshot.root());
+        REQUIRE(std::get<int32_t>(newer.root().findPath("/example-schema:leafInt32")->asTerm().value()) == 666);
+
+        root.newPath("/example-schema:leafInt8", "3");
+        REQUIRE(!newer.root().findPath("/example-schema:leafInt8"));
+        REQUIRE(root.snapshot().root().findPath("/example-schema:leafInt8"));
+
+        // the cache does not keep the copy alive once all of its readers are gone
+        std::optional<libyang::DataNode> oldRoot;
+        {
+            auto reader = root.snapshot();
+            oldRoot = reader.root();
+            REQUIRE(root.snapshot().root() == *oldRoot);
+        }
+        REQUIRE(root.snapshot().root() != *oldRoot);
+
+        auto batch = root.beginBatch();
+        REQUIRE_THROWS_WITH_AS(root.snapshot(), "DataNode::snapshot: the tree is a part of an uncommitted TreeEditBatch", libyang::Error);
+    }
+
     DOCTEST_SUBCASE("DataNode::unlinkWithSiblings")
     {
         DOCTEST_SUBCASE("Nodes have no parent")
@@ -1020,6 +1670,52 @@ TEST_CASE("Data Node manipulation")
         REQUIRE(dup->path() == "/example-schema:leafInt8");
     }
 
+    DOCTEST_SUBCASE("DataNode::duplicate into a parent")
+    {
+        auto source = ctx.newPath("/example-schema:bigTree/one/myLeaf", "AHOJ");
+        source.newPath("/example-schema:bigTree/two/myList[thekey='1']");
+        auto target = ctx.newPath("/example-schema:bigTree");
+        auto myLeaf = *source.findPath("/example-schema:bigTree/one/myLeaf");
+
+        auto one = myLeaf.parent()->duplicate(libyang::DuplicationOptions::Recursive, target);
+        REQUIRE(one.parent() == target);
+        REQUIRE(target.findPath("/example-schema:bigTree/one/myLeaf")->asTerm().valueStr() == "AHOJ");
+
+        auto theKey = *source.findPath("/example-schema:bigTree/two/myList[thekey='1']/thekey");
+        REQUIRE_THROWS_AS(theKey.duplicate(std::nullopt, target), libyang::ErrorWithCode);
+
+        auto copied = source.child()->duplicateWithSiblings(libyang::DuplicationOptions::Recursive, ctx.newPath("/example-schema:bigTree"));
+        REQUIRE(copied.nextSibling()->path() == "/example-schema:bigTree/two");
+        REQUIRE(copied.parent()->path() == "/example-schema:bigTree");
+    }
+
+    DOCTEST_SUBCASE("DataNode::duplicatePartial")
+    {
+        auto source = ctx.newPath("/example-schema:bigTree/one/myLeaf", "AHOJ");
+        source.newPath("/example-schema:bigTree/two/myList[thekey='1']");
+        auto shrink = libyang::PrintFlags::Shrink | libyang::PrintFlags::KeepEmptyCont;
+
+        REQUIRE(*source.duplicatePartial(0, nullptr).printStr(libyang::DataFormat::JSON, shrink) == R"({"example-schema:bigTree":{}})");
+        REQUIRE(*source.duplicatePartial(1, nullptr).printStr(libyang::DataFormat::JSON, shrink) == R"({"example-schema:bigTree":{"one":{},"two":{}}})");
+        REQUIRE(*source.duplicatePartial(2, nullptr).printStr(libyang::DataFormat::JSON, shrink)
+                == R"({"example-schema:bigTree":{"one":{"myLeaf":"AHOJ"},"two":{"myList":[{"thekey":1}]}}})");
+
+        auto onlyOne = [](const libyang::SchemaNode& schema) { return schema.nameView() != "two"; };
+        REQUIRE(*source.duplicatePartial(std::nullopt, onlyOne).printStr(libyang::DataFormat::JSON, shrink) == R"({"example-schema:bigTree":{"one":{"myLeaf":"AHOJ"}}})");
+
+        auto target = ctx.newPath("/example-schema:bigTree");
+        auto two = source.findPath("/example-schema:bigTree/two")->duplicatePartial(std::nullopt, nullptr, std::nullopt, target);
+        REQUIRE(two.parent() == target);
+        REQUIRE(*target.printStr(libyang::DataFormat::JSON, shrink) == R"({"example-schema:bigTree":{"two":{"myList":[{"thekey":1}]}}})");
+
+        // nothing is left behind when the filter throws
+        auto throwing = [](const libyang::SchemaNode&) -> bool { throw std::runtime_error{"no filtering today"}; };
+        auto one = *source.findPath("/example-schema:bigTree/one");
+        REQUIRE_THROWS_WITH_AS(one.duplicatePartial(std::nullopt, throwing, libyang::DuplicationOptions::WithParents), "no filtering today", std::runtime_error);
+        REQUIRE_THROWS_WITH_AS(one.duplicatePartial(std::nullopt, throwing, std::nullopt, target), "no filtering today", std::runtime_error);
+        REQUIRE(*target.printStr(libyang::DataFormat::JSON, shrink) == R"({"example-schema:bigTree":{"two":{"myList":[{"thekey":1}]}}})");
+    }
+
     DOCTEST_SUBCASE("DataNode::childrenDfs")
     {
         const auto dataToIter = R"(
@@ -1070,6 +1766,33 @@ TEST_CASE("Data Node manipulation")
             REQUIRE(res == expected);
         }
 
+        DOCTEST_SUBCASE("borrowed references")
+        {
+            auto coll = node->childrenDfs();
+            std::vector<std::string> names;
+            for (const auto ref : coll.refs()) {
+                names.emplace_back(ref.name());
+            }
+            REQUIRE(names == std::vector<std::string>{"bigTree", "one", "myLeaf", "two", "myList", "thekey", "myList", "thekey", "myList", "thekey"});
+
+            auto refs = coll.refs();
+            auto it = refs.begin();
+            REQUIRE((*it).path() == "/example-schema:bigTree");
+            REQUIRE((*it).schema().path() == "/example-schema:bigTree");
+            REQUIRE((*it).node() == *node);
+            REQUIRE(std::distance(refs.begin(), refs.end()) == 10);
+            auto leaf = *std::next(refs.begin(), 2);
+            REQUIRE(std::get<std::string_view>(leaf.valueView()) == "AHOJ");
+            REQUIRE_THROWS_WITH_AS((*it).valueView(), "Node is not a leaf or a leaflist", libyang::Error);
+
+            // the references and the iterators get invalidated together with the collection
+            auto promoted = leaf.node();
+            node->findPath("/example-schema:bigTree/one")->unlink();
+            REQUIRE_THROWS_WITH_AS(leaf.name(), "DataNodeRef is invalid", std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(*it, "Iterator is invalid", std::out_of_range);
+            REQUIRE(promoted.asTerm().valueStr() == "AHOJ");
+        }
+
         DOCTEST_SUBCASE("DFS on a leaf")
         {
             node = *node->findPath("/example-schema:bigTree/one/myLeaf");
@@ -1123,6 +1846,22 @@ TEST_CASE("Data Node manipulation")
             }
         }
 
+        DOCTEST_SUBCASE("moving")
+        {
+            auto coll = node->childrenDfs();
+            auto iter = coll.begin();
+            auto movedColl = std::move(coll);
+            auto movedIter = std::move(iter);
+            REQUIRE(movedIter->path() == "/example-schema:bigTree");
+            REQUIRE_THROWS_WITH_AS(coll.begin(), "Collection is invalid", std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(*iter, "Iterator is invalid", std::out_of_range);
+
+            // the moved-to collection keeps being tracked by the tree
+            node->findPath("/example-schema:bigTree/one")->unlink();
+            REQUIRE_THROWS_WITH_AS(movedColl.begin(), "Collection is invalid", std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(*movedIter, "Iterator is invalid", std::out_of_range);
+        }
+
         DOCTEST_SUBCASE("invalidating iterators")
         {
             std::vector<std::string> expectedPaths;
@@ -1201,6 +1940,34 @@ TEST_CASE("Data Node manipulation")
             }
         }
 
+        DOCTEST_SUBCASE("unrelated subtrees")
+        {
+            auto coll = node->findPath("/example-schema:bigTree/two")->childrenDfs();
+            auto siblings = node->findPath("/example-schema:bigTree/two")->siblings();
+            auto iter = coll.begin();
+
+            node->findPath("/example-schema:bigTree/one")->unlink();
+
+            // nothing from /bigTree/two was touched
+            REQUIRE(iter->path() == "/example-schema:bigTree/two");
+            std::vector<std::string> paths;
+            for (const auto& it : coll) {
+                paths.emplace_back(it.path());
+            }
+            REQUIRE(paths.size() == 7);
+            // ...but a sibling of that node was
+            REQUIRE_THROWS_WITH_AS(siblings.begin(), "Collection is invalid", std::out_of_range);
+        }
+
+        DOCTEST_SUBCASE("unlinkWithSiblings moves wrappers of descendants of following siblings")
+        {
+            auto key = node->findPath("/example-schema:bigTree/two/myList[thekey='432']/thekey");
+            node->findPath("/example-schema:bigTree/one")->unlinkWithSiblings();
+            node = std::nullopt;
+            REQUIRE(key->path() == "/example-schema:two/myList[thekey='432']/thekey");
+            REQUIRE(key->parent()->parent()->path() == "/example-schema:two");
+        }
+
         DOCTEST_SUBCASE("Assigning iterators")
         {
             auto coll = node->childrenDfs();
@@ -1323,6 +2090,29 @@ TEST_CASE("Data Node manipulation")
         {
             auto set = node->findXPath("/example-schema:person[name='Dan']");
             auto copy = set;
+            REQUIRE(copy.size() == 1);
+            REQUIRE(copy.front().path() == "/example-schema:person[name='Dan']");
+
+            // copies are tracked as well, so they get invalidated together with the original
+            node = std::nullopt;
+            REQUIRE_THROWS_WITH_AS(set.begin(), "Set is invalid", std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(copy.begin(), "Set is invalid", std::out_of_range);
+        }
+
+        DOCTEST_SUBCASE("Moving DataNodeSet")
+        {
+            auto set = node->findXPath("/example-schema:person");
+            auto iter = set.begin();
+            auto moved = std::move(set);
+            REQUIRE(moved.size() == 3);
+            REQUIRE(iter->path() == "/example-schema:person[name='Dan']");
+            auto movedIter = std::move(iter);
+            REQUIRE((++movedIter)->path() == "/example-schema:person[name='David']");
+
+            // the moved-to set and its iterators are still invalidated when the tree goes away
+            node = std::nullopt;
+            REQUIRE_THROWS_WITH_AS(moved.begin(), "Set is invalid", std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(*movedIter, "Iterator is invalid", std::out_of_range);
         }
 
         DOCTEST_SUBCASE("Standard algorithms")
@@ -1366,6 +2156,24 @@ TEST_CASE("Data Node manipulation")
             REQUIRE_THROWS_WITH_AS(*iter, "Dereferenced an .end() iterator", std::out_of_range);
         }
 
+        DOCTEST_SUBCASE("checked expressions")
+        {
+            auto persons = ctx.checkXPath("/example-schema:person");
+            REQUIRE(persons.expression() == "/example-schema:person");
+            REQUIRE(node->findXPath(persons).size() == 3);
+            REQUIRE(libyang::findXPathAt(std::nullopt, *node, persons).size() == 3);
+
+            REQUIRE(node->findXPath(ctx.checkXPath("/example-schema:person[name='Dan']")).front().path() == "/example-schema:person[name='Dan']");
+            REQUIRE(node->findXPath(ctx.checkXPath("/example-schema:person[name='non-existent']")).empty());
+
+            REQUIRE_THROWS_AS(ctx.checkXPath("/example-schema:person["), libyang::Error);
+
+            libyang::Context otherCtx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+            otherCtx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+            REQUIRE_THROWS_WITH_AS(node->findXPath(otherCtx.checkXPath("/example-schema:person")),
+                    "DataNode::findXPath: XPath '/example-schema:person' was checked in a different context", libyang::Error);
+        }
+
         DOCTEST_SUBCASE("Iterator arithmetic operators")
         {
             auto set = node->findXPath("/example-schema:person");
@@ -1391,6 +2199,43 @@ TEST_CASE("Data Node manipulation")
             REQUIRE_THROWS(--iter);
         }
 
+        DOCTEST_SUBCASE("Random access")
+        {
+            auto set = node->findXPath("/example-schema:person");
+
+            REQUIRE(set[1].path() == "/example-schema:person[name='David']");
+            REQUIRE(set.at(2).path() == "/example-schema:person[name='John']");
+            REQUIRE_THROWS_WITH_AS(set.at(3), "Set::at: index out of range", std::out_of_range);
+
+            auto iter = set.begin();
+            iter += 2;
+            REQUIRE(iter->path() == "/example-schema:person[name='John']");
+            iter -= 1;
+            REQUIRE(iter[-1].path() == "/example-schema:person[name='Dan']");
+            REQUIRE(iter[1].path() == "/example-schema:person[name='John']");
+            REQUIRE_THROWS_WITH_AS(iter[2], "Dereferenced an iterator out of the Set", std::out_of_range);
+            REQUIRE((2 + set.begin()) == set.end() - 1);
+            REQUIRE(set.end() - set.begin() == 3);
+            REQUIRE(std::distance(set.begin(), set.end()) == 3);
+            REQUIRE(set.begin() < iter);
+            REQUIRE(iter <= set.end());
+
+            auto david = std::lower_bound(set.begin(), set.end(), "David", [](const libyang::DataNode& node, const std::string& name) {
+                return node.findPath("name")->asTerm().valueStr() < name;
+            });
+            REQUIRE(david - set.begin() == 1);
+
+            auto vector = set.toVector();
+            REQUIRE(vector.size() == 3);
+            std::sort(vector.begin(), vector.end(), [](const auto& a, const auto& b) { return a.path() > b.path(); });
+            REQUIRE(vector.front().path() == "/example-schema:person[name='John']");
+
+            // plain vectors are not tied to the tree
+            node->findPath("/example-schema:person[name='Dan']")->unlink();
+            REQUIRE_THROWS_WITH_AS(set[0], "Set is invalid", std::out_of_range);
+            REQUIRE(vector.back().path() == "/example-schema:person[name='Dan']");
+        }
+
         DOCTEST_SUBCASE("Set class and iterator invalidation")
         {
             auto set = node->findXPath("/example-schema:person[name='John']");
@@ -1408,6 +2253,14 @@ TEST_CASE("Data Node manipulation")
                 REQUIRE_THROWS_WITH_AS(*iter, "Iterator is invalid", std::out_of_range);
             }
 
+            DOCTEST_SUBCASE("Set is not affected by unlinking other nodes")
+            {
+                auto iter = set.begin();
+                node->findPath("/example-schema:person[name='David']")->unlink();
+                REQUIRE(set.front().path() == "/example-schema:person[name='John']");
+                REQUIRE(iter->path() == "/example-schema:person[name='John']");
+            }
+
             DOCTEST_SUBCASE("Set invalidation on unlink")
             {
                 auto iter = set.begin();
@@ -1439,6 +2292,316 @@ TEST_CASE("Data Node manipulation")
         }
     }
 
+    DOCTEST_SUBCASE("DataNode::findListInstance")
+    {
+        auto root = ctx.parseData(data4, libyang::DataFormat::JSON);
+        auto person = ctx.findPath("/example-schema3:person");
+
+        DOCTEST_SUBCASE("top-level list")
+        {
+            REQUIRE(root->findListInstance(person, std::vector<libyang::Value>{"Dan"s})->path() == "/example-schema3:person[name='Dan']");
+            REQUIRE(root->findListInstance(person, std::vector<libyang::Value>{"George"s})->path() == "/example-schema3:person[name='George']");
+            REQUIRE(!root->findListInstance(person, std::vector<libyang::Value>{"non-existent"s}));
+            REQUIRE_THROWS_WITH_AS(root->findListInstance(person, std::vector<libyang::Value>{}),
+                    "DataNode::findListInstance: expected 1 key values, got 0", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(root->findListInstance(ctx.findPath("/example-schema3:values"), std::vector<libyang::Value>{int32_t{10}}),
+                    "DataNode::findListInstance: `list` is not a list", libyang::Error);
+        }
+
+        DOCTEST_SUBCASE("nested list with a non-string key")
+        {
+            auto tree = ctx.newPath("/example-schema:bigTree/two/myList[thekey='1']");
+            tree.newPath("/example-schema:bigTree/two/myList[thekey='2']");
+            auto two = *tree.findPath("/example-schema:bigTree/two");
+            auto myList = ctx.findPath("/example-schema:bigTree/two/myList");
+            REQUIRE(two.child()->findListInstance(myList, std::vector<libyang::Value>{int32_t{2}})->path() == "/example-schema:bigTree/two/myList[thekey='2']");
+            REQUIRE(!two.child()->findListInstance(myList, std::vector<libyang::Value>{int32_t{3}}));
+            REQUIRE(!tree.findListInstance(myList, std::vector<libyang::Value>{int32_t{1}}));
+        }
+
+        DOCTEST_SUBCASE("decimal64 keys")
+        {
+            ctx.parseModule(R"(
+                module decimal-keys {
+                    namespace "d";
+                    prefix "d";
+                    list offset {
+                        key "value";
+                        leaf value {
+                            type decimal64 {
+                                fraction-digits 2;
+                            }
+                        }
+                    }
+                })"s, libyang::SchemaFormat::YANG);
+            auto offsets = ctx.newPath("/decimal-keys:offset[value='0.5']");
+            offsets.newPath("/decimal-keys:offset[value='-0.5']");
+            auto offset = ctx.findPath("/decimal-keys:offset");
+            REQUIRE(offsets.findListInstance(offset, std::vector<libyang::Value>{libyang::Decimal64{-50, 2}})->path() == "/decimal-keys:offset[value='-0.5']");
+            REQUIRE(offsets.findListInstance(offset, std::vector<libyang::Value>{libyang::Decimal64{50, 2}})->path() == "/decimal-keys:offset[value='0.5']");
+        }
+
+        DOCTEST_SUBCASE("prepared keys")
+        {
+            auto tree = ctx.newPath("/example-schema:bigTree/two/myList[thekey='1']");
+            tree.newPath("/example-schema:bigTree/two/myList[thekey='2']");
+            auto two = *tree.findPath("/example-schema:bigTree/two");
+            auto myList = ctx.findPath("/example-schema:bigTree/two/myList");
+            auto key = two.child()->listInstanceKey(myList, std::vector<libyang::Value>{int32_t{2}});
+            REQUIRE(two.child()->findListInstance(key)->path() == "/example-schema:bigTree/two/myList[thekey='2']");
+
+            // the key outlives the tree which it was created from, and works with other trees
+            auto copy = tree.duplicateWithSiblings(libyang::DuplicationOptions::Recursive);
+            tree = ctx.newPath("/example-schema:bigTree/one");
+            REQUIRE(copy.findPath("/example-schema:bigTree/two")->child()->findListInstance(key)->path() == "/example-schema:bigTree/two/myList[thekey='2']");
+            auto other = ctx.newPath("/example-schema:bigTree/two/myList[thekey='3']");
+            REQUIRE(!other.findPath("/example-schema:bigTree/two/myList")->findListInstance(key));
+
+            REQUIRE_THROWS_WITH_AS(tree.listInstanceKey(myList, std::vector<libyang::Value>{int32_t{2}}),
+                    "DataNode::listInstanceKey: `list` is not top-level, but this node is", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(root->findListInstance(root->listInstanceKey(person, std::vector<libyang::Value>{})),
+                    "DataNode::listInstanceKey: expected 1 key values, got 0", libyang::Error);
+            REQUIRE(root->findListInstance(root->listInstanceKey(person, std::vector<libyang::Value>{"Dan"s}))->path() == "/example-schema3:person[name='Dan']");
+
+            libyang::Context otherCtx(std::nullopt, libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd);
+            otherCtx.parseModule(example_schema, libyang::SchemaFormat::YANG);
+            auto foreign = otherCtx.newPath("/example-schema:bigTree/two/myList[thekey='2']").findPath("/example-schema:bigTree/two/myList");
+            REQUIRE_THROWS_WITH_AS(foreign->findListInstance(key), "DataNode::findListInstance: the key was prepared in a different context", libyang::Error);
+        }
+
+        DOCTEST_SUBCASE("findSibling")
+        {
+            auto other = ctx.parseData(data4, libyang::DataFormat::JSON);
+            auto george = other->findPath("/example-schema3:person[name='George']");
+            REQUIRE(root->findSibling(*george)->path() == "/example-schema3:person[name='George']");
+            REQUIRE(root->findSibling(*george) != george);
+            REQUIRE(root->findSibling(*other->findPath("/example-schema3:values[.='30']"))->path() == "/example-schema3:values[.='30']");
+            REQUIRE(!root->findSibling(ctx.newPath("/example-schema3:person[name='Nobody']")));
+        }
+    }
+
+    DOCTEST_SUBCASE("StructBinding")
+    {
+        struct TwoNodes {
+            int32_t one = 0;
+            std::optional<int64_t> two;
+        };
+        auto binding = libyang::StructBinding<TwoNodes>{ctx.findPath("/example-schema2:contWithTwoNodes")}
+            .field("one", &TwoNodes::one)
+            .field("two", &TwoNodes::two);
+
+        auto cont = ctx.newPath("/example-schema2:contWithTwoNodes/one", "-5");
+        auto decoded = binding.decode(cont);
+        REQUIRE(decoded.one == -5);
+        REQUIRE(decoded.two == std::nullopt);
+
+        cont.newPath("/example-schema2:contWithTwoNodes/two", "42");
+        binding.decodeInto(cont, decoded);
+        REQUIRE(decoded.one == -5);
+        REQUIRE(decoded.two == 42);
+
+        auto one = *cont.findPath("/example-schema2:contWithTwoNodes/one");
+        binding.encode(TwoNodes{.one = 7, .two = std::nullopt}, cont);
+        REQUIRE(one.asTerm().valueStr() == "7");
+        REQUIRE(!cont.findPath("/example-schema2:contWithTwoNodes/two"));
+        binding.encode(TwoNodes{.one = 7, .two = 8}, cont);
+        REQUIRE(*cont.printStr(libyang::DataFormat::JSON, libyang::PrintFlags::Shrink) == R"({"example-schema2:contWithTwoNodes":{"one":7,"two":8}})");
+
+        REQUIRE_THROWS_WITH_AS(binding.decode(ctx.newPath("/example-schema:leafInt8", "1")),
+                "StructBinding::decode: the binding is for /example-schema2:contWithTwoNodes, not for /example-schema:leafInt8", libyang::Error);
+
+        DOCTEST_SUBCASE("leaf-lists and list keys")
+        {
+            ctx.parseModule(type_module, libyang::SchemaFormat::YANG);
+            struct Choice {
+                std::string l;
+                std::vector<std::string> ll;
+            };
+            auto choiceBinding = libyang::StructBinding<Choice>{ctx.findPath("/type_module:choiceBasicContainer")}
+                .field("l", &Choice::l)
+                .field("ll", &Choice::ll);
+            auto node = ctx.newPath("/type_module:choiceBasicContainer/ll", "a");
+            node.newPath("/type_module:choiceBasicContainer/ll", "b");
+            REQUIRE(choiceBinding.decode(node).ll == std::vector<std::string>{"a", "b"});
+
+            choiceBinding.encode(Choice{.l = "x", .ll = {"c"}}, node);
+            auto roundTrip = choiceBinding.decode(node);
+            REQUIRE(roundTrip.l == "x");
+            REQUIRE(roundTrip.ll == std::vector<std::string>{"c"});
+
+            struct Person {
+                std::string name;
+            };
+            auto personBinding = libyang::StructBinding<Person>{ctx.findPath("/example-schema3:person")}.field("name", &Person::name);
+            auto person = ctx.newPath("/example-schema3:person[name='Dan']");
+            REQUIRE(personBinding.decode(person).name == "Dan");
+            personBinding.encode(Person{.name = "George"}, person);
+            REQUIRE(person.path() == "/example-schema3:person[name='Dan']");
+        }
+
+        DOCTEST_SUBCASE("invalid fields")
+        {
+            struct Wrong {
+                bool one;
+                std::vector<int32_t> two;
+                std::string three;
+            };
+            libyang::StructBinding<Wrong> wrong{ctx.findPath("/example-schema2:contWithTwoNodes")};
+            REQUIRE_THROWS_WITH_AS(wrong.field("one", &Wrong::one),
+                    "StructBinding::field: the member type does not fit the type of 'one'", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(wrong.field("two", &Wrong::two),
+                    "StructBinding::field: 'two' is not a leaf-list", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(wrong.field("three", &Wrong::three),
+                    "StructBinding::field: no leaf or leaf-list named 'three'", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(libyang::StructBinding<Wrong>{ctx.findPath("/example-schema:leafInt8")},
+                    "StructBinding: /example-schema:leafInt8 is not a container or a list", libyang::Error);
+        }
+
+        DOCTEST_SUBCASE("too narrow members")
+        {
+            ctx.parseModule(R"(
+                module narrow {
+                    namespace "n";
+                    prefix "n";
+                    container limits {
+                        leaf percent {
+                            type int32 {
+                                range "-100..100";
+                            }
+                        }
+                        leaf port {
+                            type uint32 {
+                                range "1..65535";
+                            }
+                        }
+                    }
+                })"s, libyang::SchemaFormat::YANG);
+
+            struct Narrow {
+                int8_t one;
+                uint8_t port;
+            };
+            libyang::StructBinding<Narrow> narrow{ctx.findPath("/example-schema2:contWithTwoNodes")};
+            REQUIRE_THROWS_WITH_AS(narrow.field("one", &Narrow::one),
+                    "StructBinding::field: the member type does not fit the type of 'one'", libyang::Error);
+
+            struct Limits {
+                int8_t percent;
+                uint16_t port;
+            };
+            auto limitsBinding = libyang::StructBinding<Limits>{ctx.findPath("/narrow:limits")}
+                .field("percent", &Limits::percent)
+                .field("port", &Limits::port);
+            auto limits = ctx.newPath("/narrow:limits/percent", "-100");
+            limits.newPath("/narrow:limits/port", "65535");
+            auto decoded = limitsBinding.decode(limits);
+            REQUIRE(decoded.percent == -100);
+            REQUIRE(decoded.port == 65535);
+
+            libyang::StructBinding<Narrow> narrowPort{ctx.findPath("/narrow:limits")};
+            REQUIRE_THROWS_WITH_AS(narrowPort.field("port", &Narrow::port),
+                    "StructBinding::field: the member type does not fit the type of 'port'", libyang::Error);
+        }
+    }
+
+    DOCTEST_SUBCASE("ColumnExtractor")
+    {
+        ctx.parseModule(R"(
+            module columns {
+                namespace "c";
+                prefix "c";
+                list sample {
+                    key "id";
+                    leaf id {
+                        type uint32;
+                    }
+                    leaf temperature {
+                        type decimal64 {
+                            fraction-digits 2;
+                        }
+                    }
+                    container stats {
+                        leaf octets {
+                            type uint64;
+                        }
+                        leaf delta {
+                            type int16;
+                        }
+                    }
+                }
+                leaf other {
+                    type string;
+                }
+            }
+        )"s, libyang::SchemaFormat::YANG);
+        auto tree = ctx.parseData(R"({"columns:sample": [
+            {"id": 1, "temperature": "21.50", "stats": {"octets": "18446744073709551615", "delta": -3}},
+            {"id": 2, "stats": {"delta": 7}},
+            {"id": 3, "temperature": "-0.25"}
+        ]})"s, libyang::DataFormat::JSON, libyang::ParseOptions::ParseOnly);
+
+        std::array<int64_t, 4> ids;
+        std::array<double, 4> temperatures;
+        std::array<bool, 4> hasTemperature;
+        std::array<uint64_t, 4> octets;
+        std::array<int64_t, 4> deltas;
+        std::array<std::string_view, 4> labels;
+        auto extractor = libyang::ColumnExtractor{ctx.findPath("/columns:sample")}
+            .column(ctx.findPath("/columns:sample/id"), ids)
+            .column(ctx.findPath("/columns:sample/temperature"), temperatures, hasTemperature)
+            .column(ctx.findPath("/columns:sample/stats/octets"), octets)
+            .column(ctx.findPath("/columns:sample/stats/delta"), deltas)
+            .column(ctx.findPath("/columns:sample/id"), labels);
+
+        DOCTEST_SUBCASE("extracting")
+        {
+            DOCTEST_SUBCASE("from the first entry")
+            {
+                REQUIRE(extractor.extract(*tree) == 3);
+            }
+
+            DOCTEST_SUBCASE("from a set")
+            {
+                REQUIRE(extractor.extract(tree->findXPath("/columns:sample")) == 3);
+            }
+
+            REQUIRE(std::vector(ids.begin(), ids.begin() + 3) == std::vector<int64_t>{1, 2, 3});
+            REQUIRE(temperatures[0] == 21.5);
+            REQUIRE(std::isnan(temperatures[1]));
+            REQUIRE(temperatures[2] == -0.25);
+            REQUIRE(std::vector(hasTemperature.begin(), hasTemperature.begin() + 3) == std::vector<bool>{true, false, true});
+            REQUIRE(std::vector(octets.begin(), octets.begin() + 3) == std::vector<uint64_t>{18446744073709551615ULL, 0, 0});
+            REQUIRE(std::vector(deltas.begin(), deltas.begin() + 3) == std::vector<int64_t>{-3, 7, 0});
+            REQUIRE(std::vector(labels.begin(), labels.begin() + 3) == std::vector<std::string_view>{"1", "2", "3"});
+        }
+
+        DOCTEST_SUBCASE("small buffers")
+        {
+            std::array<int64_t, 2> firstIds{};
+            auto small = libyang::ColumnExtractor{ctx.findPath("/columns:sample")}.column(ctx.findPath("/columns:sample/id"), firstIds);
+            REQUIRE(small.extract(*tree->findPath("/columns:sample[id='2']")) == 2);
+            REQUIRE(firstIds == std::array<int64_t, 2>{2, 3});
+            REQUIRE(small.extract(*tree) == 3);
+            REQUIRE(firstIds == std::array<int64_t, 2>{1, 2});
+        }
+
+        DOCTEST_SUBCASE("invalid columns")
+        {
+            libyang::ColumnExtractor wrong{ctx.findPath("/columns:sample")};
+            REQUIRE_THROWS_WITH_AS(wrong.column(ctx.findPath("/columns:sample/stats/octets"), deltas),
+                    "ColumnExtractor::column: the column type does not fit the type of /columns:sample/stats/octets", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(wrong.column(ctx.findPath("/columns:sample/stats"), labels),
+                    "ColumnExtractor::column: /columns:sample/stats is not a leaf", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(wrong.column(ctx.findPath("/columns:other"), labels),
+                    "ColumnExtractor::column: /columns:other is not a descendant of /columns:sample outside of any nested list", libyang::Error);
+            REQUIRE_THROWS_AS(wrong.column(ctx.findPath("/columns:sample/temperature"), temperatures, std::span{hasTemperature}.first(2)), std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(libyang::ColumnExtractor{ctx.findPath("/columns:other")},
+                    "ColumnExtractor: /columns:other is not a list", libyang::Error);
+            REQUIRE_THROWS_WITH_AS(extractor.extract(ctx.newPath("/columns:other", "x")),
+                    "ColumnExtractor::extract: the extractor is for /columns:sample, not for /columns:other", libyang::Error);
+        }
+    }
+
     DOCTEST_SUBCASE("Working with anydata")
     {
         DOCTEST_SUBCASE("DataNode")
@@ -1937,6 +3100,23 @@ TEST_CASE("Data Node manipulation")
             REQUIRE(actual == expected);
         }
 
+        DOCTEST_SUBCASE("findMeta")
+        {
+            netconfDeletePresenceCont.newMeta(netconf, "operation", "delete");
+            netconfDeletePresenceCont.newMeta(ietfOrigin, "origin", "ietf-origin:default");
+
+            auto origin = netconfDeletePresenceCont.findMeta(ietfOrigin, "origin");
+            REQUIRE(origin);
+            REQUIRE(origin->nameView() == "origin");
+            REQUIRE(origin->valueView() == "ietf-origin:default");
+            REQUIRE(origin->module().name() == "ietf-origin");
+            REQUIRE(!origin->isInternal());
+
+            REQUIRE(netconfDeletePresenceCont.findMeta("ietf-netconf:operation")->valueStr() == "delete");
+            REQUIRE(!netconfDeletePresenceCont.findMeta(netconf, "origin"));
+            REQUIRE(!netconfDeletePresenceCont.findMeta("ietf-origin:operation"));
+        }
+
         DOCTEST_SUBCASE("valid attribute")
         {
             netconfDeletePresenceCont.newMeta(netconf, "operation", "delete");
@@ -49,6 +49,48 @@ TEST_CASE("SchemaNode")
         REQUIRE(ctx->findPath("/example-schema:myRpc/outputLeaf", libyang::InputOutputNodes::Output).nodeType() == libyang::NodeType::Leaf);
     }
 
+    DOCTEST_SUBCASE("Context::findChild and the schema index")
+    {
+        auto check = [&] {
+            auto rpc = ctx->findChild(std::nullopt, "example-schema", "myRpc");
+            REQUIRE(rpc);
+            REQUIRE(rpc->path() == "/example-schema:myRpc");
+            REQUIRE(ctx->findChild(rpc, "example-schema", "inputLeaf")->path() == "/example-schema:myRpc/inputLeaf");
+            REQUIRE(!ctx->findChild(rpc, "example-schema", "inputLeaf", libyang::InputOutputNodes::Output));
+            REQUIRE(!ctx->findChild(rpc, "example-schema", "outputLeaf"));
+            REQUIRE(ctx->findChild(rpc, "example-schema", "outputLeaf", libyang::InputOutputNodes::Output)->name() == "outputLeaf");
+            // choices and cases are skipped
+            REQUIRE(ctx->findChild(std::nullopt, "example-schema", "choiceOnModuleLeaf1")->path() == "/example-schema:choiceOnModuleLeaf1");
+            REQUIRE(!ctx->findChild(std::nullopt, "example-schema", "choiceOnModule"));
+            REQUIRE(!ctx->findChild(std::nullopt, "nonexistent-module", "myRpc"));
+
+            REQUIRE(ctx->findPath("/example-schema:person/name").path() == "/example-schema:person/name");
+            REQUIRE(ctx->findPath("/example-schema:person/example-schema:name").path() == "/example-schema:person/name");
+            REQUIRE_THROWS_WITH_AS(ctx->findPath("/example-schema:hi"), "Couldn't find schema node: /example-schema:hi", libyang::Error);
+            REQUIRE_THROWS(ctx->findPath("/example-schema:myRpc/outputLeaf", libyang::InputOutputNodes::Input));
+            REQUIRE_THROWS(ctx->findPath("/example-schema:myRpc/inputLeaf", libyang::InputOutputNodes::Output));
+            REQUIRE(!ctx->findPath("/example-schema:myRpc/outputLeaf", libyang::InputOutputNodes::Output).isInput());
+        };
+
+        DOCTEST_SUBCASE("without the index")
+        {
+            check();
+        }
+
+        DOCTEST_SUBCASE("with the index")
+        {
+            ctx->buildSchemaIndex();
+            check();
+
+            // the index picks up schema changes
+            REQUIRE(!ctx->findChild(std::nullopt, "example-schema2", "contWithTwoNodes"));
+            ctx->parseModule(example_schema2, libyang::SchemaFormat::YANG);
+            REQUIRE(ctx->findChild(std::nullopt, "example-schema2", "contWithTwoNodes")->path() == "/example-schema2:contWithTwoNodes");
+            REQUIRE(ctx->findPath("/example-schema2:contWithTwoNodes/one").path() == "/example-schema2:contWithTwoNodes/one");
+            check();
+        }
+    }
+
     DOCTEST_SUBCASE("DataNode::schema")
     {
         auto data = R"(
@@ -151,6 +193,24 @@ TEST_CASE("SchemaNode")
         REQUIRE(ctx->findPath("/importThis:myCont/augmentModule:myLeaf").name() == "myLeaf");
     }
 
+    DOCTEST_SUBCASE("SchemaNode::pathView")
+    {
+        auto leaf = ctx->findPath("/example-schema:leafBinary");
+        auto view = leaf.pathView();
+        REQUIRE(view == "/example-schema:leafBinary");
+        REQUIRE(leaf.nameView() == "leafBinary");
+
+        // the path is computed only once per context
+        REQUIRE(ctx->findPath("/example-schema:leafBinary").pathView().data() == view.data());
+        REQUIRE(ctx->findPath("/example-schema:leafBinary").path() == view);
+
+        // changing the schema drops the cache
+        ctx->setSearchDir(TESTS_DIR);
+        ctx->loadModule("augmentModule");
+        REQUIRE(ctx->findPath("/example-schema:leafBinary").pathView() == "/example-schema:leafBinary");
+        REQUIRE(ctx->findPath("/importThis:myCont/augmentModule:myLeaf").pathView() == "/importThis:myCont/augmentModule:myLeaf");
+    }
+
     DOCTEST_SUBCASE("SchemaNode::nodetype")
     {
         libyang::NodeType expected;
@@ -257,6 +317,34 @@ TEST_CASE("SchemaNode")
             }
 
             REQUIRE(expectedPaths == actualPaths);
+            REQUIRE(children->size() == expectedPaths.size());
+            REQUIRE((*children)[1].path() == expectedPaths[1]);
+            REQUIRE((children->begin() + 2)->path() == expectedPaths[2]);
+            REQUIRE((children->end() - 1)->path() == expectedPaths.back());
+            REQUIRE(children->end() - children->begin() == static_cast<std::ptrdiff_t>(expectedPaths.size()));
+            REQUIRE_THROWS_AS((*children)[expectedPaths.size()], std::out_of_range);
+            REQUIRE_THROWS_WITH_AS(*children->end(), "Derefenced .end iterator", std::out_of_range);
+        }
+
+        DOCTEST_SUBCASE("options")
+        {
+            auto names = [](const libyang::ChildInstanstiables& children) {
+                std::vector<std::string> res;
+                for (const auto& child : children) {
+                    res.emplace_back(child.name());
+                }
+                return res;
+            };
+
+            auto container = ctx->findPath("/type_module:choiceBasicContainer");
+            REQUIRE(names(container.childInstantiables()) == std::vector<std::string>{"l", "ll", "l2"});
+            REQUIRE(names(container.childInstantiables(libyang::GetNextOptions::WithChoice)) == std::vector<std::string>{"choiceBasic"});
+            // the cached results are kept separately for each set of options
+            REQUIRE(names(container.childInstantiables()) == std::vector<std::string>{"l", "ll", "l2"});
+
+            auto rpc = ctx->findPath("/example-schema:myRpc");
+            REQUIRE(names(rpc.childInstantiables()) == std::vector<std::string>{"inputLeaf"});
+            REQUIRE(names(rpc.childInstantiables(libyang::GetNextOptions::Output)) == std::vector<std::string>{"outputLeaf", "another"});
         }
 
         DOCTEST_SUBCASE("unimplemented module")
@@ -314,6 +402,13 @@ TEST_CASE("SchemaNode")
             }
 
             REQUIRE(actualPaths == expectedPaths);
+
+            std::vector<std::string> viewPaths;
+            for (const auto view : children->views()) {
+                viewPaths.emplace_back(view.pathView());
+            }
+
+            REQUIRE(viewPaths == expectedPaths);
         }
 
         DOCTEST_SUBCASE("unimplemented module")
@@ -329,6 +424,33 @@ TEST_CASE("SchemaNode")
         }
     }
 
+    DOCTEST_SUBCASE("SchemaNodeView")
+    {
+        auto list = ctx->findPath("/type_module:listAdvancedWithTwoKey");
+        auto view = list.view();
+        REQUIRE(view.name() == "listAdvancedWithTwoKey");
+        REQUIRE(view.moduleName() == "type_module");
+        REQUIRE(view.nodeType() == libyang::NodeType::List);
+        REQUIRE(!view.parent());
+
+        auto first = view.child();
+        REQUIRE(first);
+        REQUIRE(first->pathView() == "/type_module:listAdvancedWithTwoKey/first");
+        REQUIRE(first->nextSibling()->name() == "second");
+        REQUIRE(!first->nextSibling()->nextSibling());
+        REQUIRE(first->parent() == view);
+        REQUIRE(first->node() == ctx->findPath("/type_module:listAdvancedWithTwoKey/first"));
+
+        auto children = list.childInstantiables();
+        REQUIRE(children.view(1).name() == "second");
+        REQUIRE_THROWS_AS(children.view(2), std::out_of_range);
+
+        // a full SchemaNode keeps the context alive, a view does not have to
+        auto node = first->node();
+        ctx.reset();
+        REQUIRE(node.path() == "/type_module:listAdvancedWithTwoKey/first");
+    }
+
     DOCTEST_SUBCASE("immediateChildren")
     {
         DOCTEST_SUBCASE("implemented module")